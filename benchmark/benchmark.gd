@@ -0,0 +1,394 @@
+#**************************************************************************#
+#*  benchmark.gd                                                          *#
+#**************************************************************************#
+#*                         This file is part of:                          *#
+#*                     INTERACTIVE GRID GDExtension                       *#
+#*         https://github.com/antoinecharruel/interactive_grid            *#
+#**************************************************************************#
+#* Copyright (c) 2025 Antoine Charruel.                                   *#
+#*                                                                        *#
+#* Permission is hereby granted, free of charge, to any person obtaining  *#
+#* a copy of this software and associated documentation files (the        *#
+#* "Software"), to deal in the Software without restriction, including    *#
+#* without limitation the rights to use, copy, modify, merge, publish,    *#
+#* distribute, sublicense, and/or sell copies of the Software, and to     *#
+#* permit persons to whom the Software is furnished to do so, subject to  *#
+#* the following conditions:                                              *#
+#*                                                                        *#
+#* The above copyright notice and this permission notice shall be         *#
+#* included in all copies or substantial portions of the Software.        *#
+#*                                                                        *#
+#* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        *#
+#* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     *#
+#* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. *#
+#* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   *#
+#* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   *#
+#* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      *#
+#* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 *#
+#**************************************************************************#
+
+extends Node3D
+
+## Headless benchmark suite for InteractiveGrid3D.
+##
+## Builds grids of increasing size for every layout and movement over a
+## procedurally generated floor with obstacles and custom data areas, times
+## the main grid operations and writes the results as JSON.
+##
+## Usage:
+##   godot --headless --path benchmark -- --output=results.json
+##
+## Options (after "--"):
+##   --output=<path>         JSON results file (default: user://benchmark.json).
+##   --sizes=9,32,...        Grid sizes, each grid is size x size cells.
+##   --layouts=square,...    Layouts to run: square, hexagonal.
+##   --movements=four,...    Movements to run: four, six, eight.
+##   --repeats=<n>           Samples for center, update_custom_data and
+##                           compute_unreachable_cells (default: 5).
+##   --paths=<n>             Random get_path queries per grid (default: 64).
+##   --picks=<n>             Random hover picks per grid (default: 256).
+##   --seed=<n>              Seed of the generated worlds (default: 1).
+
+const OBSTACLE_LAYER: int = 1 << 13 # InteractiveGrid3D default obstacles mask.
+const FLOOR_LAYER: int = 1 << 14 # InteractiveGrid3D default floor mask.
+const SWAMP_LAYER: int = 1 << 16
+
+const SWAMP_CELL_FLAG: int = 1 << 12
+const SWAMP_TRAVERSAL_COST: float = 3.0
+
+const CELL_SIZE: Vector2 = Vector2(1.0, 1.0)
+const FLOOR_AMPLITUDE: float = 0.6
+const OBSTACLE_DENSITY: float = 0.12
+const SWAMP_DENSITY: float = 0.05
+const OBSTACLE_HEIGHT: float = 2.0
+
+const LAYOUTS: Dictionary = {
+	"square": InteractiveGrid3D.LAYOUT_SQUARE,
+	"hexagonal": InteractiveGrid3D.LAYOUT_HEXAGONAL,
+}
+
+const MOVEMENTS: Dictionary = {
+	"four": InteractiveGrid3D.MOVEMENT_FOUR_DIRECTIONS,
+	"six": InteractiveGrid3D.MOVEMENT_SIX_DIRECTIONS,
+	"eight": InteractiveGrid3D.MOVEMENT_EIGH_DIRECTIONS,
+}
+
+var _options: Dictionary = {
+	"output": "user://benchmark.json",
+	"sizes": [9, 16, 32, 64, 128, 256, 512, 1024],
+	"layouts": ["square", "hexagonal"],
+	"movements": ["four", "six", "eight"],
+	"repeats": 5,
+	"paths": 64,
+	"picks": 256,
+	"seed": 1,
+}
+
+var _rng: RandomNumberGenerator = RandomNumberGenerator.new()
+var _world_rids: Array[RID] = []
+
+
+func _ready() -> void:
+	_parse_arguments(OS.get_cmdline_user_args())
+	_run.call_deferred()
+
+
+func _parse_arguments(arguments: PackedStringArray) -> void:
+	for argument in arguments:
+		if not argument.begins_with("--") or not argument.contains("="):
+			push_warning("Ignoring benchmark argument: %s" % argument)
+			continue
+
+		var key: String = argument.substr(2, argument.find("=") - 2)
+		var value: String = argument.substr(argument.find("=") + 1)
+
+		match key:
+			"output":
+				_options.output = value
+			"sizes":
+				_options.sizes = Array(value.split(",", false)).map(func(size: String) -> int: return size.to_int())
+			"layouts", "movements":
+				_options[key] = Array(value.split(",", false))
+			"repeats", "paths", "picks", "seed":
+				_options[key] = maxi(value.to_int(), 0)
+			_:
+				push_warning("Unknown benchmark option: --%s" % key)
+
+
+func _run() -> void:
+	var results: Array[Dictionary] = []
+
+	for layout_name in _options.layouts:
+		if not LAYOUTS.has(layout_name):
+			push_error("Unknown layout: %s" % layout_name)
+			continue
+
+		for movement_name in _options.movements:
+			if not MOVEMENTS.has(movement_name):
+				push_error("Unknown movement: %s" % movement_name)
+				continue
+
+			for size in _options.sizes:
+				if size < 2:
+					continue
+
+				print("Benchmarking %s/%s/%dx%d..." % [layout_name, movement_name, size, size])
+				results.append(await _run_case(layout_name, movement_name, size))
+
+	var report: Dictionary = {
+		"meta": {
+			"godot_version": Engine.get_version_info().string,
+			"os": OS.get_name(),
+			"processor": OS.get_processor_name(),
+			"processor_count": OS.get_processor_count(),
+			"debug_build": OS.is_debug_build(),
+			"timestamp": Time.get_datetime_string_from_system(true),
+			"options": _options,
+		},
+		"results": results,
+	}
+
+	var file: FileAccess = FileAccess.open(_options.output, FileAccess.WRITE)
+	if file == null:
+		push_error("Cannot write %s: %s" % [_options.output, error_string(FileAccess.get_open_error())])
+		get_tree().quit(1)
+		return
+
+	file.store_string(JSON.stringify(report, "\t"))
+	file.close()
+
+	print("Benchmark results written to %s" % ProjectSettings.globalize_path(_options.output))
+	get_tree().quit(0)
+
+
+func _run_case(layout_name: String, movement_name: String, size: int) -> Dictionary:
+	# Every case gets the same world for a given seed and size, so runs compare.
+	_rng.seed = hash([_options.seed, size])
+	_build_world(size)
+
+	# Let a physics step register the world bodies before the grid scans them.
+	await get_tree().physics_frame
+	await get_tree().physics_frame
+
+	var grid: InteractiveGrid3D = _create_grid(LAYOUTS[layout_name], MOVEMENTS[movement_name], size)
+	add_child(grid)
+
+	# The grid is created on its first physics frame.
+	await get_tree().physics_frame
+	await get_tree().physics_frame
+
+	var result: Dictionary = {
+		"name": "%s/%s/%dx%d" % [layout_name, movement_name, size, size],
+		"layout": layout_name,
+		"movement": movement_name,
+		"rows": size,
+		"columns": size,
+		"cells": size * size,
+		"metrics": {},
+	}
+
+	if not grid.is_grid_created():
+		push_error("The grid %s was not created." % result.name)
+		_free_case(grid)
+		return result
+
+	var metrics: Dictionary = result.metrics
+	grid.reset_profile_stats()
+
+	metrics["center"] = _measure(_options.repeats, func(_i: int) -> void: grid.center(Vector3.ZERO))
+
+	var center_index: int = grid.get_cell_index_from_global_position(grid.get_center_global_position())
+	grid.set_cell_accessible(center_index, true)
+
+	metrics["update_custom_data"] = _measure(_options.repeats, func(_i: int) -> void: grid.update_custom_data())
+	metrics["compute_unreachable_cells"] = _measure(_options.repeats, func(_i: int) -> void: grid.compute_unreachable_cells(center_index))
+
+	# Inputs are drawn up front so that only the grid calls are timed.
+	var reachable: PackedInt32Array = _get_reachable_cells(grid)
+	var path_count: int = _options.paths if reachable.size() > 1 else 0
+	var path_ends: PackedInt32Array = PackedInt32Array()
+	for i in path_count * 2:
+		path_ends.append(reachable[_rng.randi_range(0, reachable.size() - 1)])
+
+	var path_lengths: Array[int] = []
+	var find_path: Callable = func(i: int) -> void:
+		path_lengths.append(grid.get_path(path_ends[i * 2], path_ends[i * 2 + 1]).size())
+	metrics["get_path"] = _measure(path_count, find_path)
+	metrics["get_path"]["mean_length"] = _mean(path_lengths)
+
+	var pick_cells: PackedInt32Array = PackedInt32Array()
+	var pick_origins: PackedVector3Array = PackedVector3Array()
+	var pick_targets: PackedVector3Array = PackedVector3Array()
+	for i in _options.picks:
+		var cell_index: int = _rng.randi_range(0, grid.get_size() - 1)
+		var target: Vector3 = grid.get_cell_global_position(cell_index)
+		pick_cells.append(cell_index)
+		pick_targets.append(target)
+		pick_origins.append(target + Vector3(_rng.randf_range(-4.0, 4.0), 10.0, _rng.randf_range(-4.0, 4.0)))
+
+	var picked: Array[int] = [] # Lambdas capture packed arrays by value.
+	picked.resize(_options.picks)
+	var pick: Callable = func(i: int) -> void:
+		picked[i] = grid.pick_cell_from_ray(pick_origins[i], (pick_targets[i] - pick_origins[i]).normalized())
+	metrics["pick_cell_from_ray"] = _measure(_options.picks, pick)
+
+	var hits: int = 0
+	for i in _options.picks:
+		if picked[i] == pick_cells[i]:
+			hits += 1
+	metrics["pick_cell_from_ray"]["hit_rate"] = float(hits) / maxi(_options.picks, 1)
+
+	metrics["highlight_on_hover"] = _measure(_options.picks, func(i: int) -> void: grid.highlight_on_hover(pick_targets[i]))
+
+	result["profile"] = grid.get_profile_stats()
+
+	_free_case(grid)
+	return result
+
+
+func _create_grid(layout: int, movement: int, size: int) -> InteractiveGrid3D:
+	var cell_mesh: PlaneMesh = PlaneMesh.new()
+	cell_mesh.size = CELL_SIZE * 0.9
+
+	var cell_shape: BoxShape3D = BoxShape3D.new()
+	cell_shape.size = Vector3(CELL_SIZE.x * 0.5, 0.5, CELL_SIZE.y * 0.5)
+
+	var swamp: CustomCellData = CustomCellData.new()
+	swamp.custom_data_name = "CFL_SWAMP"
+	swamp.layer_mask = SWAMP_CELL_FLAG
+	swamp.collision_layer = SWAMP_LAYER
+	swamp.traversal_cost = SWAMP_TRAVERSAL_COST
+
+	var grid: InteractiveGrid3D = InteractiveGrid3D.new()
+	grid.rows = size
+	grid.columns = size
+	grid.cell_size = CELL_SIZE
+	grid.cell_mesh = cell_mesh
+	grid.cell_shape = cell_shape
+	grid.layout = layout
+	grid.movement = movement
+	grid.obstacles_collision_masks = OBSTACLE_LAYER
+	grid.floor_collision_masks = FLOOR_LAYER
+	grid.custom_cells_data = [swamp]
+	grid.material_override = StandardMaterial3D.new()
+	return grid
+
+
+func _build_world(size: int) -> void:
+	var space: RID = get_world_3d().space
+	var half_extent: float = size * 0.5 + 2.0
+
+	# Floor: a noise heightfield covering the whole grid, centered on the origin.
+	var noise: FastNoiseLite = FastNoiseLite.new()
+	noise.seed = _rng.randi()
+	noise.frequency = 0.05
+
+	var width: int = size + 5
+	var heights: PackedFloat32Array = PackedFloat32Array()
+	heights.resize(width * width)
+	for z in width:
+		for x in width:
+			heights[z * width + x] = noise.get_noise_2d(x, z) * FLOOR_AMPLITUDE
+
+	var floor_shape: RID = PhysicsServer3D.heightmap_shape_create()
+	PhysicsServer3D.shape_set_data(floor_shape, {
+		"width": width,
+		"depth": width,
+		"heights": heights,
+		"min_height": -FLOOR_AMPLITUDE,
+		"max_height": FLOOR_AMPLITUDE,
+	})
+	_add_static_body(space, FLOOR_LAYER, [floor_shape], [Transform3D.IDENTITY])
+
+	# Obstacles and swamps: boxes of one to three cells scattered over the floor.
+	var box_shapes: Dictionary = {}
+	for layer in [OBSTACLE_LAYER, SWAMP_LAYER]:
+		var density: float = OBSTACLE_DENSITY if layer == OBSTACLE_LAYER else SWAMP_DENSITY
+		var height: float = OBSTACLE_HEIGHT if layer == OBSTACLE_LAYER else 0.5
+		var count: int = int(size * size * density / 4.0)
+		var shapes: Array[RID] = []
+		var xforms: Array[Transform3D] = []
+
+		for i in count:
+			var extent: Vector2i = Vector2i(_rng.randi_range(1, 3), _rng.randi_range(1, 3))
+			var key: Vector3 = Vector3(extent.x, height, extent.y)
+			if not box_shapes.has(key):
+				box_shapes[key] = PhysicsServer3D.box_shape_create()
+				PhysicsServer3D.shape_set_data(box_shapes[key], key * 0.5)
+
+			var x: float = _rng.randf_range(-half_extent, half_extent)
+			var z: float = _rng.randf_range(-half_extent, half_extent)
+			var ground: float = noise.get_noise_2d(x + (width - 1) * 0.5, z + (width - 1) * 0.5) * FLOOR_AMPLITUDE
+			shapes.append(box_shapes[key])
+			xforms.append(Transform3D(Basis.IDENTITY, Vector3(x, ground + height * 0.5 - 0.25, z)))
+
+		_add_static_body(space, layer, shapes, xforms)
+
+	_world_rids.append(floor_shape)
+	_world_rids.append_array(box_shapes.values())
+
+
+func _add_static_body(space: RID, layer: int, shapes: Array[RID], xforms: Array[Transform3D]) -> void:
+	var body: RID = PhysicsServer3D.body_create()
+	PhysicsServer3D.body_set_mode(body, PhysicsServer3D.BODY_MODE_STATIC)
+	PhysicsServer3D.body_set_collision_layer(body, layer)
+	PhysicsServer3D.body_set_collision_mask(body, 0)
+
+	for i in shapes.size():
+		PhysicsServer3D.body_add_shape(body, shapes[i], xforms[i])
+
+	PhysicsServer3D.body_set_space(body, space)
+
+	# Bodies are freed before their shapes.
+	_world_rids.push_front(body)
+
+
+func _free_case(grid: InteractiveGrid3D) -> void:
+	remove_child(grid)
+	grid.free()
+
+	for rid in _world_rids:
+		PhysicsServer3D.free_rid(rid)
+	_world_rids.clear()
+
+
+func _get_reachable_cells(grid: InteractiveGrid3D) -> PackedInt32Array:
+	var cells: PackedInt32Array = PackedInt32Array()
+	for cell_index in grid.get_size():
+		if grid.is_cell_accessible(cell_index) and grid.is_cell_reachable(cell_index):
+			cells.append(cell_index)
+	return cells
+
+
+## Times [param count] calls of [param callable], given the call number, and returns their statistics.
+func _measure(count: int, callable: Callable) -> Dictionary:
+	var samples: Array[int] = []
+	for i in count:
+		var start: int = Time.get_ticks_usec()
+		callable.call(i)
+		samples.append(Time.get_ticks_usec() - start)
+	return _statistics(samples)
+
+
+func _statistics(samples: Array[int]) -> Dictionary:
+	if samples.is_empty():
+		return { "samples": 0 }
+
+	var sorted: Array[int] = samples.duplicate()
+	sorted.sort()
+
+	return {
+		"samples": sorted.size(),
+		"min_usec": sorted[0],
+		"median_usec": sorted[sorted.size() / 2],
+		"mean_usec": _mean(sorted),
+		"p95_usec": sorted[mini(int(sorted.size() * 0.95), sorted.size() - 1)],
+		"max_usec": sorted[-1],
+		"total_usec": sorted.reduce(func(sum: int, sample: int) -> int: return sum + sample, 0),
+	}
+
+
+func _mean(values: Array[int]) -> float:
+	if values.is_empty():
+		return 0.0
+	return float(values.reduce(func(sum: int, value: int) -> int: return sum + value, 0)) / values.size()
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+"""
+Compares InteractiveGrid3D benchmark results against a stored baseline.
+
+Usage:
+    python benchmark/compare.py baseline.json results.json [--threshold 0.15] [--min-usec 50]
+
+A metric regresses when its median time grows by more than the threshold
+(relative) and by more than min-usec (absolute, to ignore timer noise on
+tiny grids). Exits with 1 when any metric regresses, 0 otherwise.
+"""
+
+import argparse
+import json
+import sys
+
+STATISTIC = "median_usec"
+
+
+def load_metrics(path):
+    with open(path, encoding="utf-8") as file:
+        report = json.load(file)
+
+    metrics = {}
+    for result in report.get("results", []):
+        for metric, stats in result.get("metrics", {}).items():
+            if STATISTIC in stats:
+                metrics[(result["name"], metric)] = stats[STATISTIC]
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark results against a baseline.")
+    parser.add_argument("baseline", help="Baseline JSON written by the benchmark project.")
+    parser.add_argument("results", help="New JSON results to check.")
+    parser.add_argument("--threshold", type=float, default=0.15, help="Allowed relative slowdown (default: 0.15).")
+    parser.add_argument("--min-usec", type=float, default=50.0, help="Ignore slowdowns below this many microseconds.")
+    args = parser.parse_args()
+
+    baseline = load_metrics(args.baseline)
+    results = load_metrics(args.results)
+
+    regressions = 0
+    print("{:<40} {:<28} {:>12} {:>12} {:>9}".format("case", "metric", "baseline", "current", "change"))
+
+    for key in sorted(baseline.keys() & results.keys()):
+        before = baseline[key]
+        after = results[key]
+        change = (after - before) / before if before > 0 else 0.0
+
+        status = ""
+        if after - before > args.min_usec and change > args.threshold:
+            status = "  REGRESSION"
+            regressions += 1
+        elif before - after > args.min_usec and -change > args.threshold:
+            status = "  improved"
+
+        print("{:<40} {:<28} {:>12} {:>12} {:>+8.1%}{}".format(key[0], key[1], before, after, change, status))
+
+    for key in sorted(baseline.keys() - results.keys()):
+        print("missing from results: {} {}".format(*key))
+
+    for key in sorted(results.keys() - baseline.keys()):
+        print("not in baseline: {} {}".format(*key))
+
+    if regressions:
+        print("{} metric(s) regressed by more than {:.0%}.".format(regressions, args.threshold))
+        return 1
+
+    print("No regression.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
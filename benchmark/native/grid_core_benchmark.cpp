@@ -0,0 +1,272 @@
+/**************************************************************************/
+/*  grid_core_benchmark.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+// Native microbenchmark of the grid core, built without Godot
+// (cmake -DGRID_CORE_ONLY=ON). Runs the layout, search and area loops on
+// random grids so they can be profiled directly with perf or VTune.
+//
+// Usage: grid_core_benchmark [--sizes=64,256,1024] [--iterations=32] [--seed=1]
+
+#include "grid_area.h"
+#include "grid_field_of_view.h"
+#include "grid_hierarchy.h"
+#include "grid_layout.h"
+#include "grid_pathfinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float OBSTACLE_DENSITY = 0.2f;
+const float COSTLY_DENSITY = 0.1f;
+
+struct Options {
+	std::vector<int> sizes = { 64, 256, 1024 };
+	int iterations = 32;
+	unsigned int seed = 1;
+};
+
+struct Case {
+	const char *name;
+	GridPathfinder::Movement movement;
+	bool hexagonal;
+};
+
+const Case CASES[] = {
+	{ "square/four", GridPathfinder::MOVEMENT_FOUR_DIRECTIONS, false },
+	{ "square/eight", GridPathfinder::MOVEMENT_EIGH_DIRECTIONS, false },
+	{ "hexagonal/six", GridPathfinder::MOVEMENT_SIX_DIRECTIONS, true },
+};
+
+// Times p_iterations calls of p_function and prints the median and the
+// fastest call in microseconds. The sink keeps results observable.
+volatile int64_t sink = 0;
+
+void measure(const char *p_case, int p_size, const char *p_operation, int p_iterations, const std::function<int64_t(int)> &p_function) {
+	std::vector<double> samples;
+	samples.reserve(p_iterations);
+
+	for (int i = 0; i < p_iterations; i++) {
+		auto start = std::chrono::high_resolution_clock::now();
+		sink = sink + p_function(i);
+		auto end = std::chrono::high_resolution_clock::now();
+		samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+	}
+
+	std::sort(samples.begin(), samples.end());
+	std::printf("%-16s %6dx%-6d %-20s %10.1f %10.1f\n", p_case, p_size, p_size, p_operation,
+			samples[samples.size() / 2], samples[0]);
+}
+
+bool parse_options(int argc, char **argv, Options &r_options) {
+	for (int i = 1; i < argc; i++) {
+		const char *argument = argv[i];
+
+		if (std::strncmp(argument, "--sizes=", 8) == 0) {
+			r_options.sizes.clear();
+			for (const char *size = argument + 8; *size; size++) {
+				r_options.sizes.push_back(std::atoi(size));
+				size = std::strchr(size, ',');
+				if (!size) {
+					break;
+				}
+			}
+		} else if (std::strncmp(argument, "--iterations=", 13) == 0) {
+			r_options.iterations = std::max(1, std::atoi(argument + 13));
+		} else if (std::strncmp(argument, "--seed=", 7) == 0) {
+			r_options.seed = static_cast<unsigned int>(std::strtoul(argument + 7, nullptr, 10));
+		} else {
+			std::fprintf(stderr, "Usage: %s [--sizes=64,256,1024] [--iterations=32] [--seed=1]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+void run_case(const Case &p_case, int p_size, const Options &p_options) {
+	const int cell_count = p_size * p_size;
+	std::mt19937 random(p_options.seed ^ static_cast<unsigned int>(p_size));
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_int_distribution<int> cell(0, cell_count - 1);
+
+	GridPathfinder pathfinder;
+	pathfinder.resize(p_size, p_size);
+	pathfinder.set_movement(p_case.movement);
+
+	GridFieldOfView fov;
+	fov.resize(p_size, p_size);
+	fov.set_hexagonal(p_case.hexagonal);
+
+	GridArea area;
+	area.resize(p_size, p_size);
+	area.set_hexagonal(p_case.hexagonal);
+	area.set_diagonal(p_case.movement != GridPathfinder::MOVEMENT_FOUR_DIRECTIONS);
+
+	std::vector<int> open_cells;
+	for (int index = 0; index < cell_count; index++) {
+		const bool obstacle = unit(random) < OBSTACLE_DENSITY;
+		pathfinder.set_walkable(index, !obstacle);
+		fov.set_opaque(index, obstacle);
+
+		if (!obstacle) {
+			open_cells.push_back(index);
+			if (unit(random) < COSTLY_DENSITY) {
+				pathfinder.set_cell_cost(index, 3.0f, 0.0f);
+			}
+		}
+	}
+	pathfinder.update_cost_bounds();
+
+	if (open_cells.size() < 2) {
+		return;
+	}
+
+	GridHierarchy hierarchy;
+	hierarchy.setup(&pathfinder, 16);
+
+	// Inputs are drawn up front so that only the core calls are timed.
+	const int iterations = p_options.iterations;
+	std::uniform_int_distribution<size_t> open_cell(0, open_cells.size() - 1);
+	std::vector<int> starts(iterations);
+	std::vector<int> targets(iterations);
+	for (int i = 0; i < iterations; i++) {
+		starts[i] = open_cells[open_cell(random)];
+		targets[i] = open_cells[open_cell(random)];
+	}
+
+	GridVector<int> cells;
+	GridVector<int> sources;
+	sources.push_back(open_cells[open_cells.size() / 2]);
+
+	measure(p_case.name, p_size, "layout", iterations, [&](int) {
+		float top_left_x = 0.0f;
+		float top_left_z = 0.0f;
+		grid_layout_center_to_top_left(p_case.hexagonal, p_size, p_size, 1.0f, 1.0f, top_left_x, top_left_z);
+
+		float sum = 0.0f;
+		for (int row = 0; row < p_size; row++) {
+			for (int column = 0; column < p_size; column++) {
+				float x = 0.0f;
+				float z = 0.0f;
+				grid_layout_cell_offset(p_case.hexagonal, column, row, 1.0f, 1.0f, x, z);
+				sum += top_left_x + x + top_left_z + z;
+			}
+		}
+		return static_cast<int64_t>(sum);
+	});
+
+	measure(p_case.name, p_size, "neighbors", iterations, [&](int) {
+		int neighbors[8];
+		int64_t count = 0;
+		for (int index = 0; index < cell_count; index++) {
+			count += pathfinder.get_neighbors(index, neighbors);
+		}
+		return count;
+	});
+
+	measure(p_case.name, p_size, "breadth_first_search", iterations, [&](int) {
+		pathfinder.breadth_first_search(sources);
+		return static_cast<int64_t>(pathfinder.is_reached(sources[0]));
+	});
+
+	measure(p_case.name, p_size, "find_path", iterations, [&](int i) {
+		pathfinder.find_path(starts[i], targets[i], cells);
+		return static_cast<int64_t>(cells.size());
+	});
+
+	if (pathfinder.is_jump_point_search_supported()) {
+		pathfinder.update_jump_distances();
+		measure(p_case.name, p_size, "find_path_jps", iterations, [&](int i) {
+			pathfinder.find_path_jps(starts[i], targets[i], cells);
+			return static_cast<int64_t>(cells.size());
+		});
+	}
+
+	hierarchy.update();
+	measure(p_case.name, p_size, "find_path_hpa", iterations, [&](int i) {
+		hierarchy.find_path(starts[i], targets[i], cells);
+		return static_cast<int64_t>(cells.size());
+	});
+
+	GridVector<int> flood_cells;
+	GridVector<float> flood_costs;
+	GridVector<int> flood_parents;
+	measure(p_case.name, p_size, "flood", iterations, [&](int i) {
+		GridVector<int> flood_sources;
+		flood_sources.push_back(starts[i]);
+		pathfinder.flood(flood_sources, 32.0f, false, flood_cells, flood_costs, flood_parents);
+		return static_cast<int64_t>(flood_cells.size());
+	});
+
+	measure(p_case.name, p_size, "field_of_view", iterations, [&](int i) {
+		fov.compute(starts[i], 16, cells);
+		return static_cast<int64_t>(cells.size());
+	});
+
+	measure(p_case.name, p_size, "cells_in_radius", iterations, [&](int i) {
+		area.cells_in_radius(starts[i], 8, cells);
+		return static_cast<int64_t>(cells.size());
+	});
+
+	measure(p_case.name, p_size, "cells_on_line", iterations, [&](int i) {
+		area.cells_on_line(starts[i], targets[i], cells);
+		return static_cast<int64_t>(cells.size());
+	});
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parse_options(argc, argv, options)) {
+		return 1;
+	}
+
+	std::printf("%-16s %13s %-20s %10s %10s\n", "case", "size", "operation", "median_us", "min_us");
+
+	for (int size : options.sizes) {
+		if (size < 2) {
+			continue;
+		}
+
+		for (const Case &grid_case : CASES) {
+			run_case(grid_case, size, options);
+		}
+	}
+
+	return 0;
+}
@@ -69,6 +69,24 @@ bool CustomCellData::get_custom_color_enabled() const {
 	return custom_color_enabled;
 }
 
+void CustomCellData::set_traversal_cost(float p_cost) {
+	ERR_FAIL_COND_MSG(p_cost < 0.0f, "Traversal cost must be positive or zero.");
+	traversal_cost = p_cost;
+}
+
+float CustomCellData::get_traversal_cost() const {
+	return traversal_cost;
+}
+
+void CustomCellData::set_edge_cost(float p_cost) {
+	ERR_FAIL_COND_MSG(p_cost < 0.0f, "Edge cost must be positive or zero.");
+	edge_cost = p_cost;
+}
+
+float CustomCellData::get_edge_cost() const {
+	return edge_cost;
+}
+
 bool CustomCellData::has_layers_in_mask(const uint32_t p_layer_mask) const {
 	return (collision_layer & p_layer_mask) == collision_layer;
 }
@@ -95,11 +113,19 @@ void CustomCellData::_bind_methods() {
 	godot::ClassDB::bind_method(godot::D_METHOD("set_color", "color"), &CustomCellData::set_color);
 	godot::ClassDB::bind_method(godot::D_METHOD("get_color"), &CustomCellData::get_color);
 
+	godot::ClassDB::bind_method(godot::D_METHOD("set_traversal_cost", "cost"), &CustomCellData::set_traversal_cost);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_traversal_cost"), &CustomCellData::get_traversal_cost);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_edge_cost", "cost"), &CustomCellData::set_edge_cost);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_edge_cost"), &CustomCellData::get_edge_cost);
+
 	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::STRING, "custom_data_name"), "set_custom_data_name", "get_custom_data_name");
 	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "layer_mask", godot::PROPERTY_HINT_LAYERS_3D_RENDER), "set_layer_mask", "get_layer_mask");
 	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "collision_layer", godot::PROPERTY_HINT_LAYERS_3D_RENDER), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "use_custom_color"), "set_custom_color_enabled", "get_custom_color_enabled");
 	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "color"), "set_color", "get_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "traversal_cost", godot::PROPERTY_HINT_RANGE, "0,100,0.01,or_greater"), "set_traversal_cost", "get_traversal_cost");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "edge_cost", godot::PROPERTY_HINT_RANGE, "0,100,0.01,or_greater"), "set_edge_cost", "get_edge_cost");
 }
 
 CustomCellData::CustomCellData() {}
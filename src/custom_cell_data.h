@@ -43,6 +43,8 @@ private:
 	uint32_t collision_layer = 1;
 	bool custom_color_enabled = false;
 	godot::Color color = godot::Color(1, 1, 1);
+	float traversal_cost = 1.0f;
+	float edge_cost = 0.0f;
 
 protected:
 	static void _bind_methods();
@@ -66,6 +68,12 @@ public:
 	void set_custom_color_enabled(bool p_enabled);
 	bool get_custom_color_enabled() const;
 
+	void set_traversal_cost(float p_cost);
+	float get_traversal_cost() const;
+
+	void set_edge_cost(float p_cost);
+	float get_edge_cost() const;
+
 	bool has_layers_in_mask(const uint32_t p_layer_mask) const;
 
 	bool get_collision_layer_value(int p_layer_number) const;
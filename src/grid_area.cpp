@@ -0,0 +1,241 @@
+/**************************************************************************/
+/*  grid_area.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_area.h"
+
+#include "grid_hex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Distance between two rows of the hexagonal layout, in columns.
+constexpr float HEX_ROW_SPACING = 0.8660254f;
+
+} // namespace
+
+void GridArea::resize(int p_columns, int p_rows) {
+	columns = p_columns;
+	rows = p_rows;
+}
+
+void GridArea::set_hexagonal(bool p_hexagonal) {
+	hexagonal = p_hexagonal;
+}
+
+void GridArea::set_diagonal(bool p_diagonal) {
+	diagonal = p_diagonal;
+}
+
+bool GridArea::_is_inside(int p_column, int p_row) const {
+	return p_column >= 0 && p_column < columns && p_row >= 0 && p_row < rows;
+}
+
+void GridArea::_cell_center(int p_column, int p_row, float &r_x, float &r_y) const {
+	if (hexagonal) {
+		r_x = p_column + 0.5f * (p_row & 1);
+		r_y = p_row * HEX_ROW_SPACING;
+	} else {
+		r_x = static_cast<float>(p_column);
+		r_y = static_cast<float>(p_row);
+	}
+}
+
+int GridArea::distance(int p_from, int p_to) const {
+	const int column0 = p_from % columns;
+	const int row0 = p_from / columns;
+	const int column1 = p_to % columns;
+	const int row1 = p_to / columns;
+
+	if (hexagonal) {
+		return hex_offset_distance(column0, row0, column1, row1);
+	}
+
+	const int dx = std::abs(column1 - column0);
+	const int dy = std::abs(row1 - row0);
+	return diagonal ? std::max(dx, dy) : dx + dy;
+}
+
+void GridArea::cells_in_radius(int p_origin, int p_radius, GridVector<int> &r_cells) const {
+	r_cells.clear();
+
+	if (p_origin < 0 || p_origin >= columns * rows || p_radius < 0) {
+		return;
+	}
+
+	const int column = p_origin % columns;
+	const int row = p_origin / columns;
+
+	// The hexagonal bounding box is one column wider for the shifted rows.
+	const int margin = hexagonal ? 1 : 0;
+	const int first_row = std::max(0, row - p_radius);
+	const int last_row = std::min(rows - 1, row + p_radius);
+	const int first_column = std::max(0, column - p_radius - margin);
+	const int last_column = std::min(columns - 1, column + p_radius + margin);
+
+	for (int y = first_row; y <= last_row; y++) {
+		for (int x = first_column; x <= last_column; x++) {
+			const int index = y * columns + x;
+			if (distance(p_origin, index) <= p_radius) {
+				r_cells.push_back(index);
+			}
+		}
+	}
+}
+
+void GridArea::cells_in_ring(int p_origin, int p_radius, GridVector<int> &r_cells) const {
+	cells_in_radius(p_origin, p_radius, r_cells);
+
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < r_cells.size(); i++) {
+		if (distance(p_origin, r_cells[i]) == p_radius) {
+			r_cells[kept++] = r_cells[i];
+		}
+	}
+	r_cells.resize(kept);
+}
+
+void GridArea::_square_line(int p_from, int p_to, GridVector<int> &r_cells) const {
+	int x = p_from % columns;
+	int y = p_from / columns;
+	const int x1 = p_to % columns;
+	const int y1 = p_to / columns;
+
+	const int dx = std::abs(x1 - x);
+	const int dy = -std::abs(y1 - y);
+	const int sx = x < x1 ? 1 : -1;
+	const int sy = y < y1 ? 1 : -1;
+	int error = dx + dy;
+
+	while (true) {
+		r_cells.push_back(y * columns + x);
+
+		if (x == x1 && y == y1) {
+			break;
+		}
+
+		const int doubled_error = 2 * error;
+		if (doubled_error >= dy) {
+			error += dy;
+			x += sx;
+		}
+		if (doubled_error <= dx) {
+			error += dx;
+			y += sy;
+		}
+	}
+}
+
+void GridArea::_hexagonal_line(int p_from, int p_to, GridVector<int> &r_cells) const {
+	const int r0 = p_from / columns;
+	const int q0 = hex_offset_to_axial_q(p_from % columns, r0);
+	const int r1 = p_to / columns;
+	const int q1 = hex_offset_to_axial_q(p_to % columns, r1);
+	const int steps = hex_axial_distance(q0, r0, q1, r1);
+
+	r_cells.push_back(p_from);
+
+	// Nudged so a line running between two hexes picks the same side each
+	// time, unless that side is off the grid (lines along its jagged edges).
+	for (int step = 1; step <= steps; step++) {
+		const float t = static_cast<float>(step) / steps;
+		const float q_line = q0 + (q1 - q0) * t;
+		const float r_line = r0 + (r1 - r0) * t;
+
+		int q;
+		int r;
+		hex_axial_round(q_line + 1e-4f, r_line + 1e-4f, q, r);
+
+		int column = hex_axial_to_offset_column(q, r);
+		if (!_is_inside(column, r)) {
+			hex_axial_round(q_line - 1e-4f, r_line - 1e-4f, q, r);
+			column = hex_axial_to_offset_column(q, r);
+		}
+
+		if (_is_inside(column, r)) {
+			r_cells.push_back(r * columns + column);
+		}
+	}
+}
+
+void GridArea::cells_on_line(int p_from, int p_to, GridVector<int> &r_cells) const {
+	r_cells.clear();
+
+	if (p_from < 0 || p_from >= columns * rows || p_to < 0 || p_to >= columns * rows) {
+		return;
+	}
+
+	if (hexagonal) {
+		_hexagonal_line(p_from, p_to, r_cells);
+	} else {
+		_square_line(p_from, p_to, r_cells);
+	}
+}
+
+void GridArea::cells_in_cone(int p_origin, float p_direction_x, float p_direction_y, float p_angle, int p_radius, GridVector<int> &r_cells) const {
+	cells_in_radius(p_origin, p_radius, r_cells);
+
+	const float direction_length = std::sqrt(p_direction_x * p_direction_x + p_direction_y * p_direction_y);
+	if (direction_length <= 0.0f) {
+		r_cells.clear();
+		return;
+	}
+
+	const float direction_x = p_direction_x / direction_length;
+	const float direction_y = p_direction_y / direction_length;
+
+	// Compared as cosines, with some slack for the cells right on an edge.
+	const float min_cosine = std::cos(std::min(p_angle, 6.2831853f) * 0.5f) - 1e-5f;
+
+	float origin_x;
+	float origin_y;
+	_cell_center(p_origin % columns, p_origin / columns, origin_x, origin_y);
+
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < r_cells.size(); i++) {
+		const int index = r_cells[i];
+		if (index == p_origin) {
+			continue;
+		}
+
+		float x;
+		float y;
+		_cell_center(index % columns, index / columns, x, y);
+		x -= origin_x;
+		y -= origin_y;
+
+		const float length = std::sqrt(x * x + y * y);
+		if ((x * direction_x + y * direction_y) >= min_cosine * length) {
+			r_cells[kept++] = index;
+		}
+	}
+	r_cells.resize(kept);
+}
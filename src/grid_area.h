@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  grid_area.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+
+// Area of effect queries from pure index math, on the square layout or the
+// hexagonal layout (odd rows shifted right). Steps are counted with the hex
+// distance on the hexagonal layout, and with the Manhattan distance (4
+// directions) or the Chebyshev distance (diagonal steps allowed) on the
+// square one. Accessibility is ignored: the shapes are purely geometric.
+class GridArea {
+private:
+	int columns = 0;
+	int rows = 0;
+	bool hexagonal = false;
+	bool diagonal = false;
+
+	bool _is_inside(int p_column, int p_row) const;
+	void _cell_center(int p_column, int p_row, float &r_x, float &r_y) const;
+
+	void _square_line(int p_from, int p_to, GridVector<int> &r_cells) const;
+	void _hexagonal_line(int p_from, int p_to, GridVector<int> &r_cells) const;
+
+public:
+	void resize(int p_columns, int p_rows);
+	void set_hexagonal(bool p_hexagonal);
+	void set_diagonal(bool p_diagonal);
+
+	int distance(int p_from, int p_to) const;
+
+	// Cells at most p_radius steps away from p_origin, the origin included,
+	// in index order.
+	void cells_in_radius(int p_origin, int p_radius, GridVector<int> &r_cells) const;
+
+	// Cells exactly p_radius steps away from p_origin, in index order.
+	void cells_in_ring(int p_origin, int p_radius, GridVector<int> &r_cells) const;
+
+	// Cells crossed by the line between two cell centers, both ends
+	// included, from p_from to p_to (Bresenham, or a cube-rounded hex line).
+	void cells_on_line(int p_from, int p_to, GridVector<int> &r_cells) const;
+
+	// Cells within p_radius steps whose center lies inside the cone of
+	// aperture p_angle (radians) opening from p_origin along the
+	// (p_direction_x, p_direction_y) grid direction, the origin excluded,
+	// in index order. The grid direction runs along columns and rows.
+	void cells_in_cone(int p_origin, float p_direction_x, float p_direction_y, float p_angle, int p_radius, GridVector<int> &r_cells) const;
+};
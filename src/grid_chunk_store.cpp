@@ -0,0 +1,453 @@
+/**************************************************************************/
+/*  grid_chunk_store.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_chunk_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char file_magic[4] = { 'I', 'G', 'C', 'S' };
+constexpr uint32_t FILE_VERSION = 1;
+constexpr uint32_t MIN_FILE_RECORD_CAPACITY = 16;
+
+} // namespace
+
+uint64_t GridChunkStore::make_key(int p_x, int p_z) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(p_x)) << 32) | static_cast<uint32_t>(p_z);
+}
+
+void GridChunkStore::get_key_coordinates(uint64_t p_key, int &r_x, int &r_z) {
+	r_x = static_cast<int32_t>(static_cast<uint32_t>(p_key >> 32));
+	r_z = static_cast<int32_t>(static_cast<uint32_t>(p_key & 0xFFFFFFFF));
+}
+
+uint64_t GridChunkStore::_get_chunk_bytes() const {
+	// The chunk, its cells and its entry in the slot map.
+	return sizeof(Chunk) + static_cast<uint64_t>(get_cells_per_chunk()) * sizeof(GridChunkCell) +
+			sizeof(uint64_t) + sizeof(int) + sizeof(uint32_t) + 3 * sizeof(void *);
+}
+
+uint64_t GridChunkStore::_get_record_bytes() const {
+	return sizeof(FileRecordHeader) + static_cast<uint64_t>(get_cells_per_chunk()) * sizeof(GridChunkCell);
+}
+
+GridChunkStore::FileHeader *GridChunkStore::_get_file_header() {
+	return reinterpret_cast<FileHeader *>(file.ptr());
+}
+
+void GridChunkStore::_unlink(int p_slot) {
+	Chunk &chunk = chunks[p_slot];
+
+	if (chunk.previous != -1) {
+		chunks[chunk.previous].next = chunk.next;
+	} else {
+		head = chunk.next;
+	}
+
+	if (chunk.next != -1) {
+		chunks[chunk.next].previous = chunk.previous;
+	} else {
+		tail = chunk.previous;
+	}
+
+	chunk.previous = -1;
+	chunk.next = -1;
+}
+
+void GridChunkStore::_push_front(int p_slot) {
+	Chunk &chunk = chunks[p_slot];
+	chunk.previous = -1;
+	chunk.next = head;
+
+	if (head != -1) {
+		chunks[head].previous = p_slot;
+	}
+	head = p_slot;
+
+	if (tail == -1) {
+		tail = p_slot;
+	}
+}
+
+void GridChunkStore::_touch(int p_slot) {
+	if (head != p_slot) {
+		_unlink(p_slot);
+		_push_front(p_slot);
+	}
+}
+
+int GridChunkStore::_allocate(uint64_t p_key) {
+	int slot = -1;
+
+	if (!free_slots.is_empty()) {
+		slot = free_slots[free_slots.size() - 1];
+		free_slots.remove_at(free_slots.size() - 1);
+	} else {
+		slot = chunks.size();
+		chunks.push_back(Chunk());
+	}
+
+	Chunk &chunk = chunks[slot];
+	chunk.key = p_key;
+	chunk.cells.resize(get_cells_per_chunk());
+
+	slots.insert(p_key, slot);
+	loaded_count++;
+	_push_front(slot);
+
+	return slot;
+}
+
+void GridChunkStore::_evict(int p_keep_slot) {
+	// The most recently used chunk always stays, whatever the budget.
+	while (loaded_count > 1 && loaded_count * _get_chunk_bytes() > memory_budget) {
+		const int slot = tail;
+		if (slot == p_keep_slot) {
+			break;
+		}
+
+		_unlink(slot);
+		slots.erase(chunks[slot].key);
+		chunks[slot].cells.reset();
+		free_slots.push_back(slot);
+
+		loaded_count--;
+		evictions++;
+	}
+}
+
+bool GridChunkStore::_reset_file() {
+	file_records.clear();
+	file_record_capacity = 0;
+
+	if (!file.resize(sizeof(FileHeader)) || file.ptr() == nullptr) {
+		return false;
+	}
+
+	FileHeader header;
+	std::memcpy(header.magic, file_magic, sizeof(file_magic));
+	header.version = FILE_VERSION;
+	header.chunk_size = chunk_size;
+	header.record_count = 0;
+	header.signature = signature;
+	std::memcpy(file.ptr(), &header, sizeof(FileHeader));
+
+	return true;
+}
+
+bool GridChunkStore::_load_file() {
+	file_records.clear();
+	file_record_capacity = 0;
+
+	if (file.get_size() < sizeof(FileHeader) || file.ptr() == nullptr) {
+		return _reset_file();
+	}
+
+	const FileHeader *header = _get_file_header();
+	const uint64_t record_bytes = _get_record_bytes();
+	const uint64_t record_capacity = (file.get_size() - sizeof(FileHeader)) / record_bytes;
+
+	if (std::memcmp(header->magic, file_magic, sizeof(file_magic)) != 0 || header->version != FILE_VERSION ||
+			header->chunk_size != static_cast<uint32_t>(chunk_size) || header->signature != signature ||
+			header->record_count > record_capacity) {
+		return _reset_file();
+	}
+
+	file_record_capacity = static_cast<uint32_t>(record_capacity);
+
+	for (uint32_t record = 0; record < header->record_count; record++) {
+		FileRecordHeader record_header;
+		std::memcpy(&record_header, file.ptr() + sizeof(FileHeader) + record * record_bytes, sizeof(FileRecordHeader));
+		file_records.insert(make_key(record_header.x, record_header.z), record);
+	}
+
+	return true;
+}
+
+void GridChunkStore::_write_record(uint64_t p_key, const GridChunkCell *p_cells) {
+	const uint64_t record_bytes = _get_record_bytes();
+
+	uint32_t record = 0;
+	const uint32_t *existing_record = file_records.getptr(p_key);
+
+	if (existing_record != nullptr) {
+		record = *existing_record;
+	} else {
+		record = _get_file_header()->record_count;
+
+		if (record >= file_record_capacity) {
+			const uint32_t capacity = std::max(MIN_FILE_RECORD_CAPACITY, file_record_capacity * 2);
+
+			if (!file.resize(sizeof(FileHeader) + capacity * record_bytes) || file.ptr() == nullptr) {
+				close_file(); // Out of disk space: keep streaming without the cache file.
+				return;
+			}
+			file_record_capacity = capacity;
+		}
+	}
+
+	FileRecordHeader record_header;
+	get_key_coordinates(p_key, record_header.x, record_header.z);
+
+	uint8_t *destination = file.ptr() + sizeof(FileHeader) + record * record_bytes;
+	std::memcpy(destination, &record_header, sizeof(FileRecordHeader));
+	std::memcpy(destination + sizeof(FileRecordHeader), p_cells, get_cells_per_chunk() * sizeof(GridChunkCell));
+
+	if (existing_record == nullptr) {
+		// Counted last, so an interrupted write never exposes a partial record.
+		_get_file_header()->record_count = record + 1;
+		file_records.insert(p_key, record);
+	}
+}
+
+bool GridChunkStore::_read_record(uint64_t p_key, GridChunkCell *r_cells) const {
+	const uint32_t *record = file_records.getptr(p_key);
+	if (record == nullptr || file.ptr() == nullptr) {
+		return false;
+	}
+
+	const uint8_t *source = file.ptr() + sizeof(FileHeader) + *record * _get_record_bytes();
+	std::memcpy(r_cells, source + sizeof(FileRecordHeader), get_cells_per_chunk() * sizeof(GridChunkCell));
+
+	return true;
+}
+
+void GridChunkStore::configure(int p_chunk_size, uint64_t p_signature) {
+	if (p_chunk_size < 1) {
+		p_chunk_size = 1;
+	}
+
+	if (p_chunk_size == chunk_size && p_signature == signature) {
+		return;
+	}
+
+	chunk_size = p_chunk_size;
+	signature = p_signature;
+	clear();
+}
+
+int GridChunkStore::get_chunk_size() const {
+	return chunk_size;
+}
+
+int GridChunkStore::get_cells_per_chunk() const {
+	return chunk_size * chunk_size;
+}
+
+int GridChunkStore::get_cell_chunk(int p_column, int p_row, int &r_x, int &r_z) const {
+	// Rounded down, negative cells included.
+	r_x = p_column >= 0 ? p_column / chunk_size : -((-p_column - 1) / chunk_size) - 1;
+	r_z = p_row >= 0 ? p_row / chunk_size : -((-p_row - 1) / chunk_size) - 1;
+
+	return (p_row - r_z * chunk_size) * chunk_size + (p_column - r_x * chunk_size);
+}
+
+void GridChunkStore::set_memory_budget(uint64_t p_bytes) {
+	memory_budget = p_bytes;
+	_evict(head);
+}
+
+uint64_t GridChunkStore::get_memory_budget() const {
+	return memory_budget;
+}
+
+bool GridChunkStore::open_file(const std::string &p_path) {
+	close_file();
+
+	if (!file.open(p_path)) {
+		return false;
+	}
+
+	if (!_load_file()) {
+		close_file();
+		return false;
+	}
+
+	file_path = p_path;
+
+	// Loaded chunks scanned before the file was opened are kept for later runs too.
+	for (int slot = head; slot != -1; slot = chunks[slot].next) {
+		if (!file_records.has(chunks[slot].key)) {
+			_write_record(chunks[slot].key, chunks[slot].cells.ptr());
+		}
+	}
+
+	return is_file_open();
+}
+
+void GridChunkStore::close_file() {
+	file.close();
+	file_path.clear();
+	file_records.clear();
+	file_record_capacity = 0;
+}
+
+bool GridChunkStore::is_file_open() const {
+	return file.is_open();
+}
+
+const std::string &GridChunkStore::get_file_path() const {
+	return file_path;
+}
+
+bool GridChunkStore::is_loaded(int p_x, int p_z) const {
+	return slots.has(make_key(p_x, p_z));
+}
+
+bool GridChunkStore::is_cached(int p_x, int p_z) const {
+	const uint64_t key = make_key(p_x, p_z);
+	return slots.has(key) || file_records.has(key);
+}
+
+const GridChunkCell *GridChunkStore::get_loaded(int p_x, int p_z) const {
+	const int *slot = slots.getptr(make_key(p_x, p_z));
+	return slot != nullptr ? chunks[*slot].cells.ptr() : nullptr;
+}
+
+const GridChunkCell *GridChunkStore::acquire(int p_x, int p_z) {
+	const uint64_t key = make_key(p_x, p_z);
+
+	const int *existing_slot = slots.getptr(key);
+	if (existing_slot != nullptr) {
+		const int slot = *existing_slot;
+		_touch(slot);
+		return chunks[slot].cells.ptr();
+	}
+
+	if (!file_records.has(key)) {
+		return nullptr;
+	}
+
+	const int slot = _allocate(key);
+	_read_record(key, chunks[slot].cells.ptr());
+	file_loads++;
+
+	_evict(slot);
+	return chunks[slot].cells.ptr();
+}
+
+GridChunkCell *GridChunkStore::create(int p_x, int p_z) {
+	const uint64_t key = make_key(p_x, p_z);
+
+	int slot = -1;
+	const int *existing_slot = slots.getptr(key);
+
+	if (existing_slot != nullptr) {
+		slot = *existing_slot;
+		_touch(slot);
+
+		for (GridChunkCell &cell : chunks[slot].cells) {
+			cell = GridChunkCell();
+		}
+	} else {
+		slot = _allocate(key);
+	}
+	scans++;
+
+	_evict(slot);
+	return chunks[slot].cells.ptr();
+}
+
+void GridChunkStore::store(int p_x, int p_z) {
+	if (!is_file_open()) {
+		return;
+	}
+
+	const int *slot = slots.getptr(make_key(p_x, p_z));
+	if (slot != nullptr) {
+		_write_record(chunks[*slot].key, chunks[*slot].cells.ptr());
+	}
+}
+
+void GridChunkStore::clear() {
+	slots.clear();
+	chunks.clear();
+	free_slots.clear();
+	head = -1;
+	tail = -1;
+	loaded_count = 0;
+
+	if (is_file_open() && !_reset_file()) {
+		close_file();
+	}
+}
+
+void GridChunkStore::flush() {
+	file.flush();
+}
+
+int GridChunkStore::get_loaded_count() const {
+	return loaded_count;
+}
+
+int GridChunkStore::get_cached_count() const {
+	int count = file_records.size();
+
+	for (int slot = head; slot != -1; slot = chunks[slot].next) {
+		if (!file_records.has(chunks[slot].key)) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void GridChunkStore::get_loaded_keys(GridVector<uint64_t> &r_keys) const {
+	r_keys.clear();
+
+	for (int slot = head; slot != -1; slot = chunks[slot].next) {
+		r_keys.push_back(chunks[slot].key);
+	}
+}
+
+uint64_t GridChunkStore::get_scans() const {
+	return scans;
+}
+
+uint64_t GridChunkStore::get_file_loads() const {
+	return file_loads;
+}
+
+uint64_t GridChunkStore::get_evictions() const {
+	return evictions;
+}
+
+void GridChunkStore::reset_stats() {
+	scans = 0;
+	file_loads = 0;
+	evictions = 0;
+}
+
+uint64_t GridChunkStore::get_memory_usage() const {
+	return grid_memory_usage(slots) + grid_memory_usage(chunks) + grid_memory_usage(free_slots) +
+			grid_memory_usage(file_records) +
+			static_cast<uint64_t>(loaded_count) * get_cells_per_chunk() * sizeof(GridChunkCell);
+}
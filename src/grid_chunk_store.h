@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  grid_chunk_store.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+#include "grid_mapped_file.h"
+
+#include <cstdint>
+#include <string>
+
+// Scan result of one world cell: what the floor ray and the obstacle and
+// custom data shape queries found there.
+struct GridChunkCell {
+	float height = 0.0f;
+	float normal_x = 0.0f;
+	float normal_y = 1.0f;
+	float normal_z = 0.0f;
+	uint32_t flags = 0;
+	// Bit i: the i-th custom cell data matched the cell.
+	uint32_t custom_data = 0;
+};
+
+// Scanned world cells grouped in square chunks of chunk_size x chunk_size
+// cells, chunk (x, z) covering the world columns [x * chunk_size,
+// (x + 1) * chunk_size) and rows [z * chunk_size, (z + 1) * chunk_size).
+//
+// Loaded chunks are kept in memory under a byte budget, the least recently
+// used being evicted first. With a cache file, every stored chunk is also
+// written to a memory-mapped file, so evicted chunks, and chunks of a
+// previous run, are loaded back without scanning the world again. Chunks
+// only hold while the scan settings they were made with match: any change
+// of the chunk size or of the settings signature drops them, in memory and
+// in the file.
+class GridChunkStore {
+public:
+	// A floor was hit under the cell, or none was (the cell is in the void).
+	// Neither flag is set when the floor is not scanned or hidden.
+	static constexpr uint32_t CELL_FLOOR = 1 << 0;
+	static constexpr uint32_t CELL_VOID = 1 << 1;
+	static constexpr uint32_t CELL_OBSTACLE = 1 << 2;
+
+private:
+	struct Chunk {
+		uint64_t key = 0;
+		GridVector<GridChunkCell> cells;
+		// Recency list links, most recently used first.
+		int previous = -1;
+		int next = -1;
+	};
+
+	// Cache file layout: the header, then one record per chunk holding its
+	// coordinates and its cells, in the native byte order.
+	struct FileHeader {
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t chunk_size = 0;
+		uint32_t record_count = 0;
+		uint64_t signature = 0;
+		uint64_t reserved = 0;
+	};
+
+	struct FileRecordHeader {
+		int32_t x = 0;
+		int32_t z = 0;
+	};
+
+	int chunk_size = 16;
+	uint64_t signature = 0;
+	uint64_t memory_budget = 64 * 1024 * 1024;
+
+	GridHashMap<uint64_t, int> slots;
+	GridVector<Chunk> chunks;
+	GridVector<int> free_slots;
+	int head = -1;
+	int tail = -1;
+	int loaded_count = 0;
+
+	GridMappedFile file;
+	std::string file_path;
+	// Record index of each chunk stored in the file.
+	GridHashMap<uint64_t, uint32_t> file_records;
+	uint32_t file_record_capacity = 0;
+
+	uint64_t scans = 0;
+	uint64_t file_loads = 0;
+	uint64_t evictions = 0;
+
+	uint64_t _get_chunk_bytes() const;
+	uint64_t _get_record_bytes() const;
+	FileHeader *_get_file_header();
+
+	void _unlink(int p_slot);
+	void _push_front(int p_slot);
+	void _touch(int p_slot);
+	int _allocate(uint64_t p_key);
+	void _evict(int p_keep_slot);
+
+	bool _reset_file();
+	bool _load_file();
+	void _write_record(uint64_t p_key, const GridChunkCell *p_cells);
+	bool _read_record(uint64_t p_key, GridChunkCell *r_cells) const;
+
+public:
+	static uint64_t make_key(int p_x, int p_z);
+	static void get_key_coordinates(uint64_t p_key, int &r_x, int &r_z);
+
+	// Drops every chunk when the size or the signature changes.
+	void configure(int p_chunk_size, uint64_t p_signature);
+	int get_chunk_size() const;
+	int get_cells_per_chunk() const;
+	// Chunk holding a world cell, and the index of the cell in the chunk.
+	int get_cell_chunk(int p_column, int p_row, int &r_x, int &r_z) const;
+
+	void set_memory_budget(uint64_t p_bytes);
+	uint64_t get_memory_budget() const;
+
+	// Chunks already in the file are kept if it was written with the same
+	// chunk size and signature, otherwise the file is emptied.
+	bool open_file(const std::string &p_path);
+	void close_file();
+	bool is_file_open() const;
+	const std::string &get_file_path() const;
+
+	bool is_loaded(int p_x, int p_z) const;
+	// Loaded, or stored in the cache file.
+	bool is_cached(int p_x, int p_z) const;
+
+	// Cells of a loaded chunk (row by row), without changing its recency.
+	const GridChunkCell *get_loaded(int p_x, int p_z) const;
+
+	// Cells of a chunk, loaded from the cache file if needed and marked as
+	// the most recently used; nullptr if the chunk was never stored. The
+	// pointer stays valid until the next acquire() or create().
+	const GridChunkCell *acquire(int p_x, int p_z);
+
+	// Empty cells of a new loaded chunk, to be filled then passed to store().
+	// The pointer stays valid until the next acquire() or create().
+	GridChunkCell *create(int p_x, int p_z);
+	// Writes a created chunk to the cache file.
+	void store(int p_x, int p_z);
+
+	// Drops the chunks in memory and in the cache file.
+	void clear();
+	void flush();
+
+	int get_loaded_count() const;
+	int get_cached_count() const;
+	void get_loaded_keys(GridVector<uint64_t> &r_keys) const;
+
+	uint64_t get_scans() const;
+	uint64_t get_file_loads() const;
+	uint64_t get_evictions() const;
+	void reset_stats();
+
+	// Bytes held by the loaded chunks and the indexes, the mapping excluded.
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,226 @@
+/**************************************************************************/
+/*  grid_chunk_streamer.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_chunk_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+GridChunkStore &GridChunkStreamer::get_store() {
+	return store;
+}
+
+const GridChunkStore &GridChunkStreamer::get_store() const {
+	return store;
+}
+
+void GridChunkStreamer::set_profiler(GridProfiler *p_profiler) {
+	profiler = p_profiler;
+}
+
+void GridChunkStreamer::set_radius(int p_radius) {
+	radius = std::max(0, p_radius);
+}
+
+int GridChunkStreamer::get_radius() const {
+	return radius;
+}
+
+const GridChunkCell *GridChunkStreamer::acquire(int p_x, int p_z) {
+	if (store.is_loaded(p_x, p_z)) {
+		return store.acquire(p_x, p_z);
+	}
+
+	if (!store.is_cached(p_x, p_z)) {
+		return nullptr;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	const GridChunkCell *chunk_cells = store.acquire(p_x, p_z);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (profiler) {
+		profiler->record(GridProfiler::PHASE_CHUNK_LOAD, start, end, store.get_cells_per_chunk());
+	}
+
+	return chunk_cells;
+}
+
+void GridChunkStreamer::clear_streamed_chunks() {
+	streamed_chunks.clear();
+	streamed_chunk_indexes.clear();
+}
+
+void GridChunkStreamer::add_focus_cell(int p_column, int p_row, float p_height) {
+	int focus_chunk_x = 0;
+	int focus_chunk_z = 0;
+	store.get_cell_chunk(p_column, p_row, focus_chunk_x, focus_chunk_z);
+
+	for (int dz = -radius; dz <= radius; dz++) {
+		for (int dx = -radius; dx <= radius; dx++) {
+			StreamedChunk streamed_chunk;
+			streamed_chunk.x = focus_chunk_x + dx;
+			streamed_chunk.z = focus_chunk_z + dz;
+			streamed_chunk.distance = dx * dx + dz * dz;
+			streamed_chunk.height = p_height;
+
+			const uint64_t key = GridChunkStore::make_key(streamed_chunk.x, streamed_chunk.z);
+			const int *existing_index = streamed_chunk_indexes.getptr(key);
+
+			if (existing_index == nullptr) {
+				streamed_chunk_indexes.insert(key, streamed_chunks.size());
+				streamed_chunks.push_back(streamed_chunk);
+			} else if (streamed_chunk.distance < streamed_chunks[*existing_index].distance) {
+				streamed_chunks[*existing_index] = streamed_chunk;
+			}
+		}
+	}
+}
+
+void GridChunkStreamer::sort_streamed_chunks() {
+	std::sort(streamed_chunks.ptr(), streamed_chunks.ptr() + streamed_chunks.size(), [](const StreamedChunk &p_a, const StreamedChunk &p_b) {
+		return p_a.distance < p_b.distance;
+	});
+
+	// Indexes follow the chunks for later focus cells.
+	for (uint32_t index = 0; index < streamed_chunks.size(); index++) {
+		streamed_chunk_indexes.insert(GridChunkStore::make_key(streamed_chunks[index].x, streamed_chunks[index].z), index);
+	}
+}
+
+const GridVector<GridChunkStreamer::StreamedChunk> &GridChunkStreamer::get_streamed_chunks() const {
+	return streamed_chunks;
+}
+
+int GridChunkStreamer::get_missing_chunk_count() const {
+	int missing_chunks = 0;
+
+	for (const StreamedChunk &streamed_chunk : streamed_chunks) {
+		if (!store.is_cached(streamed_chunk.x, streamed_chunk.z)) {
+			missing_chunks++;
+		}
+	}
+
+	return missing_chunks;
+}
+
+GridChunkStreamer::RegionStatus GridChunkStreamer::build_region(int p_from_column, int p_from_row, int p_to_column, int p_to_row,
+		GridPathfinder::Movement p_movement, int64_t p_max_cell_count, int64_t &r_cell_count) {
+	const int chunk_size = store.get_chunk_size();
+	r_cell_count = 0;
+
+	int from_chunk_x = 0;
+	int from_chunk_z = 0;
+	int to_chunk_x = 0;
+	int to_chunk_z = 0;
+	store.get_cell_chunk(p_from_column, p_from_row, from_chunk_x, from_chunk_z);
+	store.get_cell_chunk(p_to_column, p_to_row, to_chunk_x, to_chunk_z);
+
+	if (!store.is_cached(from_chunk_x, from_chunk_z) || !store.is_cached(to_chunk_x, to_chunk_z)) {
+		return REGION_NOT_CACHED;
+	}
+
+	const int min_chunk_x = std::min(from_chunk_x, to_chunk_x) - radius;
+	const int min_chunk_z = std::min(from_chunk_z, to_chunk_z) - radius;
+	const int max_chunk_x = std::max(from_chunk_x, to_chunk_x) + radius;
+	const int max_chunk_z = std::max(from_chunk_z, to_chunk_z) + radius;
+
+	const int64_t column_count = static_cast<int64_t>(max_chunk_x - min_chunk_x + 1) * chunk_size;
+	const int64_t row_count = static_cast<int64_t>(max_chunk_z - min_chunk_z + 1) * chunk_size;
+	r_cell_count = column_count * row_count;
+
+	if (r_cell_count > p_max_cell_count) {
+		return REGION_TOO_LARGE;
+	}
+
+	const int columns = static_cast<int>(column_count);
+	const int rows = static_cast<int>(row_count);
+
+	region_column = min_chunk_x * chunk_size;
+	region_row = min_chunk_z * chunk_size;
+	region_custom_cells.clear();
+
+	region_pathfinder.resize(columns, rows);
+	region_pathfinder.set_movement(p_movement);
+
+	for (int chunk_z = min_chunk_z; chunk_z <= max_chunk_z; chunk_z++) {
+		for (int chunk_x = min_chunk_x; chunk_x <= max_chunk_x; chunk_x++) {
+			const GridChunkCell *chunk_cells = acquire(chunk_x, chunk_z);
+
+			for (int local_row = 0; local_row < chunk_size; local_row++) {
+				for (int local_column = 0; local_column < chunk_size; local_column++) {
+					const int index = ((chunk_z - min_chunk_z) * chunk_size + local_row) * columns +
+							(chunk_x - min_chunk_x) * chunk_size + local_column;
+
+					if (chunk_cells == nullptr) {
+						region_pathfinder.set_walkable(index, false);
+						continue;
+					}
+
+					const GridChunkCell &cell = chunk_cells[local_row * chunk_size + local_column];
+					region_pathfinder.set_walkable(index, !(cell.flags & (GridChunkStore::CELL_VOID | GridChunkStore::CELL_OBSTACLE)));
+
+					const float slope = std::acos(std::max(-1.0f, std::min(1.0f, cell.normal_y)));
+					region_pathfinder.set_cell_terrain(index, cell.height, slope);
+
+					if (cell.custom_data != 0) {
+						CustomCell custom_cell;
+						custom_cell.index = index;
+						custom_cell.custom_data = cell.custom_data;
+						region_custom_cells.push_back(custom_cell);
+					}
+				}
+			}
+		}
+	}
+
+	return REGION_READY;
+}
+
+GridPathfinder &GridChunkStreamer::get_region_pathfinder() {
+	return region_pathfinder;
+}
+
+const GridVector<GridChunkStreamer::CustomCell> &GridChunkStreamer::get_region_custom_cells() const {
+	return region_custom_cells;
+}
+
+int GridChunkStreamer::get_region_index(int p_column, int p_row) const {
+	return (p_row - region_row) * region_pathfinder.get_columns() + (p_column - region_column);
+}
+
+void GridChunkStreamer::get_region_cell(int p_index, int &r_column, int &r_row) const {
+	r_column = region_column + p_index % region_pathfinder.get_columns();
+	r_row = region_row + p_index / region_pathfinder.get_columns();
+}
+
+uint64_t GridChunkStreamer::get_memory_usage() const {
+	return region_pathfinder.get_memory_usage() + grid_memory_usage(streamed_chunks) + grid_memory_usage(streamed_chunk_indexes) +
+			grid_memory_usage(region_custom_cells);
+}
@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  grid_chunk_streamer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_chunk_store.h"
+#include "grid_core.h"
+#include "grid_pathfinder.h"
+#include "grid_profiler.h"
+
+#include <cstdint>
+
+// Streaming over a GridChunkStore: which chunks to keep around the focus
+// cells, and searches across the stored chunks. Scanning the world is left
+// to the owner, which fills the chunks the store does not hold yet.
+class GridChunkStreamer {
+public:
+	struct StreamedChunk {
+		int x = 0;
+		int z = 0;
+		int distance = 0; // Squared, in chunks, to the closest focus cell.
+		float height = 0.0f;
+	};
+
+	// Region cell whose custom data changes its costs.
+	struct CustomCell {
+		int index = -1;
+		uint32_t custom_data = 0;
+	};
+
+	enum RegionStatus {
+		REGION_READY,
+		REGION_NOT_CACHED, // An end of the path is in a chunk never scanned.
+		REGION_TOO_LARGE
+	};
+
+private:
+	GridChunkStore store;
+	GridProfiler *profiler = nullptr;
+	int radius = 1;
+
+	// Chunks around the focus cells, the closest first once sorted.
+	GridVector<StreamedChunk> streamed_chunks;
+	GridHashMap<uint64_t, int> streamed_chunk_indexes;
+
+	// Stored chunks laid out as one grid, from the world cell (region_column, region_row).
+	GridPathfinder region_pathfinder;
+	int region_column = 0;
+	int region_row = 0;
+	GridVector<CustomCell> region_custom_cells;
+
+public:
+	GridChunkStore &get_store();
+	const GridChunkStore &get_store() const;
+
+	// Chunk loads from the cache file are recorded there.
+	void set_profiler(GridProfiler *p_profiler);
+
+	void set_radius(int p_radius);
+	int get_radius() const;
+
+	// Cells of a stored chunk, loaded from the cache file if needed; nullptr
+	// if the chunk has to be scanned first.
+	const GridChunkCell *acquire(int p_x, int p_z);
+
+	void clear_streamed_chunks();
+	// Adds the chunks within the radius of the chunk holding a world cell.
+	void add_focus_cell(int p_column, int p_row, float p_height);
+	void sort_streamed_chunks();
+	const GridVector<StreamedChunk> &get_streamed_chunks() const;
+	int get_missing_chunk_count() const;
+
+	// Lays out the chunks spanned by both ends, widened by the radius to go
+	// around obstacles, as one pathfinder grid; chunks never scanned are
+	// blocked. r_cell_count is the number of cells of the region.
+	RegionStatus build_region(int p_from_column, int p_from_row, int p_to_column, int p_to_row,
+			GridPathfinder::Movement p_movement, int64_t p_max_cell_count, int64_t &r_cell_count);
+	GridPathfinder &get_region_pathfinder();
+	const GridVector<CustomCell> &get_region_custom_cells() const;
+	int get_region_index(int p_column, int p_row) const;
+	void get_region_cell(int p_index, int &r_column, int &r_row) const;
+
+	// Bytes held by the region pathfinder, the store is reported on its own.
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,301 @@
+/**************************************************************************/
+/*  grid_cooperative_planner.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_cooperative_planner.h"
+
+#include <limits>
+
+namespace {
+
+// Waiting costs as much as a straight step on a plain cell.
+const float WAIT_COST = 1.0f;
+
+} // namespace
+
+uint64_t GridCooperativePlanner::_make_key(int p_cell, int p_time) const {
+	return static_cast<uint64_t>(p_time) * static_cast<uint64_t>(size) + static_cast<uint64_t>(p_cell);
+}
+
+int GridCooperativePlanner::_get_reservation(int p_cell, int p_time) const {
+	const int *agent = reservations.getptr(_make_key(p_cell, p_time));
+	return agent ? *agent : -1;
+}
+
+bool GridCooperativePlanner::_is_free(int p_agent, int p_from, int p_to, int p_time) const {
+	// Start of an agent not planned yet, or never planned.
+	if (start_owners[p_to] != -1 && start_owners[p_to] != p_agent) {
+		return false;
+	}
+
+	// Vertex conflict at the arrival time.
+	if (p_time + 1 >= resting_times[p_to]) {
+		return false;
+	}
+
+	const int occupant = _get_reservation(p_to, p_time + 1);
+	if (occupant != -1 && occupant != p_agent) {
+		return false;
+	}
+
+	if (p_from == p_to) {
+		return true;
+	}
+
+	// Edge conflict: another agent crossing the other way at the same time.
+	const int crossing = _get_reservation(p_to, p_time);
+	return crossing == -1 || crossing == p_agent || _get_reservation(p_from, p_time + 1) != crossing;
+}
+
+void GridCooperativePlanner::_reserve(int p_agent, const GridVector<int> &p_path) {
+	for (uint32_t time = 0; time < p_path.size(); time++) {
+		const int cell = p_path[time];
+		reservations.insert(_make_key(cell, time), p_agent);
+		if (static_cast<int>(time) > last_reserved_times[cell]) {
+			last_reserved_times[cell] = time;
+		}
+	}
+
+	const int resting_cell = p_path[p_path.size() - 1];
+	const int resting_time = p_path.size() - 1;
+	if (resting_time < resting_times[resting_cell]) {
+		resting_times[resting_cell] = resting_time;
+	}
+}
+
+void GridCooperativePlanner::_open_push(int p_node, float p_f_score) {
+	OpenNode node;
+	node.f_score = p_f_score;
+	node.node = p_node;
+	open.push_back(node);
+
+	// Later nodes win ties so deeper states are expanded first.
+	int child = open.size() - 1;
+	while (child > 0) {
+		const int parent = (child - 1) / 2;
+		if (open[parent].f_score < open[child].f_score || (open[parent].f_score == open[child].f_score && open[parent].node > open[child].node)) {
+			break;
+		}
+		const OpenNode swap = open[parent];
+		open[parent] = open[child];
+		open[child] = swap;
+		child = parent;
+	}
+}
+
+int GridCooperativePlanner::_open_pop() {
+	const int node = open[0].node;
+	open[0] = open[open.size() - 1];
+	open.resize(open.size() - 1);
+
+	const int count = open.size();
+	int parent = 0;
+	while (true) {
+		const int left = parent * 2 + 1;
+		const int right = left + 1;
+		int smallest = parent;
+
+		if (left < count && (open[left].f_score < open[smallest].f_score || (open[left].f_score == open[smallest].f_score && open[left].node > open[smallest].node))) {
+			smallest = left;
+		}
+		if (right < count && (open[right].f_score < open[smallest].f_score || (open[right].f_score == open[smallest].f_score && open[right].node > open[smallest].node))) {
+			smallest = right;
+		}
+		if (smallest == parent) {
+			break;
+		}
+
+		const OpenNode swap = open[parent];
+		open[parent] = open[smallest];
+		open[smallest] = swap;
+		parent = smallest;
+	}
+
+	return node;
+}
+
+void GridCooperativePlanner::_compute_heuristic(int p_target) {
+	for (uint32_t cell = 0; cell < heuristic.size(); cell++) {
+		heuristic[cell] = -1.0f;
+	}
+
+	GridVector<int> sources;
+	sources.push_back(p_target);
+
+	GridVector<int> cells;
+	GridVector<float> costs;
+	GridVector<int> parents;
+	pathfinder->flood(sources, std::numeric_limits<float>::infinity(), true, cells, costs, parents);
+
+	for (uint32_t index = 0; index < cells.size(); index++) {
+		heuristic[cells[index]] = costs[index];
+	}
+}
+
+bool GridCooperativePlanner::_search(int p_agent, int p_start, int p_target, int p_max_time, GridVector<int> &r_path) {
+	r_path.clear();
+
+	if (!pathfinder->is_walkable(p_target) && p_target != p_start) {
+		return false;
+	}
+
+	_compute_heuristic(p_target);
+	if (heuristic[p_start] < 0.0f) {
+		return false; // Not reachable even without other agents.
+	}
+
+	nodes.clear();
+	open.clear();
+	visited.clear();
+
+	Node start_node;
+	start_node.cell = p_start;
+	nodes.push_back(start_node);
+	visited.insert(_make_key(p_start, 0), 0);
+	_open_push(0, heuristic[p_start]);
+
+	int neighbors[9];
+
+	while (!open.is_empty()) {
+		const int current = _open_pop();
+		const Node node = nodes[current];
+
+		// Stale heap entry.
+		const int *best = visited.getptr(_make_key(node.cell, node.time));
+		if (best && *best != current) {
+			continue;
+		}
+
+		// Resting on the target must not block agents planned earlier.
+		if (node.cell == p_target && node.time > last_reserved_times[p_target]) {
+			for (int index = current; index != -1; index = nodes[index].parent) {
+				r_path.push_back(nodes[index].cell);
+			}
+			r_path.invert();
+			return true;
+		}
+
+		if (node.time >= p_max_time) {
+			continue;
+		}
+
+		int neighbor_count = pathfinder->get_neighbors(node.cell, neighbors);
+		neighbors[neighbor_count++] = node.cell; // Wait.
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int next = neighbors[n];
+			const bool wait = next == node.cell;
+
+			if (!wait && !pathfinder->is_walkable(next)) {
+				continue;
+			}
+			if (heuristic[next] < 0.0f || !_is_free(p_agent, node.cell, next, node.time)) {
+				continue;
+			}
+
+			const float g_score = node.g_score + (wait ? WAIT_COST : pathfinder->get_step_cost(node.cell, next));
+			const uint64_t key = _make_key(next, node.time + 1);
+
+			const int *existing = visited.getptr(key);
+			if (existing && nodes[*existing].g_score <= g_score) {
+				continue;
+			}
+
+			Node next_node;
+			next_node.cell = next;
+			next_node.time = node.time + 1;
+			next_node.g_score = g_score;
+			next_node.parent = current;
+
+			const int next_index = nodes.size();
+			nodes.push_back(next_node);
+			visited.insert(key, next_index);
+			_open_push(next_index, g_score + heuristic[next]);
+		}
+	}
+
+	return false;
+}
+
+void GridCooperativePlanner::plan(GridPathfinder *p_pathfinder, const GridVector<int> &p_starts, const GridVector<int> &p_targets,
+		int p_max_time, GridVector<int> &r_paths, GridVector<int> &r_offsets) {
+	r_paths.clear();
+	r_offsets.clear();
+	r_offsets.push_back(0);
+
+	pathfinder = p_pathfinder;
+	size = pathfinder->get_size();
+
+	reservations.clear();
+	last_reserved_times.resize(size);
+	resting_times.resize(size);
+	start_owners.resize(size);
+	heuristic.resize(size);
+	for (int cell = 0; cell < size; cell++) {
+		last_reserved_times[cell] = -1;
+		resting_times[cell] = std::numeric_limits<int>::max();
+		start_owners[cell] = -1;
+	}
+
+	// Agents planned earlier route around the starts of the later ones, so
+	// a later agent that finds no path can stay where it is.
+	for (uint32_t agent = 0; agent < p_starts.size(); agent++) {
+		const int start = p_starts[agent];
+		if (start >= 0 && start < size && start_owners[start] == -1) {
+			start_owners[start] = agent;
+		}
+	}
+
+	GridVector<int> path;
+
+	for (uint32_t agent = 0; agent < p_starts.size(); agent++) {
+		const int start = p_starts[agent];
+		const int target = p_targets[agent];
+
+		const bool valid = start >= 0 && start < size && target >= 0 && target < size;
+
+		if (valid && _search(agent, start, target, p_max_time, path)) {
+			// The path holds the start from now on.
+			if (start_owners[start] == static_cast<int>(agent)) {
+				start_owners[start] = -1;
+			}
+			_reserve(agent, path);
+			for (const int &cell : path) {
+				r_paths.push_back(cell);
+			}
+		}
+		// Unplanned agents keep their start blocked for good.
+
+		r_offsets.push_back(r_paths.size());
+	}
+}
+
+uint64_t GridCooperativePlanner::get_memory_usage() const {
+	return grid_memory_usage(reservations) + grid_memory_usage(last_reserved_times) + grid_memory_usage(resting_times) + grid_memory_usage(start_owners) +
+			grid_memory_usage(heuristic) + grid_memory_usage(nodes) + grid_memory_usage(open) + grid_memory_usage(visited);
+}
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  grid_cooperative_planner.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+#include "grid_pathfinder.h"
+
+#include <cstdint>
+
+// Cooperative A*: agents are planned one after another with a space-time A*
+// that avoids the cells (and swaps) reserved by the agents planned before
+// them. Every move or wait takes one time step, so path i lists the cell of
+// agent i at each time step until it rests on its target.
+class GridCooperativePlanner {
+private:
+	struct Node {
+		int cell = -1;
+		int time = 0;
+		float g_score = 0.0f;
+		int parent = -1;
+	};
+
+	struct OpenNode {
+		float f_score = 0.0f;
+		int node = -1;
+	};
+
+	GridPathfinder *pathfinder = nullptr;
+	int size = 0;
+
+	// Space-time reservations: (time * size + cell) -> agent.
+	GridHashMap<uint64_t, int> reservations;
+	// Latest reserved time of each cell, and the time from which an agent
+	// rests on it for good.
+	GridVector<int> last_reserved_times;
+	GridVector<int> resting_times;
+	// Agent still standing on each cell before it is planned, or -1. Start
+	// cells stay blocked at every time until their agent gets its path.
+	GridVector<int> start_owners;
+
+	// Exact costs to the current target, used as the heuristic.
+	GridVector<float> heuristic;
+
+	// Space-time search scratch.
+	GridVector<Node> nodes;
+	GridVector<OpenNode> open;
+	GridHashMap<uint64_t, int> visited;
+
+	uint64_t _make_key(int p_cell, int p_time) const;
+	int _get_reservation(int p_cell, int p_time) const;
+	bool _is_free(int p_agent, int p_from, int p_to, int p_time) const;
+	void _reserve(int p_agent, const GridVector<int> &p_path);
+
+	void _open_push(int p_node, float p_f_score);
+	int _open_pop();
+
+	void _compute_heuristic(int p_target);
+	bool _search(int p_agent, int p_start, int p_target, int p_max_time, GridVector<int> &r_path);
+
+public:
+	// Agents are planned in order, empty paths mark agents without a
+	// conflict-free path within p_max_time steps. They stay on their start,
+	// which no other agent enters.
+	// Path i spans [r_offsets[i], r_offsets[i + 1]) of r_paths.
+	void plan(GridPathfinder *p_pathfinder, const GridVector<int> &p_starts, const GridVector<int> &p_targets,
+			int p_max_time, GridVector<int> &r_paths, GridVector<int> &r_offsets);
+
+	uint64_t get_memory_usage() const;
+};
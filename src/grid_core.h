@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  grid_core.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+// Containers of the grid core: the layout, topology and search classes
+// (grid_area, grid_field_of_view, grid_hierarchy, grid_pathfinder, ...)
+// only use these, so they build without godot-cpp when GRID_CORE_STANDALONE
+// is defined, for native benchmarks and profilers. Inside the extension they
+// are the godot-cpp containers, shared with InteractiveGrid3D as-is.
+
+#include <cstdint>
+
+#ifdef GRID_CORE_STANDALONE
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+// Subset of godot::LocalVector over std::vector.
+template <typename T>
+class GridVector {
+	std::vector<T> elements;
+
+public:
+	uint32_t size() const { return static_cast<uint32_t>(elements.size()); }
+	bool is_empty() const { return elements.empty(); }
+
+	void resize(uint32_t p_size) { elements.resize(p_size); }
+	void reserve(uint32_t p_size) { elements.reserve(p_size); }
+	void clear() { elements.clear(); }
+	void reset() {
+		elements.clear();
+		elements.shrink_to_fit();
+	}
+
+	void push_back(const T &p_element) { elements.push_back(p_element); }
+	void remove_at(uint32_t p_index) { elements.erase(elements.begin() + p_index); }
+	void remove_at_unordered(uint32_t p_index) {
+		elements[p_index] = elements.back();
+		elements.pop_back();
+	}
+	void invert() { std::reverse(elements.begin(), elements.end()); }
+
+	int64_t find(const T &p_element, uint32_t p_from = 0) const {
+		for (uint32_t i = p_from; i < elements.size(); i++) {
+			if (elements[i] == p_element) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	T *ptr() { return elements.data(); }
+	const T *ptr() const { return elements.data(); }
+
+	T &operator[](uint32_t p_index) { return elements[p_index]; }
+	const T &operator[](uint32_t p_index) const { return elements[p_index]; }
+
+	typename std::vector<T>::iterator begin() { return elements.begin(); }
+	typename std::vector<T>::iterator end() { return elements.end(); }
+	typename std::vector<T>::const_iterator begin() const { return elements.begin(); }
+	typename std::vector<T>::const_iterator end() const { return elements.end(); }
+};
+
+// Subset of godot::HashMap over std::unordered_map.
+template <typename TKey, typename TValue>
+class GridHashMap {
+	std::unordered_map<TKey, TValue> elements;
+
+public:
+	uint32_t size() const { return static_cast<uint32_t>(elements.size()); }
+	bool is_empty() const { return elements.empty(); }
+	void clear() { elements.clear(); }
+	void reserve(uint32_t p_size) { elements.reserve(p_size); }
+
+	bool has(const TKey &p_key) const { return elements.count(p_key) > 0; }
+	void insert(const TKey &p_key, const TValue &p_value) { elements[p_key] = p_value; }
+	bool erase(const TKey &p_key) { return elements.erase(p_key) > 0; }
+
+	TValue *getptr(const TKey &p_key) {
+		auto it = elements.find(p_key);
+		return it == elements.end() ? nullptr : &it->second;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		auto it = elements.find(p_key);
+		return it == elements.end() ? nullptr : &it->second;
+	}
+
+	TValue &operator[](const TKey &p_key) { return elements[p_key]; }
+};
+
+#else
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+template <typename T>
+using GridVector = godot::LocalVector<T>;
+
+template <typename TKey, typename TValue>
+using GridHashMap = godot::HashMap<TKey, TValue>;
+
+#endif
+
+// Bytes held by the elements of a container, used by the memory accounting.
+// Capacity slack and allocator overhead are not counted.
+template <typename T>
+inline uint64_t grid_memory_usage(const GridVector<T> &p_vector) {
+	return static_cast<uint64_t>(p_vector.size()) * sizeof(T);
+}
+
+// Hash maps also store a hash, a bucket pointer and two links per element.
+template <typename TKey, typename TValue>
+inline uint64_t grid_memory_usage(const GridHashMap<TKey, TValue> &p_map) {
+	return static_cast<uint64_t>(p_map.size()) * (sizeof(TKey) + sizeof(TValue) + sizeof(uint32_t) + 3 * sizeof(void *));
+}
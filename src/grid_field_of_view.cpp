@@ -0,0 +1,262 @@
+/**************************************************************************/
+/*  grid_field_of_view.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_field_of_view.h"
+
+#include "grid_hex.h"
+
+namespace {
+
+// Corner directions of the hexagonal sextants, in axial coordinates (q, r).
+const int hex_corners[6][2] = {
+	{ +1, 0 }, // East.
+	{ +1, -1 }, // North-East.
+	{ 0, -1 }, // North-West.
+	{ -1, 0 }, // West.
+	{ -1, +1 }, // South-West.
+	{ 0, +1 } // South-East.
+};
+
+// Octant transforms of the square layout.
+const int octant_transforms[8][4] = {
+	{ 1, 0, 0, 1 },
+	{ 0, 1, 1, 0 },
+	{ 0, -1, 1, 0 },
+	{ -1, 0, 0, 1 },
+	{ -1, 0, 0, -1 },
+	{ 0, -1, -1, 0 },
+	{ 0, 1, -1, 0 },
+	{ 1, 0, 0, -1 }
+};
+
+} // namespace
+
+void GridFieldOfView::resize(int p_columns, int p_rows) {
+	columns = p_columns;
+	rows = p_rows;
+
+	opaque.resize(columns * rows);
+	clear_opaque();
+
+	visible_bits.resize((columns * rows + 63) / 64);
+	for (uint32_t word = 0; word < visible_bits.size(); word++) {
+		visible_bits[word] = 0;
+	}
+}
+
+void GridFieldOfView::set_hexagonal(bool p_hexagonal) {
+	hexagonal = p_hexagonal;
+}
+
+void GridFieldOfView::set_opaque(int p_index, bool p_opaque) {
+	if (p_index < 0 || p_index >= static_cast<int>(opaque.size())) {
+		return;
+	}
+	opaque[p_index] = p_opaque ? 1 : 0;
+}
+
+bool GridFieldOfView::is_opaque(int p_index) const {
+	if (p_index < 0 || p_index >= static_cast<int>(opaque.size())) {
+		return false;
+	}
+	return opaque[p_index] != 0;
+}
+
+void GridFieldOfView::clear_opaque() {
+	for (uint32_t index = 0; index < opaque.size(); index++) {
+		opaque[index] = 0;
+	}
+}
+
+bool GridFieldOfView::_is_blocking(int p_column, int p_row) const {
+	// Light does not leave the grid.
+	if (p_column < 0 || p_column >= columns || p_row < 0 || p_row >= rows) {
+		return true;
+	}
+	return opaque[p_row * columns + p_column] != 0;
+}
+
+void GridFieldOfView::_mark_visible(int p_column, int p_row, GridVector<int> &r_cells) {
+	if (p_column < 0 || p_column >= columns || p_row < 0 || p_row >= rows) {
+		return;
+	}
+
+	const int index = p_row * columns + p_column;
+	const uint64_t bit = uint64_t(1) << (index & 63);
+
+	if (!(visible_bits[index >> 6] & bit)) {
+		visible_bits[index >> 6] |= bit;
+		r_cells.push_back(index);
+	}
+}
+
+void GridFieldOfView::_cast_octant(int p_column, int p_row, int p_radius, int p_depth, float p_start, float p_end,
+		int p_xx, int p_xy, int p_yx, int p_yy, GridVector<int> &r_cells) {
+	if (p_start < p_end) {
+		return;
+	}
+
+	const int radius_squared = p_radius * p_radius;
+	float next_start = p_start;
+
+	for (int depth = p_depth; depth <= p_radius; depth++) {
+		bool blocked = false;
+
+		// Cells of the row, from the octant edge towards its diagonal.
+		for (int dx = -depth; dx <= 0; dx++) {
+			const int dy = -depth;
+			const float left_slope = (dx - 0.5f) / (dy + 0.5f);
+			const float right_slope = (dx + 0.5f) / (dy - 0.5f);
+
+			if (p_start < right_slope) {
+				continue;
+			}
+			if (p_end > left_slope) {
+				break;
+			}
+
+			const int column = p_column + dx * p_xx + dy * p_xy;
+			const int row = p_row + dx * p_yx + dy * p_yy;
+
+			if (dx * dx + dy * dy <= radius_squared) {
+				_mark_visible(column, row, r_cells);
+			}
+
+			const bool blocking = _is_blocking(column, row);
+
+			if (blocked) {
+				if (blocking) {
+					next_start = right_slope;
+					continue;
+				}
+				blocked = false;
+				p_start = next_start;
+			} else if (blocking && depth < p_radius) {
+				// Light above the blocker goes on in a child scan.
+				blocked = true;
+				_cast_octant(p_column, p_row, p_radius, depth + 1, p_start, left_slope, p_xx, p_xy, p_yx, p_yy, r_cells);
+				next_start = right_slope;
+			}
+		}
+
+		if (blocked) {
+			break;
+		}
+	}
+}
+
+void GridFieldOfView::_cast_sextant(int p_q, int p_r, int p_radius, int p_sextant, int p_depth, float p_start, float p_end,
+		GridVector<int> &r_cells) {
+	if (p_start >= p_end) {
+		return;
+	}
+
+	const int *corner = hex_corners[p_sextant];
+	const int *next_corner = hex_corners[(p_sextant + 1) % 6];
+	const int step_q = next_corner[0] - corner[0];
+	const int step_r = next_corner[1] - corner[1];
+
+	float next_start = p_start;
+
+	// Each ring side is a straight row of depth + 1 cells between two corners,
+	// a cell covering the [(i - 0.5) / depth, (i + 0.5) / depth] share of it.
+	for (int depth = p_depth; depth <= p_radius; depth++) {
+		bool blocked = false;
+
+		for (int i = 0; i <= depth; i++) {
+			const float low_slope = (i - 0.5f) / depth;
+			const float high_slope = (i + 0.5f) / depth;
+
+			if (high_slope <= p_start) {
+				continue;
+			}
+			if (low_slope >= p_end) {
+				break;
+			}
+
+			const int q = p_q + corner[0] * depth + step_q * i;
+			const int r = p_r + corner[1] * depth + step_r * i;
+			const int column = hex_axial_to_offset_column(q, r);
+
+			_mark_visible(column, r, r_cells);
+
+			const bool blocking = _is_blocking(column, r);
+
+			if (blocked) {
+				if (blocking) {
+					next_start = high_slope;
+					continue;
+				}
+				blocked = false;
+				p_start = next_start;
+			} else if (blocking && depth < p_radius) {
+				blocked = true;
+				_cast_sextant(p_q, p_r, p_radius, p_sextant, depth + 1, p_start, low_slope, r_cells);
+				next_start = high_slope;
+			}
+		}
+
+		if (blocked) {
+			break;
+		}
+	}
+}
+
+void GridFieldOfView::compute(int p_origin, int p_radius, GridVector<int> &r_cells) {
+	r_cells.clear();
+
+	if (p_origin < 0 || p_origin >= columns * rows || p_radius < 0) {
+		return;
+	}
+
+	const int column = p_origin % columns;
+	const int row = p_origin / columns;
+
+	_mark_visible(column, row, r_cells);
+
+	if (hexagonal) {
+		const int q = hex_offset_to_axial_q(column, row);
+		for (int sextant = 0; sextant < 6; sextant++) {
+			_cast_sextant(q, row, p_radius, sextant, 1, 0.0f, 1.0f, r_cells);
+		}
+	} else {
+		for (int octant = 0; octant < 8; octant++) {
+			const int *transform = octant_transforms[octant];
+			_cast_octant(column, row, p_radius, 1, 1.0f, 0.0f, transform[0], transform[1], transform[2], transform[3], r_cells);
+		}
+	}
+
+	for (const int &index : r_cells) {
+		visible_bits[index >> 6] &= ~(uint64_t(1) << (index & 63));
+	}
+}
+
+uint64_t GridFieldOfView::get_memory_usage() const {
+	return grid_memory_usage(opaque) + grid_memory_usage(visible_bits);
+}
@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  grid_field_of_view.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+
+#include <cstdint>
+
+// Field of view by recursive shadowcasting over an opacity mask, on the
+// square layout (eight octants) or the hexagonal layout (six sextants of
+// rings, odd rows shifted right).
+class GridFieldOfView {
+private:
+	int columns = 0;
+	int rows = 0;
+	bool hexagonal = false;
+
+	GridVector<uint8_t> opaque;
+
+	// Cells marked during the current computation, one bit each.
+	GridVector<uint64_t> visible_bits;
+
+	bool _is_blocking(int p_column, int p_row) const;
+	void _mark_visible(int p_column, int p_row, GridVector<int> &r_cells);
+
+	void _cast_octant(int p_column, int p_row, int p_radius, int p_depth, float p_start, float p_end,
+			int p_xx, int p_xy, int p_yx, int p_yy, GridVector<int> &r_cells);
+	void _cast_sextant(int p_q, int p_r, int p_radius, int p_sextant, int p_depth, float p_start, float p_end,
+			GridVector<int> &r_cells);
+
+public:
+	void resize(int p_columns, int p_rows);
+	void set_hexagonal(bool p_hexagonal);
+
+	void set_opaque(int p_index, bool p_opaque);
+	bool is_opaque(int p_index) const;
+	void clear_opaque();
+
+	// Cells visible from p_origin within p_radius cells (Euclidean on the
+	// square layout, hex distance on the hexagonal one), the origin first.
+	// Opaque cells are visible but hide what lies behind them.
+	void compute(int p_origin, int p_radius, GridVector<int> &r_cells);
+
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*  grid_flow_field.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_flow_field.h"
+
+void GridFlowField::setup(int p_target_cell_index, const godot::PackedFloat32Array &p_distances, const godot::PackedInt32Array &p_next_cells) {
+	target_cell_index = p_target_cell_index;
+	distances = p_distances;
+	next_cells = p_next_cells;
+	valid = true;
+}
+
+void GridFlowField::invalidate() {
+	valid = false;
+}
+
+int GridFlowField::get_target_cell() const {
+	return target_cell_index;
+}
+
+bool GridFlowField::is_valid() const {
+	return valid;
+}
+
+bool GridFlowField::is_cell_reachable(int p_cell_index) const {
+	if (p_cell_index < 0 || p_cell_index >= distances.size()) {
+		return false;
+	}
+	return distances[p_cell_index] >= 0.0f;
+}
+
+float GridFlowField::get_distance(int p_cell_index) const {
+	if (p_cell_index < 0 || p_cell_index >= distances.size()) {
+		return -1.0f;
+	}
+	return distances[p_cell_index];
+}
+
+int GridFlowField::get_next_cell(int p_cell_index) const {
+	if (p_cell_index < 0 || p_cell_index >= next_cells.size()) {
+		return -1;
+	}
+	return next_cells[p_cell_index];
+}
+
+godot::PackedFloat32Array GridFlowField::get_distances() const {
+	return distances;
+}
+
+godot::PackedInt32Array GridFlowField::get_next_cells() const {
+	return next_cells;
+}
+
+uint64_t GridFlowField::get_memory_usage() const {
+	return distances.size() * sizeof(float) + next_cells.size() * sizeof(int32_t);
+}
+
+void GridFlowField::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("get_target_cell"), &GridFlowField::get_target_cell);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_valid"), &GridFlowField::is_valid);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_reachable", "cell_index"), &GridFlowField::is_cell_reachable);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_distance", "cell_index"), &GridFlowField::get_distance);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_next_cell", "cell_index"), &GridFlowField::get_next_cell);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_distances"), &GridFlowField::get_distances);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_next_cells"), &GridFlowField::get_next_cells);
+}
+
+GridFlowField::GridFlowField() {}
+
+GridFlowField::~GridFlowField() {}
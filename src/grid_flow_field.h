@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  grid_flow_field.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+// Integration field and next step of every cell towards one target cell,
+// shared by all the units heading there.
+class GridFlowField : public godot::RefCounted {
+	GDCLASS(GridFlowField, RefCounted);
+
+private:
+	int target_cell_index = -1;
+	bool valid = false;
+
+	// Cost to reach the target from each cell (-1 when unreachable).
+	godot::PackedFloat32Array distances;
+	// Next cell towards the target (-1 on the target or when unreachable).
+	godot::PackedInt32Array next_cells;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void setup(int p_target_cell_index, const godot::PackedFloat32Array &p_distances, const godot::PackedInt32Array &p_next_cells);
+	void invalidate();
+
+	int get_target_cell() const;
+	bool is_valid() const;
+
+	bool is_cell_reachable(int p_cell_index) const;
+	float get_distance(int p_cell_index) const;
+	int get_next_cell(int p_cell_index) const;
+
+	godot::PackedFloat32Array get_distances() const;
+	godot::PackedInt32Array get_next_cells() const;
+
+	uint64_t get_memory_usage() const;
+
+	GridFlowField();
+	~GridFlowField();
+};
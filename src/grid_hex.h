@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*  grid_hex.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+
+// Hexagonal grid coordinates. Cells are stored in offset coordinates
+// (column, row) with the odd rows shifted right. Axial coordinates (q, r)
+// share the row, and cube coordinates add s = -q - r.
+// See: Patel, A. J. (2013). Hexagonal grids.
+
+inline int hex_offset_to_axial_q(int p_column, int p_row) {
+	return p_column - (p_row - (p_row & 1)) / 2;
+}
+
+inline int hex_axial_to_offset_column(int p_q, int p_r) {
+	return p_q + (p_r - (p_r & 1)) / 2;
+}
+
+// Number of steps between two hexes, from their axial coordinates.
+inline int hex_axial_distance(int p_q0, int p_r0, int p_q1, int p_r1) {
+	const int dq = p_q1 - p_q0;
+	const int dr = p_r1 - p_r0;
+	return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+inline int hex_offset_distance(int p_column0, int p_row0, int p_column1, int p_row1) {
+	return hex_axial_distance(hex_offset_to_axial_q(p_column0, p_row0), p_row0, hex_offset_to_axial_q(p_column1, p_row1), p_row1);
+}
+
+// Rounds fractional axial coordinates to the hex that contains them.
+inline void hex_axial_round(float p_q, float p_r, int &r_q, int &r_r) {
+	const float s = -p_q - p_r;
+
+	int q = static_cast<int>(std::round(p_q));
+	int r = static_cast<int>(std::round(p_r));
+	const int rounded_s = static_cast<int>(std::round(s));
+
+	const float q_diff = std::abs(q - p_q);
+	const float r_diff = std::abs(r - p_r);
+	const float s_diff = std::abs(rounded_s - s);
+
+	if (q_diff > r_diff && q_diff > s_diff) {
+		q = -r - rounded_s;
+	} else if (r_diff > s_diff) {
+		r = -q - rounded_s;
+	}
+
+	r_q = q;
+	r_r = r;
+}
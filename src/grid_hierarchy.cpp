@@ -0,0 +1,633 @@
+/**************************************************************************/
+/*  grid_hierarchy.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_hierarchy.h"
+
+#include <algorithm>
+#include <limits>
+
+static constexpr float INFINITE_COST = std::numeric_limits<float>::max();
+
+// Entrances spanning at least this many border edges get one transition at
+// each end instead of a single one in the middle.
+static constexpr int LONG_ENTRANCE_LENGTH = 6;
+
+void GridHierarchy::_open_push(GridVector<OpenNode> &r_open, int p_index, float p_f_score) {
+	OpenNode node;
+	node.f_score = p_f_score;
+	node.index = p_index;
+
+	uint32_t child = r_open.size();
+	r_open.push_back(node);
+
+	while (child > 0) {
+		const uint32_t parent = (child - 1) / 2;
+		if (r_open[parent].f_score <= r_open[child].f_score) {
+			break;
+		}
+		const OpenNode swap = r_open[parent];
+		r_open[parent] = r_open[child];
+		r_open[child] = swap;
+		child = parent;
+	}
+}
+
+int GridHierarchy::_open_pop(GridVector<OpenNode> &r_open) {
+	const int index = r_open[0].index;
+	const uint32_t last = r_open.size() - 1;
+	r_open[0] = r_open[last];
+	r_open.resize(last);
+
+	uint32_t parent = 0;
+	while (true) {
+		const uint32_t left = parent * 2 + 1;
+		const uint32_t right = left + 1;
+		uint32_t smallest = parent;
+
+		if (left < last && r_open[left].f_score < r_open[smallest].f_score) {
+			smallest = left;
+		}
+		if (right < last && r_open[right].f_score < r_open[smallest].f_score) {
+			smallest = right;
+		}
+		if (smallest == parent) {
+			break;
+		}
+
+		const OpenNode swap = r_open[parent];
+		r_open[parent] = r_open[smallest];
+		r_open[smallest] = swap;
+		parent = smallest;
+	}
+
+	return index;
+}
+
+int GridHierarchy::_get_cluster(int p_index) const {
+	const int columns = pathfinder->get_columns();
+	return (p_index / columns / cluster_size) * clusters_x + (p_index % columns) / cluster_size;
+}
+
+bool GridHierarchy::_is_in_cluster(const Cluster &p_cluster, int p_index) const {
+	const int columns = pathfinder->get_columns();
+	const int x = p_index % columns;
+	const int y = p_index / columns;
+	return x >= p_cluster.x && x < p_cluster.x + p_cluster.width && y >= p_cluster.y && y < p_cluster.y + p_cluster.height;
+}
+
+int GridHierarchy::_to_local(const Cluster &p_cluster, int p_index) const {
+	const int columns = pathfinder->get_columns();
+	return (p_index / columns - p_cluster.y) * p_cluster.width + (p_index % columns - p_cluster.x);
+}
+
+int GridHierarchy::_to_cell(const Cluster &p_cluster, int p_local) const {
+	return (p_cluster.y + p_local / p_cluster.width) * pathfinder->get_columns() + p_cluster.x + p_local % p_cluster.width;
+}
+
+bool GridHierarchy::_are_adjacent(int p_a, int p_b) const {
+	int neighbors[8];
+	const int neighbor_count = pathfinder->get_neighbors(p_a, neighbors);
+
+	for (int n = 0; n < neighbor_count; n++) {
+		if (neighbors[n] == p_b) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GridHierarchy::_build_border(int p_cluster_a, int p_cluster_b, GridVector<Transition> &r_transitions) const {
+	// Built from the lowest cluster so both sides pick the same transitions.
+	const int low = std::min(p_cluster_a, p_cluster_b);
+	const int high = std::max(p_cluster_a, p_cluster_b);
+	const Cluster &cluster = clusters[low];
+	const int columns = pathfinder->get_columns();
+
+	GridVector<Transition> edges;
+	int neighbors[8];
+
+	for (int local_y = 0; local_y < cluster.height; local_y++) {
+		const bool is_border_row = local_y == 0 || local_y == cluster.height - 1;
+		const int step = is_border_row ? 1 : std::max(cluster.width - 1, 1);
+
+		for (int local_x = 0; local_x < cluster.width; local_x += step) {
+			const int cell = (cluster.y + local_y) * columns + cluster.x + local_x;
+			if (!pathfinder->is_walkable(cell)) {
+				continue;
+			}
+
+			const int neighbor_count = pathfinder->get_neighbors(cell, neighbors);
+			for (int n = 0; n < neighbor_count; n++) {
+				if (_get_cluster(neighbors[n]) == high && pathfinder->is_walkable(neighbors[n])) {
+					Transition edge;
+					edge.cell = cell;
+					edge.other_cell = neighbors[n];
+					edges.push_back(edge);
+				}
+			}
+		}
+	}
+
+	if (edges.is_empty()) {
+		return;
+	}
+
+	std::sort(edges.ptr(), edges.ptr() + edges.size(), [](const Transition &p_a, const Transition &p_b) {
+		return p_a.cell < p_b.cell || (p_a.cell == p_b.cell && p_a.other_cell < p_b.other_cell);
+	});
+
+	// Consecutive edges whose cells touch on both sides form one entrance:
+	// every edge of an entrance is connected to its transitions within both clusters.
+	uint32_t begin = 0;
+	for (uint32_t end = 1; end <= edges.size(); end++) {
+		if (end < edges.size()) {
+			const Transition &previous = edges[end - 1];
+			const Transition &current = edges[end];
+			const bool same_entrance = (previous.cell == current.cell || _are_adjacent(previous.cell, current.cell)) &&
+					(previous.other_cell == current.other_cell || _are_adjacent(previous.other_cell, current.other_cell));
+			if (same_entrance) {
+				continue;
+			}
+		}
+
+		const int length = end - begin;
+		uint32_t picks[2] = { begin + length / 2, begin + length / 2 };
+		if (length >= LONG_ENTRANCE_LENGTH) {
+			picks[0] = begin;
+			picks[1] = end - 1;
+		}
+
+		for (int pick = 0; pick < (picks[0] == picks[1] ? 1 : 2); pick++) {
+			Transition transition;
+			if (p_cluster_a == low) {
+				transition = edges[picks[pick]];
+			} else {
+				transition.cell = edges[picks[pick]].other_cell;
+				transition.other_cell = edges[picks[pick]].cell;
+			}
+			r_transitions.push_back(transition);
+		}
+
+		begin = end;
+	}
+}
+
+void GridHierarchy::_build_transitions(int p_cluster) {
+	Cluster &cluster = clusters[p_cluster];
+	cluster.transitions.clear();
+	cluster.entrances.clear();
+
+	const int cluster_x = p_cluster % clusters_x;
+	const int cluster_y = p_cluster / clusters_x;
+
+	for (int dy = -1; dy <= 1; dy++) {
+		for (int dx = -1; dx <= 1; dx++) {
+			const int other_x = cluster_x + dx;
+			const int other_y = cluster_y + dy;
+
+			if ((dx == 0 && dy == 0) || other_x < 0 || other_x >= clusters_x || other_y < 0 || other_y >= clusters_y) {
+				continue;
+			}
+
+			_build_border(p_cluster, other_y * clusters_x + other_x, cluster.transitions);
+		}
+	}
+
+	for (const Transition &transition : cluster.transitions) {
+		cluster.entrances.push_back(transition.cell);
+	}
+
+	std::sort(cluster.entrances.ptr(), cluster.entrances.ptr() + cluster.entrances.size());
+	const int *unique_end = std::unique(cluster.entrances.ptr(), cluster.entrances.ptr() + cluster.entrances.size());
+	cluster.entrances.resize(unique_end - cluster.entrances.ptr());
+}
+
+void GridHierarchy::_build_distances(int p_cluster) {
+	const uint32_t entrance_count = clusters[p_cluster].entrances.size();
+	clusters[p_cluster].distances.resize(entrance_count * entrance_count);
+
+	for (uint32_t from = 0; from < entrance_count; from++) {
+		_search_cluster(segment_search, p_cluster, clusters[p_cluster].entrances[from], -1, false);
+
+		for (uint32_t to = 0; to < entrance_count; to++) {
+			const int local = _to_local(clusters[p_cluster], clusters[p_cluster].entrances[to]);
+			clusters[p_cluster].distances[from * entrance_count + to] = segment_search.closed[local] ? segment_search.g_scores[local] : -1.0f;
+		}
+	}
+}
+
+void GridHierarchy::_search_cluster(LocalSearch &r_search, int p_cluster, int p_source, int p_target, bool p_reverse) {
+	const Cluster &cluster = clusters[p_cluster];
+	const uint32_t size = cluster.width * cluster.height;
+
+	r_search.cluster = p_cluster;
+	r_search.g_scores.resize(size);
+	r_search.parents.resize(size);
+	r_search.closed.resize(size);
+	for (uint32_t local = 0; local < size; local++) {
+		r_search.g_scores[local] = INFINITE_COST;
+		r_search.parents[local] = -1;
+		r_search.closed[local] = 0;
+	}
+	r_search.open.clear();
+
+	const int source = _to_local(cluster, p_source);
+	const int target = p_target >= 0 ? _to_local(cluster, p_target) : -1;
+
+	r_search.g_scores[source] = 0.0f;
+	_open_push(r_search.open, source, p_target >= 0 ? pathfinder->estimate_cost(p_source, p_target) : 0.0f);
+
+	int neighbors[8];
+
+	while (!r_search.open.is_empty()) {
+		const int current = _open_pop(r_search.open);
+
+		if (r_search.closed[current]) {
+			continue;
+		}
+		r_search.closed[current] = 1;
+
+		if (current == target) {
+			break;
+		}
+
+		const int cell = _to_cell(cluster, current);
+		const int neighbor_count = pathfinder->get_neighbors(cell, neighbors);
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int neighbor_cell = neighbors[n];
+			if (!_is_in_cluster(cluster, neighbor_cell) || !pathfinder->is_walkable(neighbor_cell)) {
+				continue;
+			}
+
+			const int neighbor = _to_local(cluster, neighbor_cell);
+			if (r_search.closed[neighbor]) {
+				continue;
+			}
+
+			const float step_cost = p_reverse ? pathfinder->get_step_cost(neighbor_cell, cell) : pathfinder->get_step_cost(cell, neighbor_cell);
+			const float g_score = r_search.g_scores[current] + step_cost;
+			if (g_score < r_search.g_scores[neighbor]) {
+				r_search.g_scores[neighbor] = g_score;
+				r_search.parents[neighbor] = current;
+				_open_push(r_search.open, neighbor, g_score + (p_target >= 0 ? pathfinder->estimate_cost(neighbor_cell, p_target) : 0.0f));
+			}
+		}
+	}
+}
+
+int GridHierarchy::_find_node(int p_cluster, int p_cell) const {
+	const Cluster &cluster = clusters[p_cluster];
+	const int *begin = cluster.entrances.ptr();
+	const int *end = begin + cluster.entrances.size();
+	const int *found = std::lower_bound(begin, end, p_cell);
+
+	if (found == end || *found != p_cell) {
+		return -1;
+	}
+	return cluster.node_offset + static_cast<int>(found - begin);
+}
+
+void GridHierarchy::_touch_node(int p_node) {
+	if (node_stamps[p_node] != node_stamp) {
+		node_stamps[p_node] = node_stamp;
+		node_g_scores[p_node] = INFINITE_COST;
+		node_parents[p_node] = -1;
+		node_closed[p_node] = 0;
+	}
+}
+
+void GridHierarchy::setup(const GridPathfinder *p_pathfinder, int p_cluster_size) {
+	pathfinder = p_pathfinder;
+	cluster_size = std::max(p_cluster_size, 2);
+
+	const int columns = pathfinder->get_columns();
+	const int rows = pathfinder->get_rows();
+
+	clusters_x = (columns + cluster_size - 1) / cluster_size;
+	clusters_y = (rows + cluster_size - 1) / cluster_size;
+
+	clusters.clear();
+	clusters.resize(clusters_x * clusters_y);
+
+	for (int cluster_y = 0; cluster_y < clusters_y; cluster_y++) {
+		for (int cluster_x = 0; cluster_x < clusters_x; cluster_x++) {
+			Cluster &cluster = clusters[cluster_y * clusters_x + cluster_x];
+			cluster.x = cluster_x * cluster_size;
+			cluster.y = cluster_y * cluster_size;
+			cluster.width = std::min(cluster_size, columns - cluster.x);
+			cluster.height = std::min(cluster_size, rows - cluster.y);
+			cluster.dirty = true;
+		}
+	}
+
+	node_count = 0;
+	node_clusters.clear();
+	has_dirty_clusters = true;
+}
+
+int GridHierarchy::get_cluster_size() const {
+	return cluster_size;
+}
+
+void GridHierarchy::mark_cell_dirty(int p_index) {
+	if (clusters.is_empty() || p_index < 0 || p_index >= pathfinder->get_size()) {
+		return;
+	}
+
+	const int cluster = _get_cluster(p_index);
+	clusters[cluster].dirty = true;
+
+	// Cells on a border also change the entrances of the clusters across it.
+	int neighbors[8];
+	const int neighbor_count = pathfinder->get_neighbors(p_index, neighbors);
+	for (int n = 0; n < neighbor_count; n++) {
+		clusters[_get_cluster(neighbors[n])].dirty = true;
+	}
+
+	has_dirty_clusters = true;
+}
+
+void GridHierarchy::update() {
+	if (!has_dirty_clusters) {
+		return;
+	}
+
+	// Entrances first: the distances of a cluster are computed between its entrances.
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++) {
+		if (clusters[cluster].dirty) {
+			_build_transitions(cluster);
+		}
+	}
+
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++) {
+		if (clusters[cluster].dirty) {
+			_build_distances(cluster);
+			clusters[cluster].dirty = false;
+		}
+	}
+
+	node_count = 0;
+	for (Cluster &cluster : clusters) {
+		cluster.node_offset = node_count;
+		node_count += cluster.entrances.size();
+	}
+
+	node_clusters.resize(node_count);
+	for (uint32_t cluster = 0; cluster < clusters.size(); cluster++) {
+		for (uint32_t entrance = 0; entrance < clusters[cluster].entrances.size(); entrance++) {
+			node_clusters[clusters[cluster].node_offset + entrance] = cluster;
+		}
+	}
+
+	has_dirty_clusters = false;
+}
+
+bool GridHierarchy::find_path(int p_from, int p_to, GridVector<int> &r_path) {
+	r_path.clear();
+
+	if (pathfinder == nullptr || clusters.is_empty()) {
+		return false;
+	}
+
+	if (p_from < 0 || p_from >= pathfinder->get_size() || p_to < 0 || p_to >= pathfinder->get_size()) {
+		return false;
+	}
+
+	if (!pathfinder->is_walkable(p_to)) {
+		return false;
+	}
+
+	if (p_from == p_to) {
+		r_path.push_back(p_from);
+		return true;
+	}
+
+	update();
+
+	const int start_cluster = _get_cluster(p_from);
+	const int target_cluster = _get_cluster(p_to);
+
+	// Costs from the start to its cluster entrances, and from the target
+	// cluster entrances to the target.
+	_search_cluster(start_search, start_cluster, p_from, -1, false);
+	_search_cluster(target_search, target_cluster, p_to, -1, true);
+
+	// Abstract search over the entrances, the last slot being the target.
+	const int goal = node_count;
+	const uint32_t slot_count = node_count + 1;
+	if (node_stamps.size() != slot_count) {
+		node_stamps.resize(slot_count);
+		node_g_scores.resize(slot_count);
+		node_parents.resize(slot_count);
+		node_closed.resize(slot_count);
+		for (uint32_t slot = 0; slot < slot_count; slot++) {
+			node_stamps[slot] = 0;
+		}
+		node_stamp = 0;
+	}
+
+	node_stamp++;
+	if (node_stamp == 0) {
+		for (uint32_t slot = 0; slot < slot_count; slot++) {
+			node_stamps[slot] = 0;
+		}
+		node_stamp = 1;
+	}
+	node_open.clear();
+
+	if (start_cluster == target_cluster) {
+		const int local = _to_local(clusters[start_cluster], p_to);
+		if (start_search.closed[local]) {
+			_touch_node(goal);
+			node_g_scores[goal] = start_search.g_scores[local];
+			_open_push(node_open, goal, node_g_scores[goal]);
+		}
+	}
+
+	const Cluster &first_cluster = clusters[start_cluster];
+	for (uint32_t entrance = 0; entrance < first_cluster.entrances.size(); entrance++) {
+		const int cell = first_cluster.entrances[entrance];
+		const int local = _to_local(first_cluster, cell);
+		if (!start_search.closed[local]) {
+			continue;
+		}
+
+		const int node = first_cluster.node_offset + entrance;
+		_touch_node(node);
+		node_g_scores[node] = start_search.g_scores[local];
+		_open_push(node_open, node, node_g_scores[node] + pathfinder->estimate_cost(cell, p_to));
+	}
+
+	while (!node_open.is_empty()) {
+		const int current = _open_pop(node_open);
+
+		if (node_closed[current]) {
+			continue;
+		}
+		node_closed[current] = 1;
+
+		if (current == goal) {
+			break;
+		}
+
+		const int cluster_index = node_clusters[current];
+		const Cluster &cluster = clusters[cluster_index];
+		const uint32_t entrance = current - cluster.node_offset;
+		const uint32_t entrance_count = cluster.entrances.size();
+		const int cell = cluster.entrances[entrance];
+		const float g_score = node_g_scores[current];
+
+		if (cluster_index == target_cluster) {
+			const int local = _to_local(cluster, cell);
+			if (target_search.closed[local]) {
+				_touch_node(goal);
+				const float goal_score = g_score + target_search.g_scores[local];
+				if (goal_score < node_g_scores[goal]) {
+					node_g_scores[goal] = goal_score;
+					node_parents[goal] = current;
+					_open_push(node_open, goal, goal_score);
+				}
+			}
+		}
+
+		for (uint32_t other = 0; other < entrance_count; other++) {
+			const float distance = cluster.distances[entrance * entrance_count + other];
+			if (other == entrance || distance < 0.0f) {
+				continue;
+			}
+
+			const int node = cluster.node_offset + other;
+			_touch_node(node);
+			if (node_closed[node]) {
+				continue;
+			}
+
+			if (g_score + distance < node_g_scores[node]) {
+				node_g_scores[node] = g_score + distance;
+				node_parents[node] = current;
+				_open_push(node_open, node, node_g_scores[node] + pathfinder->estimate_cost(cluster.entrances[other], p_to));
+			}
+		}
+
+		for (const Transition &transition : cluster.transitions) {
+			if (transition.cell != cell) {
+				continue;
+			}
+
+			const int node = _find_node(_get_cluster(transition.other_cell), transition.other_cell);
+			if (node < 0) {
+				continue;
+			}
+
+			_touch_node(node);
+			if (node_closed[node]) {
+				continue;
+			}
+
+			const float step_score = g_score + pathfinder->get_step_cost(cell, transition.other_cell);
+			if (step_score < node_g_scores[node]) {
+				node_g_scores[node] = step_score;
+				node_parents[node] = current;
+				_open_push(node_open, node, step_score + pathfinder->estimate_cost(transition.other_cell, p_to));
+			}
+		}
+	}
+
+	if (node_stamps[goal] != node_stamp || !node_closed[goal]) {
+		return false;
+	}
+
+	GridVector<int> nodes;
+	for (int node = node_parents[goal]; node != -1; node = node_parents[node]) {
+		nodes.push_back(clusters[node_clusters[node]].entrances[node - clusters[node_clusters[node]].node_offset]);
+	}
+	nodes.invert();
+
+	// Refinement: start cluster, then every segment between entrances, then target cluster.
+	const int first_cell = nodes.is_empty() ? p_to : nodes[0];
+	for (int local = _to_local(first_cluster, first_cell); local != -1; local = start_search.parents[local]) {
+		r_path.push_back(_to_cell(first_cluster, local));
+	}
+	r_path.invert();
+
+	if (nodes.is_empty()) {
+		return true;
+	}
+
+	for (uint32_t segment = 1; segment < nodes.size(); segment++) {
+		const int from_cell = nodes[segment - 1];
+		const int to_cell = nodes[segment];
+		const int cluster_index = _get_cluster(from_cell);
+
+		if (cluster_index != _get_cluster(to_cell)) {
+			r_path.push_back(to_cell);
+			continue;
+		}
+
+		const Cluster &cluster = clusters[cluster_index];
+		_search_cluster(segment_search, cluster_index, from_cell, to_cell, false);
+
+		const uint32_t segment_start = r_path.size();
+		for (int local = _to_local(cluster, to_cell); segment_search.parents[local] != -1; local = segment_search.parents[local]) {
+			r_path.push_back(_to_cell(cluster, local));
+		}
+
+		uint32_t left = segment_start;
+		uint32_t right = r_path.size() - 1;
+		while (left < right) {
+			const int swap = r_path[left];
+			r_path[left++] = r_path[right];
+			r_path[right--] = swap;
+		}
+	}
+
+	const Cluster &last_cluster = clusters[target_cluster];
+	for (int local = target_search.parents[_to_local(last_cluster, nodes[nodes.size() - 1])]; local != -1; local = target_search.parents[local]) {
+		r_path.push_back(_to_cell(last_cluster, local));
+	}
+
+	return true;
+}
+
+uint64_t GridHierarchy::get_memory_usage() const {
+	uint64_t bytes = grid_memory_usage(clusters) + grid_memory_usage(node_clusters);
+
+	for (const Cluster &cluster : clusters) {
+		bytes += grid_memory_usage(cluster.transitions) + grid_memory_usage(cluster.entrances) + grid_memory_usage(cluster.distances);
+	}
+
+	for (const LocalSearch *search : { &start_search, &target_search, &segment_search }) {
+		bytes += grid_memory_usage(search->g_scores) + grid_memory_usage(search->parents) +
+				grid_memory_usage(search->closed) + grid_memory_usage(search->open);
+	}
+
+	return bytes + grid_memory_usage(node_stamps) + grid_memory_usage(node_g_scores) + grid_memory_usage(node_parents) +
+			grid_memory_usage(node_closed) + grid_memory_usage(node_open);
+}
@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  grid_hierarchy.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+#include "grid_pathfinder.h"
+
+#include <cstdint>
+
+// HPA*: the grid is split into square clusters linked by entrances on their
+// borders. Paths are first searched on the small graph of entrances, then
+// refined cell by cell inside the clusters they cross.
+class GridHierarchy {
+	struct Transition {
+		int cell = -1; // Entrance cell inside the cluster.
+		int other_cell = -1; // Adjacent entrance cell in the neighbor cluster.
+	};
+
+	struct Cluster {
+		int x = 0;
+		int y = 0;
+		int width = 0;
+		int height = 0;
+		bool dirty = true;
+		int node_offset = 0;
+		GridVector<Transition> transitions;
+		GridVector<int> entrances; // Sorted cell indices.
+		GridVector<float> distances; // entrances x entrances, -1 when unreachable.
+	};
+
+	struct OpenNode {
+		float f_score = 0.0f;
+		int index = -1;
+	};
+
+	// Search restricted to one cluster, indexed in cluster-local coordinates.
+	struct LocalSearch {
+		int cluster = -1;
+		GridVector<float> g_scores;
+		GridVector<int> parents;
+		GridVector<uint8_t> closed;
+		GridVector<OpenNode> open;
+	};
+
+	const GridPathfinder *pathfinder = nullptr;
+	int cluster_size = 16;
+	int clusters_x = 0;
+	int clusters_y = 0;
+	bool has_dirty_clusters = true;
+	int node_count = 0;
+
+	GridVector<Cluster> clusters;
+	GridVector<int> node_clusters;
+
+	LocalSearch start_search;
+	LocalSearch target_search;
+	LocalSearch segment_search;
+
+	// Abstract search scratch, one slot per entrance plus the goal.
+	GridVector<uint32_t> node_stamps;
+	GridVector<float> node_g_scores;
+	GridVector<int> node_parents;
+	GridVector<uint8_t> node_closed;
+	GridVector<OpenNode> node_open;
+	uint32_t node_stamp = 0;
+
+	static void _open_push(GridVector<OpenNode> &r_open, int p_index, float p_f_score);
+	static int _open_pop(GridVector<OpenNode> &r_open);
+
+	int _get_cluster(int p_index) const;
+	bool _is_in_cluster(const Cluster &p_cluster, int p_index) const;
+	int _to_local(const Cluster &p_cluster, int p_index) const;
+	int _to_cell(const Cluster &p_cluster, int p_local) const;
+	bool _are_adjacent(int p_a, int p_b) const;
+
+	void _build_border(int p_cluster_a, int p_cluster_b, GridVector<Transition> &r_transitions) const;
+	void _build_transitions(int p_cluster);
+	void _build_distances(int p_cluster);
+	void _search_cluster(LocalSearch &r_search, int p_cluster, int p_source, int p_target, bool p_reverse);
+	int _find_node(int p_cluster, int p_cell) const;
+	void _touch_node(int p_node);
+
+public:
+	void setup(const GridPathfinder *p_pathfinder, int p_cluster_size);
+	int get_cluster_size() const;
+
+	void mark_cell_dirty(int p_index);
+	void update();
+
+	bool find_path(int p_from, int p_to, GridVector<int> &r_path);
+
+	// Bytes held by the clusters, their entrances and the search buffers.
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*  grid_layout.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <cmath>
+
+// Cell layout on the grid plane (x, z), independent of the scene: cells are
+// stored row by row from the top-left cell, and hexagonal grids shift their
+// odd rows right by half a cell.
+
+// Offset of the top-left cell center from the grid center.
+inline void grid_layout_center_to_top_left(bool p_hexagonal, int p_columns, int p_rows,
+		float p_cell_width, float p_cell_depth, float &r_x, float &r_z) {
+	r_x = -(p_columns / 2) * p_cell_width;
+	r_z = -(p_rows / 2) * p_cell_depth;
+
+	if (p_hexagonal && !(p_rows % 2)) {
+		const float hex_side_length = p_cell_width / std::sqrt(3.0f); // a = s / √3.
+		r_z += hex_side_length;
+	}
+}
+
+// Offset of a cell center from the top-left cell center.
+inline void grid_layout_cell_offset(bool p_hexagonal, int p_column, int p_row,
+		float p_cell_width, float p_cell_depth, float &r_x, float &r_z) {
+	r_x = p_column * p_cell_width;
+	r_z = p_row * p_cell_depth;
+
+	if (p_hexagonal && (p_row % 2)) { // Odd.
+		r_x += p_cell_width / 2;
+	}
+}
+
+// World cell whose center is nearest to a point of the grid plane, on the
+// lattice of cells laid out from the world origin (cell (0, 0) centered on
+// it). Hexagonal rows are picked first, then the column in the row.
+inline void grid_layout_world_cell_at(bool p_hexagonal, float p_x, float p_z,
+		float p_cell_width, float p_cell_depth, int &r_column, int &r_row) {
+	r_row = static_cast<int>(std::floor(p_z / p_cell_depth + 0.5f));
+
+	float x = p_x;
+	if (p_hexagonal && (r_row % 2)) { // Odd, negative rows included.
+		x -= p_cell_width / 2;
+	}
+	r_column = static_cast<int>(std::floor(x / p_cell_width + 0.5f));
+}
@@ -0,0 +1,254 @@
+/**************************************************************************/
+/*  grid_mapped_file.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_mapped_file.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool GridMappedFile::open(const std::string &p_path) {
+	close();
+
+	const int length = MultiByteToWideChar(CP_UTF8, 0, p_path.c_str(), -1, nullptr, 0);
+	if (length <= 0) {
+		return false;
+	}
+
+	std::wstring wide_path(length, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, p_path.c_str(), -1, &wide_path[0], length);
+
+	HANDLE handle = CreateFileW(wide_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+			OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	file_handle = handle;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(handle, &file_size)) {
+		close();
+		return false;
+	}
+	size = static_cast<uint64_t>(file_size.QuadPart);
+
+	if (!_map()) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void GridMappedFile::close() {
+	_unmap();
+
+	if (file_handle) {
+		CloseHandle(static_cast<HANDLE>(file_handle));
+		file_handle = nullptr;
+	}
+	size = 0;
+}
+
+bool GridMappedFile::is_open() const {
+	return file_handle != nullptr;
+}
+
+bool GridMappedFile::_map() {
+	if (size == 0) {
+		return true; // Empty files cannot be mapped, nothing to access yet.
+	}
+
+	HANDLE mapping = CreateFileMappingW(static_cast<HANDLE>(file_handle), nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+	if (mapping == nullptr) {
+		return false;
+	}
+	mapping_handle = mapping;
+
+	address = static_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+	if (address == nullptr) {
+		CloseHandle(mapping);
+		mapping_handle = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void GridMappedFile::_unmap() {
+	if (address) {
+		UnmapViewOfFile(address);
+		address = nullptr;
+	}
+
+	if (mapping_handle) {
+		CloseHandle(static_cast<HANDLE>(mapping_handle));
+		mapping_handle = nullptr;
+	}
+}
+
+bool GridMappedFile::resize(uint64_t p_size) {
+	if (!is_open()) {
+		return false;
+	}
+
+	_unmap();
+
+	LARGE_INTEGER file_size;
+	file_size.QuadPart = static_cast<LONGLONG>(p_size);
+	if (!SetFilePointerEx(static_cast<HANDLE>(file_handle), file_size, nullptr, FILE_BEGIN) ||
+			!SetEndOfFile(static_cast<HANDLE>(file_handle))) {
+		_map();
+		return false;
+	}
+	size = p_size;
+
+	return _map();
+}
+
+void GridMappedFile::flush() {
+	if (address) {
+		FlushViewOfFile(address, 0);
+		FlushFileBuffers(static_cast<HANDLE>(file_handle));
+	}
+}
+
+#else
+
+bool GridMappedFile::open(const std::string &p_path) {
+	close();
+
+	file_descriptor = ::open(p_path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (file_descriptor == -1) {
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(file_descriptor, &file_stat) != 0) {
+		close();
+		return false;
+	}
+	size = static_cast<uint64_t>(file_stat.st_size);
+
+	if (!_map()) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void GridMappedFile::close() {
+	_unmap();
+
+	if (file_descriptor != -1) {
+		::close(file_descriptor);
+		file_descriptor = -1;
+	}
+	size = 0;
+}
+
+bool GridMappedFile::is_open() const {
+	return file_descriptor != -1;
+}
+
+bool GridMappedFile::_map() {
+	if (size == 0) {
+		return true; // Empty files cannot be mapped, nothing to access yet.
+	}
+
+	void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	address = static_cast<uint8_t *>(mapping);
+
+	return true;
+}
+
+void GridMappedFile::_unmap() {
+	if (address) {
+		munmap(address, size);
+		address = nullptr;
+	}
+}
+
+bool GridMappedFile::resize(uint64_t p_size) {
+	if (!is_open()) {
+		return false;
+	}
+
+	_unmap();
+
+	if (ftruncate(file_descriptor, static_cast<off_t>(p_size)) != 0) {
+		_map();
+		return false;
+	}
+	size = p_size;
+
+	return _map();
+}
+
+void GridMappedFile::flush() {
+	if (address) {
+		msync(address, size, MS_SYNC);
+	}
+}
+
+#endif
+
+uint64_t GridMappedFile::get_size() const {
+	return size;
+}
+
+uint8_t *GridMappedFile::ptr() {
+	return address;
+}
+
+const uint8_t *GridMappedFile::ptr() const {
+	return address;
+}
+
+GridMappedFile::~GridMappedFile() {
+	close();
+}
@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  grid_mapped_file.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Read-write memory mapping of a whole file, grown on demand. Only the
+// mapping is kept open: the pages are written back by the system, and
+// flush() forces them to disk.
+class GridMappedFile {
+private:
+#ifdef _WIN32
+	void *file_handle = nullptr;
+	void *mapping_handle = nullptr;
+#else
+	int file_descriptor = -1;
+#endif
+	uint8_t *address = nullptr;
+	uint64_t size = 0;
+
+	bool _map();
+	void _unmap();
+
+public:
+	// Opens or creates the file (UTF-8 path) and maps its current content.
+	bool open(const std::string &p_path);
+	void close();
+	bool is_open() const;
+
+	// Truncates or extends the file and maps it again: pointers into the
+	// previous mapping are invalidated.
+	bool resize(uint64_t p_size);
+	uint64_t get_size() const;
+
+	uint8_t *ptr();
+	const uint8_t *ptr() const;
+
+	void flush();
+
+	GridMappedFile() = default;
+	GridMappedFile(const GridMappedFile &) = delete;
+	GridMappedFile &operator=(const GridMappedFile &) = delete;
+	~GridMappedFile();
+};
@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  grid_path_cache.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_path_cache.h"
+
+uint64_t GridPathCache::_make_key(int p_start_cell_index, int p_target_cell_index) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(p_start_cell_index)) << 32) | static_cast<uint32_t>(p_target_cell_index);
+}
+
+void GridPathCache::_unlink(int p_slot) {
+	Entry &entry = entries[p_slot];
+
+	if (entry.previous != -1) {
+		entries[entry.previous].next = entry.next;
+	} else {
+		head = entry.next;
+	}
+
+	if (entry.next != -1) {
+		entries[entry.next].previous = entry.previous;
+	} else {
+		tail = entry.previous;
+	}
+
+	entry.previous = -1;
+	entry.next = -1;
+}
+
+void GridPathCache::_push_front(int p_slot) {
+	Entry &entry = entries[p_slot];
+	entry.previous = -1;
+	entry.next = head;
+
+	if (head != -1) {
+		entries[head].previous = p_slot;
+	}
+	head = p_slot;
+
+	if (tail == -1) {
+		tail = p_slot;
+	}
+}
+
+void GridPathCache::set_capacity(int p_capacity) {
+	if (p_capacity < 0) {
+		p_capacity = 0;
+	}
+
+	if (p_capacity != capacity) {
+		capacity = p_capacity;
+		clear();
+	}
+}
+
+int GridPathCache::get_capacity() const {
+	return capacity;
+}
+
+int GridPathCache::get_size() const {
+	return entries.size();
+}
+
+bool GridPathCache::get(int p_start_cell_index, int p_target_cell_index, int p_movement, uint32_t p_topology_version, godot::PackedInt64Array &r_path) {
+	if (capacity == 0) {
+		return false;
+	}
+
+	const int *slot = slots.getptr(_make_key(p_start_cell_index, p_target_cell_index));
+	if (slot == nullptr) {
+		misses++;
+		return false;
+	}
+
+	Entry &entry = entries[*slot];
+	if (entry.movement != p_movement || entry.topology_version != p_topology_version) {
+		misses++; // Stale, overwritten in place by the next put.
+		return false;
+	}
+
+	if (head != *slot) {
+		_unlink(*slot);
+		_push_front(*slot);
+	}
+
+	r_path = entry.path;
+	hits++;
+	return true;
+}
+
+void GridPathCache::put(int p_start_cell_index, int p_target_cell_index, int p_movement, uint32_t p_topology_version, const godot::PackedInt64Array &p_path) {
+	if (capacity == 0) {
+		return;
+	}
+
+	const uint64_t key = _make_key(p_start_cell_index, p_target_cell_index);
+
+	int slot = -1;
+	const int *existing_slot = slots.getptr(key);
+
+	if (existing_slot != nullptr) {
+		slot = *existing_slot;
+		_unlink(slot);
+	} else if (static_cast<int>(entries.size()) < capacity) {
+		slot = entries.size();
+		entries.push_back(Entry());
+		slots.insert(key, slot);
+	} else {
+		// Recycle the least recently used entry.
+		slot = tail;
+		_unlink(slot);
+		slots.erase(entries[slot].key);
+		slots.insert(key, slot);
+	}
+
+	Entry &entry = entries[slot];
+	entry.key = key;
+	entry.movement = p_movement;
+	entry.topology_version = p_topology_version;
+	entry.path = p_path;
+
+	_push_front(slot);
+}
+
+void GridPathCache::clear() {
+	slots.clear();
+	entries.clear();
+	head = -1;
+	tail = -1;
+}
+
+void GridPathCache::reset_stats() {
+	hits = 0;
+	misses = 0;
+}
+
+uint64_t GridPathCache::get_hits() const {
+	return hits;
+}
+
+uint64_t GridPathCache::get_misses() const {
+	return misses;
+}
+
+uint64_t GridPathCache::get_memory_usage() const {
+	uint64_t bytes = grid_memory_usage(slots) + grid_memory_usage(entries);
+
+	for (const Entry &entry : entries) {
+		bytes += entry.path.size() * sizeof(int64_t);
+	}
+
+	return bytes;
+}
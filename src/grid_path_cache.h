@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  grid_path_cache.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+#include <cstdint>
+
+// Least recently used cache of get_path results. Entries are looked up by
+// (start, target) and only hit while the movement mode and the grid topology
+// version they were computed with still match, so any accessibility, cost
+// or layout change turns them stale without walking the cache.
+class GridPathCache {
+private:
+	struct Entry {
+		uint64_t key = 0;
+		int movement = 0;
+		uint32_t topology_version = 0;
+		godot::PackedInt64Array path;
+		// Recency list links, most recently used first.
+		int previous = -1;
+		int next = -1;
+	};
+
+	godot::HashMap<uint64_t, int> slots;
+	godot::LocalVector<Entry> entries;
+	int head = -1;
+	int tail = -1;
+	int capacity = 0;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	static uint64_t _make_key(int p_start_cell_index, int p_target_cell_index);
+	void _unlink(int p_slot);
+	void _push_front(int p_slot);
+
+public:
+	void set_capacity(int p_capacity);
+	int get_capacity() const;
+	int get_size() const;
+
+	bool get(int p_start_cell_index, int p_target_cell_index, int p_movement, uint32_t p_topology_version, godot::PackedInt64Array &r_path);
+	void put(int p_start_cell_index, int p_target_cell_index, int p_movement, uint32_t p_topology_version, const godot::PackedInt64Array &p_path);
+
+	void clear();
+	void reset_stats();
+	uint64_t get_hits() const;
+	uint64_t get_misses() const;
+
+	// Bytes held by the entries and their cached paths.
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  grid_path_request_queue.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_path_request_queue.h"
+
+void GridPathRequestQueue::_erase_completed(int p_id) {
+	if (completed.erase(p_id)) {
+		const int64_t position = completed_ids.find(p_id);
+		if (position != -1) {
+			completed_ids.remove_at(position);
+		}
+	}
+}
+
+int GridPathRequestQueue::push(int p_start_cell_index, int p_target_cell_index) {
+	Request request;
+	request.id = next_id++;
+	request.start_cell_index = p_start_cell_index;
+	request.target_cell_index = p_target_cell_index;
+	pending.push_back(request);
+
+	return request.id;
+}
+
+GridPathRequestQueue::Status GridPathRequestQueue::get_status(int p_id) const {
+	if (completed.has(p_id)) {
+		return STATUS_DONE;
+	}
+
+	if (cancelled.find(p_id) != -1) {
+		return STATUS_UNKNOWN;
+	}
+
+	for (const Request &request : batch) {
+		if (request.id == p_id) {
+			return STATUS_RUNNING;
+		}
+	}
+
+	for (const Request &request : pending) {
+		if (request.id == p_id) {
+			return STATUS_PENDING;
+		}
+	}
+
+	return STATUS_UNKNOWN;
+}
+
+bool GridPathRequestQueue::take_result(int p_id, godot::PackedInt64Array &r_path) {
+	const godot::PackedInt64Array *completed_path = completed.getptr(p_id);
+	if (completed_path == nullptr) {
+		return false;
+	}
+
+	r_path = *completed_path;
+	_erase_completed(p_id);
+	return true;
+}
+
+void GridPathRequestQueue::cancel(int p_id) {
+	for (uint32_t index = 0; index < pending.size(); index++) {
+		if (pending[index].id == p_id) {
+			pending.remove_at(index);
+			return;
+		}
+	}
+
+	// A running search cannot be interrupted, its result is dropped on completion.
+	for (const Request &request : batch) {
+		if (request.id == p_id) {
+			if (cancelled.find(p_id) == -1) {
+				cancelled.push_back(p_id);
+			}
+			return;
+		}
+	}
+
+	_erase_completed(p_id);
+}
+
+void GridPathRequestQueue::clear() {
+	pending.clear();
+	completed.clear();
+	completed_ids.clear();
+
+	for (const Request &request : batch) {
+		if (cancelled.find(request.id) == -1) {
+			cancelled.push_back(request.id);
+		}
+	}
+}
+
+uint32_t GridPathRequestQueue::get_pending_count() const {
+	return pending.size();
+}
+
+const GridPathRequestQueue::Request &GridPathRequestQueue::get_pending(uint32_t p_index) const {
+	return pending[p_index];
+}
+
+void GridPathRequestQueue::add_to_batch(uint32_t p_pending_index) {
+	batch.push_back(pending[p_pending_index]);
+}
+
+void GridPathRequestQueue::consume_pending(uint32_t p_count) {
+	if (p_count >= pending.size()) {
+		pending.clear();
+		return;
+	}
+
+	godot::LocalVector<Request> remaining_requests;
+	remaining_requests.reserve(pending.size() - p_count);
+	for (uint32_t index = p_count; index < pending.size(); index++) {
+		remaining_requests.push_back(pending[index]);
+	}
+	pending = remaining_requests;
+}
+
+int GridPathRequestQueue::get_batch_size() const {
+	return batch.size();
+}
+
+bool GridPathRequestQueue::start_batch(const GridPathfinder &p_pathfinder, uint32_t p_topology_version, bool p_jump_point_search) {
+	if (batch.is_empty()) {
+		return false;
+	}
+
+	// The snapshot is only copied again once the grid topology has changed.
+	if (!snapshot_valid || snapshot_version != p_topology_version) {
+		snapshot = p_pathfinder;
+		snapshot_version = p_topology_version;
+		snapshot_valid = true;
+	}
+	batch_jump_point_search = p_jump_point_search;
+	snapshot_memory = snapshot.get_memory_usage();
+	batch_running = true;
+
+	return true;
+}
+
+void GridPathRequestQueue::run_batch() {
+	godot::LocalVector<int> cell_path;
+
+	for (Request &request : batch) {
+		if (batch_jump_point_search) {
+			snapshot.find_path_jps(request.start_cell_index, request.target_cell_index, cell_path);
+		} else {
+			snapshot.find_path(request.start_cell_index, request.target_cell_index, cell_path);
+		}
+
+		request.path.resize(cell_path.size());
+		for (uint32_t step = 0; step < cell_path.size(); step++) {
+			request.path.set(step, cell_path[step]);
+		}
+	}
+}
+
+bool GridPathRequestQueue::is_batch_running() const {
+	return batch_running;
+}
+
+void GridPathRequestQueue::finish_batch() {
+	batch_running = false;
+}
+
+const godot::LocalVector<GridPathRequestQueue::Request> &GridPathRequestQueue::get_batch() const {
+	return batch;
+}
+
+bool GridPathRequestQueue::is_cancelled(int p_id) const {
+	return cancelled.find(p_id) != -1;
+}
+
+uint32_t GridPathRequestQueue::get_snapshot_version() const {
+	return snapshot_version;
+}
+
+void GridPathRequestQueue::clear_batch() {
+	batch.clear();
+	cancelled.clear();
+}
+
+void GridPathRequestQueue::complete(int p_id, const godot::PackedInt64Array &p_path) {
+	if (completed_ids.size() >= MAX_COMPLETED_REQUESTS) {
+		completed.erase(completed_ids[0]);
+		completed_ids.remove_at(0);
+	}
+
+	completed.insert(p_id, p_path);
+	completed_ids.push_back(p_id);
+}
+
+uint64_t GridPathRequestQueue::get_snapshot_memory_usage() const {
+	if (!snapshot_valid) {
+		return 0;
+	}
+
+	// The snapshot is not touched while a worker searches it.
+	return batch_running ? snapshot_memory : snapshot.get_memory_usage();
+}
+
+uint64_t GridPathRequestQueue::get_memory_usage() const {
+	uint64_t bytes = grid_memory_usage(completed) + grid_memory_usage(completed_ids) +
+			grid_memory_usage(pending) + grid_memory_usage(batch);
+
+	for (int id : completed_ids) {
+		const godot::PackedInt64Array *completed_path = completed.getptr(id);
+		if (completed_path) {
+			bytes += completed_path->size() * sizeof(int64_t);
+		}
+	}
+
+	return bytes;
+}
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  grid_path_request_queue.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+#include "grid_pathfinder.h"
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+#include <cstdint>
+
+// Asynchronous path requests of a grid. The owner moves pending requests to
+// a batch, searches it on a worker thread with run_batch() against a
+// snapshot of its pathfinder, then collects the results with complete().
+// While a batch is running, the batch and the snapshot belong to the worker.
+class GridPathRequestQueue {
+public:
+	// Mirrors InteractiveGrid3D::PathRequestStatus.
+	enum Status {
+		STATUS_UNKNOWN,
+		STATUS_PENDING,
+		STATUS_RUNNING,
+		STATUS_DONE
+	};
+
+	struct Request {
+		int id = -1;
+		int start_cell_index = -1;
+		int target_cell_index = -1;
+		godot::PackedInt64Array path;
+	};
+
+	static constexpr int MAX_COMPLETED_REQUESTS = 256;
+
+private:
+	int next_id = 1;
+	godot::LocalVector<Request> pending;
+	godot::LocalVector<Request> batch;
+	godot::LocalVector<int> cancelled;
+	bool batch_running = false;
+	bool batch_jump_point_search = false;
+
+	GridPathfinder snapshot;
+	uint32_t snapshot_version = 0;
+	bool snapshot_valid = false;
+	// Snapshot size read before the batch starts, reported while a worker
+	// may be resizing its search buffers.
+	uint64_t snapshot_memory = 0;
+
+	// Finished results kept for polling, oldest first.
+	godot::HashMap<int, godot::PackedInt64Array> completed;
+	godot::LocalVector<int> completed_ids;
+
+	void _erase_completed(int p_id);
+
+public:
+	int push(int p_start_cell_index, int p_target_cell_index);
+	Status get_status(int p_id) const;
+	bool take_result(int p_id, godot::PackedInt64Array &r_path);
+	void cancel(int p_id);
+	// Drops the pending requests and the results, the running batch is
+	// discarded once it completes.
+	void clear();
+
+	uint32_t get_pending_count() const;
+	const Request &get_pending(uint32_t p_index) const;
+	void add_to_batch(uint32_t p_pending_index);
+	// Removes the first p_count pending requests.
+	void consume_pending(uint32_t p_count);
+	int get_batch_size() const;
+
+	// Refreshes the snapshot when p_topology_version has changed since the
+	// last batch. Returns false when the batch is empty.
+	bool start_batch(const GridPathfinder &p_pathfinder, uint32_t p_topology_version, bool p_jump_point_search);
+	// Worker thread: only the batch and the snapshot are touched.
+	void run_batch();
+	bool is_batch_running() const;
+	void finish_batch();
+
+	// Main thread, after finish_batch(): the batch results, cleared by clear_batch().
+	const godot::LocalVector<Request> &get_batch() const;
+	bool is_cancelled(int p_id) const;
+	uint32_t get_snapshot_version() const;
+	void clear_batch();
+
+	// Stores a result for polling, evicting the oldest one past MAX_COMPLETED_REQUESTS.
+	void complete(int p_id, const godot::PackedInt64Array &p_path);
+
+	// Bytes held by the snapshot pathfinder.
+	uint64_t get_snapshot_memory_usage() const;
+	// Bytes held by the requests and the stored results.
+	uint64_t get_memory_usage() const;
+};
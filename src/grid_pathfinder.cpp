@@ -0,0 +1,1354 @@
+/**************************************************************************/
+/*  grid_pathfinder.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_pathfinder.h"
+
+#include "grid_hex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+static constexpr float SQRT_2 = 1.41421356f;
+
+static const int straight_directions[4][2] = {
+	{ +1, 0 }, // East.
+	{ -1, 0 }, // West.
+	{ 0, +1 }, // South.
+	{ 0, -1 } // North.
+};
+
+static const int four_directions[4][2] = {
+	{ +1, 0 }, // Right.
+	{ -1, 0 }, // Left.
+	{ 0, +1 }, // Down.
+	{ 0, -1 } // Up.
+};
+
+static const int even_row_directions[6][2] = {
+	{ +1, 0 }, // East.
+	{ -1, 0 }, // West.
+	{ 0, -1 }, // North-East.
+	{ -1, -1 }, // North-West.
+	{ 0, +1 }, // South-East.
+	{ -1, +1 } // South-West.
+};
+
+static const int odd_row_directions[6][2] = {
+	{ +1, 0 }, // East.
+	{ -1, 0 }, // West.
+	{ +1, -1 }, // North-East.
+	{ 0, -1 }, // North-West.
+	{ +1, +1 }, // South-East.
+	{ 0, +1 } // South-West.
+};
+
+static const int eight_directions[8][2] = {
+	{ -1, -1 },
+	{ 0, -1 },
+	{ +1, -1 },
+	{ -1, 0 },
+	{ +1, 0 },
+	{ -1, +1 },
+	{ 0, +1 },
+	{ +1, +1 }
+};
+
+static inline int sign(int p_value) {
+	return (p_value > 0) - (p_value < 0);
+}
+
+static inline int direction_from_offset(int p_dx, int p_dy) {
+	if (p_dx > 0) {
+		return 0; // East.
+	} else if (p_dx < 0) {
+		return 1; // West.
+	} else if (p_dy > 0) {
+		return 2; // South.
+	}
+	return 3; // North.
+}
+
+bool GridPathfinder::_is_walkable(int p_x, int p_y) const {
+	if (p_x < 0 || p_x >= columns || p_y < 0 || p_y >= rows) {
+		return false;
+	}
+	return walkable[p_y * columns + p_x] != 0;
+}
+
+bool GridPathfinder::_is_straight_jump_point(int p_x, int p_y, int p_dx, int p_dy) const {
+	// A cell entered along a straight line is a jump point when it has a forced neighbor.
+	if (movement == MOVEMENT_EIGH_DIRECTIONS) {
+		if (p_dx != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) ||
+					(_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+		}
+		return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) ||
+				(_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+	}
+
+	if (p_dx != 0) {
+		return (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1)) ||
+				(_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1));
+	}
+	return (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy)) ||
+			(_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy));
+}
+
+void GridPathfinder::_compute_jump_distances_row(int p_row) {
+	// Sweep against the direction of travel so each cell reuses the distance of the next one.
+	for (int direction = DIRECTION_EAST; direction <= DIRECTION_WEST; direction++) {
+		const int dx = straight_directions[direction][0];
+		const int first = (dx > 0) ? columns - 1 : 0;
+
+		for (int column = first; column >= 0 && column < columns; column -= dx) {
+			const int index = p_row * columns + column;
+			const int next_column = column + dx;
+			int32_t distance = 0;
+
+			if (_is_walkable(next_column, p_row)) {
+				if (_is_straight_jump_point(next_column, p_row, dx, 0)) {
+					distance = 1;
+				} else {
+					const int32_t next_distance = jump_distances[(index + dx) * DIRECTION_MAX + direction];
+					distance = (next_distance > 0) ? next_distance + 1 : next_distance - 1;
+				}
+			}
+
+			jump_distances[index * DIRECTION_MAX + direction] = distance;
+		}
+	}
+}
+
+void GridPathfinder::_compute_jump_distances_column(int p_column) {
+	for (int direction = DIRECTION_SOUTH; direction <= DIRECTION_NORTH; direction++) {
+		const int dy = straight_directions[direction][1];
+		const int first = (dy > 0) ? rows - 1 : 0;
+
+		for (int row = first; row >= 0 && row < rows; row -= dy) {
+			const int index = row * columns + p_column;
+			const int next_row = row + dy;
+			int32_t distance = 0;
+
+			if (_is_walkable(p_column, next_row)) {
+				if (_is_straight_jump_point(p_column, next_row, 0, dy)) {
+					distance = 1;
+				} else {
+					const int32_t next_distance = jump_distances[(index + dy * columns) * DIRECTION_MAX + direction];
+					distance = (next_distance > 0) ? next_distance + 1 : next_distance - 1;
+				}
+			}
+
+			jump_distances[index * DIRECTION_MAX + direction] = distance;
+		}
+	}
+}
+
+void GridPathfinder::_compute_jump_distances() {
+	jump_distances.resize(get_size() * DIRECTION_MAX);
+
+	for (int row = 0; row < rows; row++) {
+		_compute_jump_distances_row(row);
+	}
+
+	for (int column = 0; column < columns; column++) {
+		_compute_jump_distances_column(column);
+	}
+
+	jump_distances_dirty = false;
+	has_dirty_lines = false;
+
+	for (uint32_t row = 0; row < dirty_rows.size(); row++) {
+		dirty_rows[row] = 0;
+	}
+
+	for (uint32_t column = 0; column < dirty_columns.size(); column++) {
+		dirty_columns[column] = 0;
+	}
+}
+
+void GridPathfinder::_mark_jump_distances_dirty(int p_x, int p_y) {
+	// Forced neighbor checks look one line aside, so the lines next to the cell are stale as well.
+	for (int row = p_y - 1; row <= p_y + 1; row++) {
+		if (row >= 0 && row < rows) {
+			dirty_rows[row] = 1;
+		}
+	}
+
+	for (int column = p_x - 1; column <= p_x + 1; column++) {
+		if (column >= 0 && column < columns) {
+			dirty_columns[column] = 1;
+		}
+	}
+
+	has_dirty_lines = true;
+}
+
+int GridPathfinder::_jump_straight(int p_x, int p_y, int p_dx, int p_dy, int p_target) const {
+	const int from = p_y * columns + p_x;
+	const int32_t distance = jump_distances[from * DIRECTION_MAX + direction_from_offset(p_dx, p_dy)];
+	const int reach = std::abs(distance);
+
+	const int target_x = p_target % columns;
+	const int target_y = p_target / columns;
+
+	if (p_dx != 0) {
+		const int steps = (target_x - p_x) * p_dx;
+		if (target_y == p_y && steps > 0 && steps <= reach) {
+			return p_target;
+		}
+	} else {
+		const int steps = (target_y - p_y) * p_dy;
+		if (target_x == p_x && steps > 0 && steps <= reach) {
+			return p_target;
+		}
+	}
+
+	if (distance > 0) {
+		return from + distance * (p_dy * columns + p_dx);
+	}
+
+	return -1;
+}
+
+int GridPathfinder::_jump(int p_x, int p_y, int p_dx, int p_dy, int p_target) const {
+	if (p_dx != 0 && p_dy != 0) {
+		// Diagonal: stop where a forced neighbor appears or a straight jump finds something.
+		int x = p_x;
+		int y = p_y;
+
+		while (true) {
+			x += p_dx;
+			y += p_dy;
+
+			if (!_is_walkable(x, y)) {
+				return -1;
+			}
+
+			const int index = y * columns + x;
+			if (index == p_target) {
+				return index;
+			}
+
+			if ((_is_walkable(x - p_dx, y + p_dy) && !_is_walkable(x - p_dx, y)) ||
+					(_is_walkable(x + p_dx, y - p_dy) && !_is_walkable(x, y - p_dy))) {
+				return index;
+			}
+
+			if (_jump_straight(x, y, p_dx, 0, p_target) != -1 || _jump_straight(x, y, 0, p_dy, p_target) != -1) {
+				return index;
+			}
+		}
+	}
+
+	if (movement == MOVEMENT_FOUR_DIRECTIONS && p_dy != 0) {
+		// Four directions: vertical runs are the only place a path may turn freely.
+		int y = p_y;
+
+		while (true) {
+			y += p_dy;
+
+			if (!_is_walkable(p_x, y)) {
+				return -1;
+			}
+
+			const int index = y * columns + p_x;
+			if (index == p_target) {
+				return index;
+			}
+
+			if (_is_straight_jump_point(p_x, y, 0, p_dy)) {
+				return index;
+			}
+
+			if (_jump_straight(p_x, y, 1, 0, p_target) != -1 || _jump_straight(p_x, y, -1, 0, p_target) != -1) {
+				return index;
+			}
+		}
+	}
+
+	return _jump_straight(p_x, p_y, p_dx, p_dy, p_target);
+}
+
+int GridPathfinder::_get_jump_directions(int p_index, int r_directions[8][2]) const {
+	int count = 0;
+	const int parent = parents[p_index];
+
+	if (parent < 0) {
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				if (dx == 0 && dy == 0) {
+					continue;
+				}
+
+				if (movement == MOVEMENT_FOUR_DIRECTIONS && dx != 0 && dy != 0) {
+					continue;
+				}
+
+				r_directions[count][0] = dx;
+				r_directions[count][1] = dy;
+				count++;
+			}
+		}
+		return count;
+	}
+
+	const int x = p_index % columns;
+	const int y = p_index / columns;
+	const int dx = sign(x - parent % columns);
+	const int dy = sign(y - parent / columns);
+
+	auto add = [&](int p_dx, int p_dy) {
+		r_directions[count][0] = p_dx;
+		r_directions[count][1] = p_dy;
+		count++;
+	};
+
+	if (movement == MOVEMENT_FOUR_DIRECTIONS) {
+		if (dx != 0) {
+			add(0, -1);
+			add(0, +1);
+			add(dx, 0);
+		} else {
+			add(-1, 0);
+			add(+1, 0);
+			add(0, dy);
+		}
+		return count;
+	}
+
+	if (dx != 0 && dy != 0) {
+		add(0, dy);
+		add(dx, 0);
+		add(dx, dy);
+		if (!_is_walkable(x - dx, y)) {
+			add(-dx, dy);
+		}
+		if (!_is_walkable(x, y - dy)) {
+			add(dx, -dy);
+		}
+	} else if (dx != 0) {
+		add(dx, 0);
+		if (!_is_walkable(x, y + 1)) {
+			add(dx, +1);
+		}
+		if (!_is_walkable(x, y - 1)) {
+			add(dx, -1);
+		}
+	} else {
+		add(0, dy);
+		if (!_is_walkable(x + 1, y)) {
+			add(+1, dy);
+		}
+		if (!_is_walkable(x - 1, y)) {
+			add(-1, dy);
+		}
+	}
+
+	return count;
+}
+
+float GridPathfinder::_octile_distance(int p_from, int p_to) const {
+	const int dx = std::abs(p_to % columns - p_from % columns);
+	const int dy = std::abs(p_to / columns - p_from / columns);
+
+	if (movement == MOVEMENT_FOUR_DIRECTIONS) {
+		return static_cast<float>(dx + dy);
+	}
+
+	const int straight = (dx > dy) ? dx - dy : dy - dx;
+	const int diagonal = (dx > dy) ? dy : dx;
+	return straight + diagonal * SQRT_2;
+}
+
+float GridPathfinder::_step_length(int p_from, int p_to) const {
+	// Euclidean distance between (column, row) on square grids, cube distance
+	// on hexagonal ones so every neighbor is one step away. The height
+	// difference is added on uneven terrain.
+	float planar_squared;
+
+	if (movement == MOVEMENT_SIX_DIRECTIONS) {
+		const float steps = static_cast<float>(hex_offset_distance(p_from % columns, p_from / columns, p_to % columns, p_to / columns));
+		planar_squared = steps * steps;
+	} else {
+		const float dx = static_cast<float>(p_to % columns - p_from % columns);
+		const float dy = static_cast<float>(p_to / columns - p_from / columns);
+		planar_squared = dx * dx + dy * dy;
+	}
+
+	if (!uneven_terrain) {
+		return std::sqrt(planar_squared);
+	}
+
+	const float dz = (heights[p_to] - heights[p_from]) * height_scale;
+	return std::sqrt(planar_squared + dz * dz);
+}
+
+bool GridPathfinder::_is_line_step_passable(int p_previous, int p_index, float p_max_multiplier, float p_max_edge_cost) const {
+	return walkable[p_index] && cost_multipliers[p_index] <= p_max_multiplier && edge_costs[p_index] <= p_max_edge_cost && is_step_allowed(p_previous, p_index);
+}
+
+bool GridPathfinder::_is_square_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const {
+	const int x0 = p_from % columns;
+	const int y0 = p_from / columns;
+	const int nx = std::abs(p_to % columns - x0);
+	const int ny = std::abs(p_to / columns - y0);
+	const int sx = p_to % columns > x0 ? 1 : -1;
+	const int sy = p_to / columns > y0 ? 1 : -1;
+
+	int x = x0;
+	int y = y0;
+	int previous = p_from;
+
+	// Supercover walk: every cell the segment touches, both sides of a corner.
+	for (int ix = 0, iy = 0; ix < nx || iy < ny;) {
+		const int decision = (1 + 2 * ix) * ny - (1 + 2 * iy) * nx;
+
+		if (decision == 0) {
+			const int side_x = y * columns + x + sx;
+			const int side_y = (y + sy) * columns + x;
+			if (!_is_line_step_passable(previous, side_x, p_max_multiplier, p_max_edge_cost) ||
+					!_is_line_step_passable(previous, side_y, p_max_multiplier, p_max_edge_cost)) {
+				return false;
+			}
+			x += sx;
+			y += sy;
+			ix++;
+			iy++;
+		} else if (decision < 0) {
+			x += sx;
+			ix++;
+		} else {
+			y += sy;
+			iy++;
+		}
+
+		const int index = y * columns + x;
+		if (!_is_line_step_passable(previous, index, p_max_multiplier, p_max_edge_cost)) {
+			return false;
+		}
+		previous = index;
+	}
+
+	return true;
+}
+
+bool GridPathfinder::_is_hexagonal_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const {
+	const int r0 = p_from / columns;
+	const int q0 = hex_offset_to_axial_q(p_from % columns, r0);
+	const int r1 = p_to / columns;
+	const int q1 = hex_offset_to_axial_q(p_to % columns, r1);
+
+	const int dq = q1 - q0;
+	const int dr = r1 - r0;
+	const int distance = hex_axial_distance(q0, r0, q1, r1);
+
+	// A line running between two hexes is nudged both ways, both must be clear.
+	for (int side = -1; side <= 1; side += 2) {
+		const float nudge = 1e-4f * side;
+		int previous = p_from;
+
+		for (int step = 1; step <= distance; step++) {
+			const float t = static_cast<float>(step) / distance;
+			int round_q;
+			int round_r;
+			hex_axial_round(q0 + dq * t + nudge, r0 + dr * t + nudge, round_q, round_r);
+
+			const int column = hex_axial_to_offset_column(round_q, round_r);
+			if (column < 0 || column >= columns || round_r < 0 || round_r >= rows) {
+				return false;
+			}
+
+			const int index = round_r * columns + column;
+			if (index == previous) {
+				continue;
+			}
+			if (!_is_line_step_passable(previous, index, p_max_multiplier, p_max_edge_cost)) {
+				return false;
+			}
+			previous = index;
+		}
+	}
+
+	return true;
+}
+
+bool GridPathfinder::_is_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const {
+	if (p_from < 0 || p_from >= get_size() || p_to < 0 || p_to >= get_size()) {
+		return false;
+	}
+
+	if (movement == MOVEMENT_SIX_DIRECTIONS) {
+		return _is_hexagonal_line_clear(p_from, p_to, p_max_multiplier, p_max_edge_cost);
+	}
+	return _is_square_line_clear(p_from, p_to, p_max_multiplier, p_max_edge_cost);
+}
+
+void GridPathfinder::_begin_search() {
+	const uint32_t size = get_size();
+
+	if (search_stamps.size() != size) {
+		search_stamps.resize(size);
+		g_scores.resize(size);
+		parents.resize(size);
+		closed.resize(size);
+		target_stamps.resize(size);
+		for (uint32_t index = 0; index < size; index++) {
+			search_stamps[index] = 0;
+			target_stamps[index] = 0;
+		}
+		search_stamp = 0;
+	}
+
+	search_stamp++;
+	if (search_stamp == 0) {
+		// Stamp wrapped around: clear once and start again.
+		for (uint32_t index = 0; index < size; index++) {
+			search_stamps[index] = 0;
+			target_stamps[index] = 0;
+		}
+		search_stamp = 1;
+	}
+
+	open.clear();
+}
+
+void GridPathfinder::_touch(int p_index) {
+	if (search_stamps[p_index] != search_stamp) {
+		search_stamps[p_index] = search_stamp;
+		g_scores[p_index] = std::numeric_limits<float>::max();
+		parents[p_index] = -1;
+		closed[p_index] = 0;
+	}
+}
+
+void GridPathfinder::_open_push(int p_index, float p_f_score) {
+	OpenNode node;
+	node.f_score = p_f_score;
+	node.index = p_index;
+
+	uint32_t child = open.size();
+	open.push_back(node);
+
+	while (child > 0) {
+		const uint32_t parent = (child - 1) / 2;
+		if (open[parent].f_score <= open[child].f_score) {
+			break;
+		}
+		const OpenNode swap = open[parent];
+		open[parent] = open[child];
+		open[child] = swap;
+		child = parent;
+	}
+}
+
+int GridPathfinder::_open_pop() {
+	const int index = open[0].index;
+	const uint32_t last = open.size() - 1;
+	open[0] = open[last];
+	open.resize(last);
+
+	uint32_t parent = 0;
+	while (true) {
+		const uint32_t left = parent * 2 + 1;
+		const uint32_t right = left + 1;
+		uint32_t smallest = parent;
+
+		if (left < last && open[left].f_score < open[smallest].f_score) {
+			smallest = left;
+		}
+		if (right < last && open[right].f_score < open[smallest].f_score) {
+			smallest = right;
+		}
+		if (smallest == parent) {
+			break;
+		}
+
+		const OpenNode swap = open[parent];
+		open[parent] = open[smallest];
+		open[smallest] = swap;
+		parent = smallest;
+	}
+
+	return index;
+}
+
+void GridPathfinder::resize(int p_columns, int p_rows) {
+	columns = p_columns;
+	rows = p_rows;
+
+	walkable.resize(get_size());
+	for (uint32_t index = 0; index < walkable.size(); index++) {
+		walkable[index] = 1;
+	}
+
+	cost_multipliers.resize(get_size());
+	edge_costs.resize(get_size());
+	for (uint32_t index = 0; index < cost_multipliers.size(); index++) {
+		cost_multipliers[index] = 1.0f;
+		edge_costs[index] = 0.0f;
+	}
+	non_uniform_cost_count = 0;
+	min_cost_multiplier = 1.0f;
+	min_cost_multiplier_dirty = false;
+
+	heights.resize(get_size());
+	slopes.resize(get_size());
+	for (uint32_t index = 0; index < heights.size(); index++) {
+		heights[index] = 0.0f;
+		slopes[index] = 0.0f;
+	}
+	uneven_terrain = false;
+	terrain_pruning = false;
+
+	dirty_rows.resize(rows);
+	dirty_columns.resize(columns);
+
+	search_stamps.clear();
+	jump_distances_dirty = true;
+}
+
+int GridPathfinder::get_columns() const {
+	return columns;
+}
+
+int GridPathfinder::get_rows() const {
+	return rows;
+}
+
+int GridPathfinder::get_size() const {
+	return columns * rows;
+}
+
+void GridPathfinder::set_movement(Movement p_movement) {
+	if (movement != p_movement) {
+		movement = p_movement;
+		jump_distances_dirty = true;
+	}
+}
+
+GridPathfinder::Movement GridPathfinder::get_movement() const {
+	return movement;
+}
+
+void GridPathfinder::set_walkable(int p_index, bool p_walkable) {
+	if (p_index < 0 || p_index >= get_size()) {
+		return;
+	}
+
+	const uint8_t value = p_walkable ? 1 : 0;
+	if (walkable[p_index] == value) {
+		return;
+	}
+
+	walkable[p_index] = value;
+
+	if (!jump_distances_dirty) {
+		_mark_jump_distances_dirty(p_index % columns, p_index / columns);
+	}
+}
+
+bool GridPathfinder::is_walkable(int p_index) const {
+	if (p_index < 0 || p_index >= get_size()) {
+		return false;
+	}
+	return walkable[p_index] != 0;
+}
+
+void GridPathfinder::set_cell_cost(int p_index, float p_multiplier, float p_edge_cost) {
+	if (p_index < 0 || p_index >= get_size()) {
+		return;
+	}
+
+	const float previous_multiplier = cost_multipliers[p_index];
+	const bool was_uniform = previous_multiplier == 1.0f && edge_costs[p_index] == 0.0f;
+	const bool is_uniform = p_multiplier == 1.0f && p_edge_cost == 0.0f;
+
+	cost_multipliers[p_index] = p_multiplier;
+	edge_costs[p_index] = p_edge_cost;
+
+	if (was_uniform != is_uniform) {
+		non_uniform_cost_count += is_uniform ? -1 : 1;
+	}
+
+	if (p_multiplier < min_cost_multiplier) {
+		min_cost_multiplier = p_multiplier;
+	} else if (previous_multiplier == min_cost_multiplier && p_multiplier > previous_multiplier) {
+		// The cheapest cell may be gone: rescan on the next update.
+		min_cost_multiplier_dirty = true;
+	}
+}
+
+float GridPathfinder::get_cost_multiplier(int p_index) const {
+	if (p_index < 0 || p_index >= get_size()) {
+		return 1.0f;
+	}
+	return cost_multipliers[p_index];
+}
+
+float GridPathfinder::get_edge_cost(int p_index) const {
+	if (p_index < 0 || p_index >= get_size()) {
+		return 0.0f;
+	}
+	return edge_costs[p_index];
+}
+
+bool GridPathfinder::has_uniform_costs() const {
+	// Uneven terrain lengthens steps and may prune some of them.
+	return non_uniform_cost_count == 0 && !uneven_terrain && !terrain_pruning;
+}
+
+void GridPathfinder::update_cost_bounds() {
+	if (!min_cost_multiplier_dirty) {
+		return;
+	}
+
+	min_cost_multiplier = cost_multipliers.is_empty() ? 1.0f : cost_multipliers[0];
+	for (uint32_t index = 1; index < cost_multipliers.size(); index++) {
+		if (cost_multipliers[index] < min_cost_multiplier) {
+			min_cost_multiplier = cost_multipliers[index];
+		}
+	}
+	min_cost_multiplier_dirty = false;
+}
+
+void GridPathfinder::set_cell_terrain(int p_index, float p_height, float p_slope) {
+	if (p_index < 0 || p_index >= get_size()) {
+		return;
+	}
+
+	heights[p_index] = p_height;
+	slopes[p_index] = p_slope;
+}
+
+float GridPathfinder::get_cell_height(int p_index) const {
+	if (p_index < 0 || p_index >= get_size()) {
+		return 0.0f;
+	}
+	return heights[p_index];
+}
+
+void GridPathfinder::set_terrain_limits(float p_max_step_height, float p_max_slope, float p_height_scale) {
+	max_step_height = p_max_step_height;
+	max_slope = p_max_slope;
+	height_scale = p_height_scale;
+}
+
+void GridPathfinder::update_terrain() {
+	uneven_terrain = false;
+	bool sloped_terrain = false;
+
+	for (uint32_t index = 0; index < heights.size(); index++) {
+		if (heights[index] != heights[0]) {
+			uneven_terrain = true;
+		}
+		if (max_slope > 0.0f && slopes[index] > max_slope) {
+			sloped_terrain = true;
+		}
+	}
+
+	terrain_pruning = (uneven_terrain && max_step_height > 0.0f) || sloped_terrain;
+}
+
+bool GridPathfinder::is_step_allowed(int p_from, int p_to) const {
+	if (!terrain_pruning) {
+		return true;
+	}
+
+	// Checked both ways so every search sees the same undirected graph.
+	if (max_step_height > 0.0f && std::abs(heights[p_to] - heights[p_from]) > max_step_height) {
+		return false;
+	}
+
+	return max_slope <= 0.0f || (slopes[p_from] <= max_slope && slopes[p_to] <= max_slope);
+}
+
+float GridPathfinder::get_step_cost(int p_from, int p_to) const {
+	return _step_length(p_from, p_to) * cost_multipliers[p_to] + edge_costs[p_to];
+}
+
+float GridPathfinder::estimate_cost(int p_from, int p_to) const {
+	// Scaled by the cheapest multiplier so the heuristic stays admissible.
+	return _step_length(p_from, p_to) * min_cost_multiplier;
+}
+
+int GridPathfinder::get_adjacent_cells(int p_index, int r_cells[8]) const {
+	const int x = p_index % columns;
+	const int y = p_index / columns;
+
+	const int(*directions)[2] = four_directions;
+	int direction_count = 4;
+
+	if (movement == MOVEMENT_SIX_DIRECTIONS) {
+		directions = (y % 2 == 0) ? even_row_directions : odd_row_directions;
+		direction_count = 6;
+	} else if (movement == MOVEMENT_EIGH_DIRECTIONS) {
+		directions = eight_directions;
+		direction_count = 8;
+	}
+
+	int count = 0;
+	for (int direction = 0; direction < direction_count; direction++) {
+		const int nx = x + directions[direction][0];
+		const int ny = y + directions[direction][1];
+
+		if (nx >= 0 && nx < columns && ny >= 0 && ny < rows) {
+			r_cells[count++] = ny * columns + nx;
+		}
+	}
+
+	return count;
+}
+
+int GridPathfinder::get_neighbors(int p_index, int r_neighbors[8]) const {
+	int adjacent_cells[8];
+	const int adjacent_count = get_adjacent_cells(p_index, adjacent_cells);
+
+	int count = 0;
+	for (int adjacent = 0; adjacent < adjacent_count; adjacent++) {
+		if (is_step_allowed(p_index, adjacent_cells[adjacent])) {
+			r_neighbors[count++] = adjacent_cells[adjacent];
+		}
+	}
+
+	return count;
+}
+
+bool GridPathfinder::is_jump_point_search_supported() const {
+	return movement == MOVEMENT_FOUR_DIRECTIONS || movement == MOVEMENT_EIGH_DIRECTIONS;
+}
+
+void GridPathfinder::update_jump_distances() {
+	if (jump_distances_dirty) {
+		_compute_jump_distances();
+		return;
+	}
+
+	if (!has_dirty_lines) {
+		return;
+	}
+
+	// Only the lines around changed cells are swept again.
+	for (int row = 0; row < rows; row++) {
+		if (dirty_rows[row]) {
+			_compute_jump_distances_row(row);
+			dirty_rows[row] = 0;
+		}
+	}
+
+	for (int column = 0; column < columns; column++) {
+		if (dirty_columns[column]) {
+			_compute_jump_distances_column(column);
+			dirty_columns[column] = 0;
+		}
+	}
+
+	has_dirty_lines = false;
+}
+
+bool GridPathfinder::find_path_jps(int p_from, int p_to, GridVector<int> &r_path) {
+	r_path.clear();
+
+	if (p_from < 0 || p_from >= get_size() || p_to < 0 || p_to >= get_size()) {
+		return false;
+	}
+
+	if (!is_jump_point_search_supported() || !walkable[p_to]) {
+		return false;
+	}
+
+	if (p_from == p_to) {
+		r_path.push_back(p_from);
+		return true;
+	}
+
+	update_jump_distances();
+
+	_begin_search();
+	_touch(p_from);
+	g_scores[p_from] = 0.0f;
+	_open_push(p_from, _octile_distance(p_from, p_to));
+
+	int directions[8][2];
+
+	while (!open.is_empty()) {
+		const int current = _open_pop();
+
+		if (closed[current]) {
+			continue;
+		}
+		closed[current] = 1;
+
+		if (current == p_to) {
+			break;
+		}
+
+		const int x = current % columns;
+		const int y = current / columns;
+		const int direction_count = _get_jump_directions(current, directions);
+
+		for (int direction = 0; direction < direction_count; direction++) {
+			const int jump_point = _jump(x, y, directions[direction][0], directions[direction][1], p_to);
+			if (jump_point < 0) {
+				continue;
+			}
+
+			_touch(jump_point);
+			if (closed[jump_point]) {
+				continue;
+			}
+
+			const float g_score = g_scores[current] + _octile_distance(current, jump_point);
+			if (g_score < g_scores[jump_point]) {
+				g_scores[jump_point] = g_score;
+				parents[jump_point] = current;
+				_open_push(jump_point, g_score + _octile_distance(jump_point, p_to));
+			}
+		}
+	}
+
+	if (search_stamps[p_to] != search_stamp || !closed[p_to]) {
+		return false;
+	}
+
+	// Walk the jump points back to the start, then expand every straight or
+	// diagonal segment into the cells it crosses.
+	GridVector<int> jump_points;
+	for (int index = p_to; index != -1; index = parents[index]) {
+		jump_points.push_back(index);
+	}
+	jump_points.invert();
+
+	r_path.push_back(jump_points[0]);
+	for (uint32_t segment = 1; segment < jump_points.size(); segment++) {
+		int x = jump_points[segment - 1] % columns;
+		int y = jump_points[segment - 1] / columns;
+		const int end_x = jump_points[segment] % columns;
+		const int end_y = jump_points[segment] / columns;
+		const int dx = sign(end_x - x);
+		const int dy = sign(end_y - y);
+
+		while (x != end_x || y != end_y) {
+			x += dx;
+			y += dy;
+			r_path.push_back(y * columns + x);
+		}
+	}
+
+	return true;
+}
+
+bool GridPathfinder::find_path(int p_from, int p_to, GridVector<int> &r_path) {
+	r_path.clear();
+
+	if (p_from < 0 || p_from >= get_size() || p_to < 0 || p_to >= get_size()) {
+		return false;
+	}
+
+	if (!walkable[p_to] && p_to != p_from) {
+		return false;
+	}
+
+	_begin_search();
+	_touch(p_from);
+	g_scores[p_from] = 0.0f;
+	_open_push(p_from, estimate_cost(p_from, p_to));
+
+	int neighbors[8];
+
+	while (!open.is_empty()) {
+		const int current = _open_pop();
+
+		if (closed[current]) {
+			continue;
+		}
+		closed[current] = 1;
+
+		if (current == p_to) {
+			for (int index = p_to; index != -1; index = parents[index]) {
+				r_path.push_back(index);
+			}
+			r_path.invert();
+			return true;
+		}
+
+		const int neighbor_count = get_neighbors(current, neighbors);
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int neighbor = neighbors[n];
+			if (!walkable[neighbor]) {
+				continue;
+			}
+
+			_touch(neighbor);
+			if (closed[neighbor]) {
+				continue;
+			}
+
+			const float g_score = g_scores[current] + get_step_cost(current, neighbor);
+			if (g_score < g_scores[neighbor]) {
+				g_scores[neighbor] = g_score;
+				parents[neighbor] = current;
+				_open_push(neighbor, g_score + estimate_cost(neighbor, p_to));
+			}
+		}
+	}
+
+	return false;
+}
+
+void GridPathfinder::find_paths(int p_from, const GridVector<int> &p_targets,
+		GridVector<int> &r_paths, GridVector<int> &r_offsets) {
+	r_paths.clear();
+	r_offsets.clear();
+	r_offsets.push_back(0);
+
+	const int size = get_size();
+	if (p_from < 0 || p_from >= size) {
+		for (uint32_t target = 0; target < p_targets.size(); target++) {
+			r_offsets.push_back(0);
+		}
+		return;
+	}
+
+	_begin_search();
+
+	// Count the distinct targets that can be settled at all.
+	int remaining_targets = 0;
+	for (const int &target : p_targets) {
+		if (target < 0 || target >= size || (!walkable[target] && target != p_from)) {
+			continue;
+		}
+		if (target_stamps[target] != search_stamp) {
+			target_stamps[target] = search_stamp;
+			remaining_targets++;
+		}
+	}
+
+	_touch(p_from);
+	g_scores[p_from] = 0.0f;
+	_open_push(p_from, 0.0f);
+
+	int neighbors[8];
+
+	while (!open.is_empty() && remaining_targets > 0) {
+		const int current = _open_pop();
+
+		if (closed[current]) {
+			continue;
+		}
+		closed[current] = 1;
+
+		if (target_stamps[current] == search_stamp) {
+			remaining_targets--;
+		}
+
+		const int neighbor_count = get_neighbors(current, neighbors);
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int neighbor = neighbors[n];
+			if (!walkable[neighbor]) {
+				continue;
+			}
+
+			_touch(neighbor);
+			if (closed[neighbor]) {
+				continue;
+			}
+
+			const float g_score = g_scores[current] + get_step_cost(current, neighbor);
+			if (g_score < g_scores[neighbor]) {
+				g_scores[neighbor] = g_score;
+				parents[neighbor] = current;
+				_open_push(neighbor, g_score);
+			}
+		}
+	}
+
+	for (const int &target : p_targets) {
+		const bool settled = target >= 0 && target < size && search_stamps[target] == search_stamp && closed[target];
+
+		if (settled) {
+			const uint32_t path_start = r_paths.size();
+			for (int index = target; index != -1; index = parents[index]) {
+				r_paths.push_back(index);
+			}
+
+			// Reverse in place so the path reads from the start.
+			uint32_t left = path_start;
+			uint32_t right = r_paths.size() - 1;
+			while (left < right) {
+				const int swap = r_paths[left];
+				r_paths[left++] = r_paths[right];
+				r_paths[right--] = swap;
+			}
+		}
+
+		r_offsets.push_back(r_paths.size());
+	}
+}
+
+bool GridPathfinder::is_line_walkable(int p_from, int p_to) const {
+	const float unbounded = std::numeric_limits<float>::infinity();
+	return _is_line_clear(p_from, p_to, unbounded, unbounded);
+}
+
+void GridPathfinder::smooth_path(const GridVector<int> &p_path, GridVector<int> &r_path) const {
+	r_path.clear();
+
+	if (p_path.size() <= 2) {
+		for (const int &index : p_path) {
+			r_path.push_back(index);
+		}
+		return;
+	}
+
+	uint32_t anchor = 0;
+	r_path.push_back(p_path[0]);
+
+	// Costliest cell of the segment the straight line would replace.
+	float max_multiplier = cost_multipliers[p_path[1]];
+	float max_edge_cost = edge_costs[p_path[1]];
+
+	for (uint32_t step = 2; step < p_path.size(); step++) {
+		const int index = p_path[step];
+		const float segment_multiplier = std::max(max_multiplier, cost_multipliers[index]);
+		const float segment_edge_cost = std::max(max_edge_cost, edge_costs[index]);
+
+		if (_is_line_clear(p_path[anchor], index, segment_multiplier, segment_edge_cost)) {
+			max_multiplier = segment_multiplier;
+			max_edge_cost = segment_edge_cost;
+			continue;
+		}
+
+		anchor = step - 1;
+		r_path.push_back(p_path[anchor]);
+		max_multiplier = cost_multipliers[index];
+		max_edge_cost = edge_costs[index];
+	}
+
+	r_path.push_back(p_path[p_path.size() - 1]);
+}
+
+void GridPathfinder::breadth_first_search(const GridVector<int> &p_sources) {
+	const int size = get_size();
+	const uint32_t word_count = (size + 63) / 64;
+
+	if (reached_bits.size() != word_count) {
+		reached_bits.resize(word_count);
+	}
+	for (uint32_t word = 0; word < word_count; word++) {
+		reached_bits[word] = 0;
+	}
+
+	// Runs of the scanline fill below need two entries each, see there.
+	const uint32_t queue_size = size + 2 * rows;
+	if (bfs_queue.size() != queue_size) {
+		bfs_queue.resize(queue_size);
+	}
+
+	uint32_t head = 0;
+	uint32_t tail = 0;
+
+	if (!terrain_pruning) {
+		// Every step inside the grid is allowed, so whole runs of walkable
+		// cells of a row are reached together (scanline fill). Runs always
+		// end on a wall or an edge, so at most size / 2 + rows of them are
+		// queued, as their first and last cell. Raw pointers keep the
+		// buffers in registers across the stores.
+		const uint8_t *cells = walkable.ptr();
+		uint64_t *bits = reached_bits.ptr();
+		int *queue = bfs_queue.ptr();
+
+		const auto fill_run = [&](int p_cell, int p_row_start) {
+			int left = p_cell;
+			while (left > p_row_start && cells[left - 1]) {
+				left--;
+			}
+			int right = p_cell;
+			while (right < p_row_start + columns - 1 && cells[right + 1]) {
+				right++;
+			}
+
+			for (int cell = left; cell <= right; cell++) {
+				bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+			}
+			queue[tail++] = left;
+			queue[tail++] = right;
+			return right;
+		};
+
+		const auto scan_row = [&](int p_row, int p_first_column, int p_last_column) {
+			const int row_start = p_row * columns;
+			const int last = row_start + std::min(p_last_column, columns - 1);
+			for (int cell = row_start + std::max(p_first_column, 0); cell <= last; cell++) {
+				if (cells[cell] && !(bits[cell >> 6] & (uint64_t(1) << (cell & 63)))) {
+					cell = fill_run(cell, row_start);
+				}
+			}
+		};
+
+		for (const int &source : p_sources) {
+			if (source < 0 || source >= size || !cells[source] || is_reached(source)) {
+				continue;
+			}
+			fill_run(source, source - source % columns);
+		}
+
+		while (head < tail) {
+			const int left = queue[head++];
+			const int right = queue[head++];
+			const int y = left / columns;
+			int first_column = left - y * columns;
+			int last_column = first_column + right - left;
+
+			// Columns reached in the rows above and below.
+			if (movement == MOVEMENT_EIGH_DIRECTIONS) {
+				first_column--;
+				last_column++;
+			} else if (movement == MOVEMENT_SIX_DIRECTIONS) {
+				if (y % 2 == 0) {
+					first_column--;
+				} else {
+					last_column++;
+				}
+			}
+
+			if (y > 0) {
+				scan_row(y - 1, first_column, last_column);
+			}
+			if (y < rows - 1) {
+				scan_row(y + 1, first_column, last_column);
+			}
+		}
+		return;
+	}
+
+	for (const int &source : p_sources) {
+		if (source < 0 || source >= size || !walkable[source] || is_reached(source)) {
+			continue;
+		}
+		reached_bits[source >> 6] |= uint64_t(1) << (source & 63);
+		bfs_queue[tail++] = source;
+	}
+
+	int neighbors[8];
+
+	while (head < tail) {
+		const int current = bfs_queue[head++];
+		const int neighbor_count = get_neighbors(current, neighbors);
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int neighbor = neighbors[n];
+			const uint64_t bit = uint64_t(1) << (neighbor & 63);
+
+			if (!walkable[neighbor] || (reached_bits[neighbor >> 6] & bit)) {
+				continue;
+			}
+
+			reached_bits[neighbor >> 6] |= bit;
+			bfs_queue[tail++] = neighbor;
+		}
+	}
+}
+
+bool GridPathfinder::is_reached(int p_index) const {
+	if (p_index < 0 || static_cast<uint32_t>(p_index >> 6) >= reached_bits.size()) {
+		return false;
+	}
+	return (reached_bits[p_index >> 6] >> (p_index & 63)) & 1;
+}
+
+void GridPathfinder::flood(const GridVector<int> &p_sources, float p_max_cost, bool p_reverse,
+		GridVector<int> &r_cells, GridVector<float> &r_costs, GridVector<int> &r_parents) {
+	r_cells.clear();
+	r_costs.clear();
+	r_parents.clear();
+
+	_begin_search();
+
+	// Sources are always settled, even when standing on an obstacle.
+	for (const int &source : p_sources) {
+		if (source < 0 || source >= get_size()) {
+			continue;
+		}
+		_touch(source);
+		if (g_scores[source] > 0.0f) {
+			g_scores[source] = 0.0f;
+			_open_push(source, 0.0f);
+		}
+	}
+
+	int neighbors[8];
+
+	while (!open.is_empty()) {
+		const int current = _open_pop();
+
+		if (closed[current]) {
+			continue;
+		}
+		closed[current] = 1;
+
+		r_cells.push_back(current);
+		r_costs.push_back(g_scores[current]);
+		r_parents.push_back(parents[current]);
+
+		const int neighbor_count = get_neighbors(current, neighbors);
+
+		for (int n = 0; n < neighbor_count; n++) {
+			const int neighbor = neighbors[n];
+			if (!walkable[neighbor]) {
+				continue;
+			}
+
+			_touch(neighbor);
+			if (closed[neighbor]) {
+				continue;
+			}
+
+			const float step_cost = p_reverse ? get_step_cost(neighbor, current) : get_step_cost(current, neighbor);
+			const float g_score = g_scores[current] + step_cost;
+			if (g_score <= p_max_cost && g_score < g_scores[neighbor]) {
+				g_scores[neighbor] = g_score;
+				parents[neighbor] = current;
+				_open_push(neighbor, g_score);
+			}
+		}
+	}
+}
+
+uint64_t GridPathfinder::get_memory_usage() const {
+	return grid_memory_usage(walkable) + grid_memory_usage(cost_multipliers) + grid_memory_usage(edge_costs) +
+			grid_memory_usage(heights) + grid_memory_usage(slopes) +
+			grid_memory_usage(jump_distances) + grid_memory_usage(dirty_rows) + grid_memory_usage(dirty_columns) +
+			grid_memory_usage(search_stamps) + grid_memory_usage(g_scores) + grid_memory_usage(parents) +
+			grid_memory_usage(closed) + grid_memory_usage(open) + grid_memory_usage(target_stamps) +
+			grid_memory_usage(reached_bits) + grid_memory_usage(bfs_queue);
+}
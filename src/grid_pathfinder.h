@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  grid_pathfinder.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "grid_core.h"
+
+#include <cstdint>
+
+// Native search structures working directly on the grid topology (cell
+// indices laid out row by row), independent of Godot.
+class GridPathfinder {
+public:
+	// Mirrors InteractiveGrid3D::Movement.
+	enum Movement {
+		MOVEMENT_FOUR_DIRECTIONS,
+		MOVEMENT_SIX_DIRECTIONS,
+		MOVEMENT_EIGH_DIRECTIONS
+	};
+
+private:
+	// Straight directions used by the JPS+ jump distance table.
+	enum Direction {
+		DIRECTION_EAST,
+		DIRECTION_WEST,
+		DIRECTION_SOUTH,
+		DIRECTION_NORTH,
+		DIRECTION_MAX
+	};
+
+	struct OpenNode {
+		float f_score = 0.0f;
+		int index = -1;
+	};
+
+	int columns = 0;
+	int rows = 0;
+	Movement movement = MOVEMENT_FOUR_DIRECTIONS;
+
+	GridVector<uint8_t> walkable;
+
+	// Combined movement costs: moving into a cell costs the step length
+	// times its multiplier plus its edge cost.
+	GridVector<float> cost_multipliers;
+	GridVector<float> edge_costs;
+	int non_uniform_cost_count = 0;
+	float min_cost_multiplier = 1.0f;
+	bool min_cost_multiplier_dirty = false;
+
+	// Terrain: floor height of each cell and slope of its floor (radians).
+	// Height differences lengthen steps, scaled to cells by height_scale, and
+	// steps over max_step_height or onto floors steeper than max_slope are
+	// pruned (a limit of 0 is disabled).
+	GridVector<float> heights;
+	GridVector<float> slopes;
+	float height_scale = 1.0f;
+	float max_step_height = 0.0f;
+	float max_slope = 0.0f;
+	bool uneven_terrain = false;
+	bool terrain_pruning = false;
+
+	// JPS+: for each cell and straight direction, the distance to the next
+	// jump point (> 0) or minus the number of free cells before a wall (<= 0).
+	GridVector<int32_t> jump_distances;
+	bool jump_distances_dirty = true;
+
+	// Rows and columns whose jump distances went stale after a walkability change.
+	GridVector<uint8_t> dirty_rows;
+	GridVector<uint8_t> dirty_columns;
+	bool has_dirty_lines = false;
+
+	// Search scratch, reset lazily through a stamp to avoid O(N) clears.
+	GridVector<uint32_t> search_stamps;
+	GridVector<float> g_scores;
+	GridVector<int> parents;
+	GridVector<uint8_t> closed;
+	GridVector<OpenNode> open;
+	GridVector<uint32_t> target_stamps;
+	uint32_t search_stamp = 0;
+
+	// Breadth-first search state: one bit per reached cell and a queue sized
+	// for the whole grid, since every cell (or run of cells) is pushed once.
+	GridVector<uint64_t> reached_bits;
+	GridVector<int> bfs_queue;
+
+	bool _is_walkable(int p_x, int p_y) const;
+	bool _is_straight_jump_point(int p_x, int p_y, int p_dx, int p_dy) const;
+	void _compute_jump_distances_row(int p_row);
+	void _compute_jump_distances_column(int p_column);
+	void _compute_jump_distances();
+	void _mark_jump_distances_dirty(int p_x, int p_y);
+	int _jump_straight(int p_x, int p_y, int p_dx, int p_dy, int p_target) const;
+	int _jump(int p_x, int p_y, int p_dx, int p_dy, int p_target) const;
+	int _get_jump_directions(int p_index, int r_directions[8][2]) const;
+
+	float _octile_distance(int p_from, int p_to) const;
+	float _step_length(int p_from, int p_to) const;
+
+	bool _is_line_step_passable(int p_previous, int p_index, float p_max_multiplier, float p_max_edge_cost) const;
+	bool _is_square_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const;
+	bool _is_hexagonal_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const;
+	bool _is_line_clear(int p_from, int p_to, float p_max_multiplier, float p_max_edge_cost) const;
+
+	void _begin_search();
+	void _touch(int p_index);
+	void _open_push(int p_index, float p_f_score);
+	int _open_pop();
+
+public:
+	void resize(int p_columns, int p_rows);
+	int get_columns() const;
+	int get_rows() const;
+	int get_size() const;
+
+	void set_movement(Movement p_movement);
+	Movement get_movement() const;
+
+	void set_walkable(int p_index, bool p_walkable);
+	bool is_walkable(int p_index) const;
+
+	void set_cell_cost(int p_index, float p_multiplier, float p_edge_cost);
+	float get_cost_multiplier(int p_index) const;
+	float get_edge_cost(int p_index) const;
+	bool has_uniform_costs() const;
+	void update_cost_bounds();
+
+	void set_cell_terrain(int p_index, float p_height, float p_slope);
+	float get_cell_height(int p_index) const;
+	void set_terrain_limits(float p_max_step_height, float p_max_slope, float p_height_scale);
+	void update_terrain();
+	bool is_step_allowed(int p_from, int p_to) const;
+	float get_step_cost(int p_from, int p_to) const;
+	float estimate_cost(int p_from, int p_to) const;
+
+	// Cells next to p_index for the current movement, whatever their state.
+	int get_adjacent_cells(int p_index, int r_cells[8]) const;
+	// Adjacent cells a path can step into from p_index.
+	int get_neighbors(int p_index, int r_neighbors[8]) const;
+
+	bool is_jump_point_search_supported() const;
+	void update_jump_distances();
+	bool find_path_jps(int p_from, int p_to, GridVector<int> &r_path);
+
+	// Weighted A* over the walkable cells, on the combined movement costs.
+	bool find_path(int p_from, int p_to, GridVector<int> &r_path);
+
+	// One Dijkstra search from p_from, stopped once every target is settled.
+	// Paths are appended to r_paths, path i spanning [r_offsets[i], r_offsets[i + 1]).
+	void find_paths(int p_from, const GridVector<int> &p_targets,
+			GridVector<int> &r_paths, GridVector<int> &r_offsets);
+
+	// Whether a straight line between two cell centers only crosses walkable
+	// cells, without cutting corners (hexagonal rows with 6 directions).
+	bool is_line_walkable(int p_from, int p_to) const;
+
+	// String pulling: drops the waypoints the path can skip along a clear
+	// straight line that crosses no cell costlier than the skipped ones.
+	void smooth_path(const GridVector<int> &p_path, GridVector<int> &r_path) const;
+
+	// Unweighted flood over walkable cells from the walkable sources.
+	void breadth_first_search(const GridVector<int> &p_sources);
+	bool is_reached(int p_index) const;
+
+	// Dijkstra flood from the sources, settling cells in increasing cost order
+	// up to p_max_cost. With p_reverse, costs are those of moving towards the
+	// sources and parents are the next step towards them.
+	void flood(const GridVector<int> &p_sources, float p_max_cost, bool p_reverse,
+			GridVector<int> &r_cells, GridVector<float> &r_costs, GridVector<int> &r_parents);
+
+	// Bytes held by the topology, cost, terrain and search buffers.
+	uint64_t get_memory_usage() const;
+};
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  grid_profiler.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_profiler.h"
+
+#include "grid_tracer.h"
+
+#include <algorithm>
+
+namespace {
+
+const char *phase_names[GridProfiler::PHASE_MAX] = {
+	"layout",
+	"floor_alignment",
+	"obstacle_scan",
+	"custom_data_scan",
+	"breadth_first_search",
+	"get_path",
+	"hover_lookup",
+	"chunk_scan",
+	"chunk_load"
+};
+
+} // namespace
+
+void GridProfiler::record(Phase p_phase, uint64_t p_usec, uint64_t p_cells) {
+	PhaseStats &phase_stats = stats[p_phase];
+	phase_stats.calls++;
+	phase_stats.total_usec += p_usec;
+	phase_stats.last_usec = p_usec;
+	phase_stats.max_usec = std::max(phase_stats.max_usec, p_usec);
+	phase_stats.cells += p_cells;
+}
+
+void GridProfiler::record(Phase p_phase, const std::chrono::high_resolution_clock::time_point &p_start,
+		const std::chrono::high_resolution_clock::time_point &p_end, uint64_t p_cells) {
+	const auto usec = std::chrono::duration_cast<std::chrono::microseconds>(p_end - p_start).count();
+	record(p_phase, static_cast<uint64_t>(std::max<int64_t>(0, usec)), p_cells);
+
+	GridTracer::get_singleton().add_event(phase_names[p_phase], "stage", p_start, p_end, p_cells);
+}
+
+const GridProfiler::PhaseStats &GridProfiler::get_stats(Phase p_phase) const {
+	return stats[p_phase];
+}
+
+void GridProfiler::reset() {
+	for (int phase = 0; phase < PHASE_MAX; phase++) {
+		stats[phase] = PhaseStats();
+	}
+}
+
+const char *GridProfiler::get_phase_name(Phase p_phase) {
+	return phase_names[p_phase];
+}
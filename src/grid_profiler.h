@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*  grid_profiler.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Per-phase timing and counters of the grid pipeline. Always on: recording a
+// phase costs two clock reads and a few additions, so the stats are also
+// available in release builds.
+class GridProfiler {
+public:
+	enum Phase {
+		PHASE_LAYOUT,
+		PHASE_FLOOR_ALIGNMENT,
+		PHASE_OBSTACLE_SCAN,
+		PHASE_CUSTOM_DATA_SCAN,
+		PHASE_BREADTH_FIRST_SEARCH,
+		PHASE_GET_PATH,
+		PHASE_HOVER_LOOKUP,
+		PHASE_CHUNK_SCAN,
+		PHASE_CHUNK_LOAD,
+		PHASE_MAX
+	};
+
+	struct PhaseStats {
+		uint64_t calls = 0;
+		uint64_t total_usec = 0;
+		uint64_t last_usec = 0;
+		uint64_t max_usec = 0;
+		uint64_t cells = 0;
+	};
+
+private:
+	PhaseStats stats[PHASE_MAX];
+
+public:
+	void record(Phase p_phase, uint64_t p_usec, uint64_t p_cells);
+	void record(Phase p_phase, const std::chrono::high_resolution_clock::time_point &p_start,
+			const std::chrono::high_resolution_clock::time_point &p_end, uint64_t p_cells);
+
+	const PhaseStats &get_stats(Phase p_phase) const;
+	void reset();
+
+	static const char *get_phase_name(Phase p_phase);
+};
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  grid_tracer.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "grid_tracer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+void GridTracer::Event::add_argument(const char *p_name, int64_t p_value) {
+	if (argument_count < MAX_ARGUMENTS) {
+		arguments[argument_count].name = p_name;
+		arguments[argument_count].value = p_value;
+		argument_count++;
+	}
+}
+
+uint64_t GridTracer::_get_thread_id() {
+	// Small stable ids read better in the trace viewers than native handles.
+	static std::atomic<uint64_t> next_thread_id{ 1 };
+	thread_local const uint64_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+	return thread_id;
+}
+
+GridTracer &GridTracer::get_singleton() {
+	static GridTracer singleton;
+	return singleton;
+}
+
+void GridTracer::start(uint32_t p_capacity) {
+	if (!slots) {
+		capacity = 1;
+		while (capacity < std::max<uint32_t>(p_capacity, 2)) {
+			capacity <<= 1;
+		}
+		slots.reset(new Slot[capacity]);
+	}
+
+	enabled.store(true, std::memory_order_release);
+}
+
+void GridTracer::stop() {
+	enabled.store(false, std::memory_order_release);
+}
+
+void GridTracer::clear() {
+	first_index.store(next_index.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+uint64_t GridTracer::get_capacity() const {
+	return capacity;
+}
+
+uint64_t GridTracer::get_recorded_count() const {
+	return next_index.load(std::memory_order_acquire) - first_index.load(std::memory_order_acquire);
+}
+
+uint64_t GridTracer::get_dropped_count() const {
+	const uint64_t recorded = get_recorded_count();
+	return recorded > capacity ? recorded - capacity : 0;
+}
+
+void GridTracer::add_event(Event &p_event) {
+	if (!slots) {
+		return;
+	}
+
+	p_event.thread_id = _get_thread_id();
+
+	const uint64_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+	Slot &slot = slots[index & (capacity - 1)];
+
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.event = p_event;
+	slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void GridTracer::add_event(const char *p_name, const char *p_category, const Clock::time_point &p_start,
+		const Clock::time_point &p_end, int64_t p_cells) {
+	if (!is_enabled()) {
+		return;
+	}
+
+	Event event;
+	event.name = p_name;
+	event.category = p_category;
+	event.start = p_start;
+	event.end = p_end;
+	event.add_argument("cells", p_cells);
+	add_event(event);
+}
+
+int64_t GridTracer::get_time_usec(const Clock::time_point &p_time) const {
+	return std::chrono::duration_cast<std::chrono::microseconds>(p_time - epoch).count();
+}
+
+void GridTracer::write_json(std::string &r_json, int64_t p_process_id, int64_t p_time_offset_usec) const {
+	r_json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	if (slots) {
+		const uint64_t end = next_index.load(std::memory_order_acquire);
+		const uint64_t begin = std::max(first_index.load(std::memory_order_acquire), end > capacity ? end - capacity : 0);
+
+		char buffer[256];
+		bool first = true;
+
+		for (uint64_t index = begin; index < end; index++) {
+			const Slot &slot = slots[index & (capacity - 1)];
+
+			// Seqlock read: skip slots being written or already overwritten.
+			if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+				continue;
+			}
+			const Event event = slot.event;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+				continue;
+			}
+
+			const int64_t start_usec = get_time_usec(event.start);
+			const int64_t duration_usec = std::max<int64_t>(0, get_time_usec(event.end) - start_usec);
+
+			std::snprintf(buffer, sizeof(buffer),
+					"%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%" PRId64 ",\"dur\":%" PRId64 ",\"pid\":%" PRId64 ",\"tid\":%" PRIu64 ",\"args\":{",
+					first ? "" : ",", event.name, event.category, start_usec + p_time_offset_usec, duration_usec,
+					p_process_id, event.thread_id);
+			r_json += buffer;
+			first = false;
+
+			for (int argument = 0; argument < event.argument_count; argument++) {
+				std::snprintf(buffer, sizeof(buffer), "%s\"%s\":%" PRId64, argument ? "," : "",
+						event.arguments[argument].name, event.arguments[argument].value);
+				r_json += buffer;
+			}
+			r_json += "}}";
+		}
+	}
+
+	char buffer[64];
+	std::snprintf(buffer, sizeof(buffer), "],\"otherData\":{\"dropped_events\":%" PRIu64 "}}", get_dropped_count());
+	r_json += buffer;
+}
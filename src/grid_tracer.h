@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  grid_tracer.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Opt-in process-wide tracer of the grid operations, exported as Chrome
+// trace_event JSON (chrome://tracing, Perfetto). Events are complete ("X")
+// events, so an event overwritten in the ring buffer never leaves an
+// unmatched begin or end behind.
+//
+// Writers claim a slot with one atomic increment and publish it through the
+// slot sequence, so recording never locks and the oldest events are
+// overwritten once the buffer is full. When disabled, a scope costs one
+// relaxed atomic load.
+class GridTracer {
+public:
+	using Clock = std::chrono::high_resolution_clock;
+
+	static constexpr int MAX_ARGUMENTS = 4;
+
+	struct Argument {
+		const char *name = nullptr;
+		int64_t value = 0;
+	};
+
+	// Names must be string literals (or live as long as the tracer).
+	struct Event {
+		const char *name = nullptr;
+		const char *category = nullptr;
+		Clock::time_point start;
+		Clock::time_point end;
+		uint64_t thread_id = 0;
+		Argument arguments[MAX_ARGUMENTS];
+		int argument_count = 0;
+
+		void add_argument(const char *p_name, int64_t p_value);
+	};
+
+private:
+	struct Slot {
+		// Index + 1 of the event stored in the slot, 0 while it is written.
+		std::atomic<uint64_t> sequence{ 0 };
+		Event event;
+	};
+
+	// Allocated by the first start() and kept: worker threads may still be
+	// writing an event while tracing is stopped.
+	std::unique_ptr<Slot[]> slots;
+	uint64_t capacity = 0;
+
+	// Indices only grow, so a slot sequence never matches a stale event.
+	// Events before first_index were cleared.
+	std::atomic<uint64_t> next_index{ 0 };
+	std::atomic<uint64_t> first_index{ 0 };
+	std::atomic<bool> enabled{ false };
+	Clock::time_point epoch = Clock::now();
+
+	static uint64_t _get_thread_id();
+
+public:
+	static GridTracer &get_singleton();
+
+	// The capacity is rounded up to a power of two and fixed by the first call.
+	void start(uint32_t p_capacity);
+	void stop();
+	void clear();
+	bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	uint64_t get_capacity() const;
+	uint64_t get_recorded_count() const;
+	uint64_t get_dropped_count() const;
+
+	void add_event(Event &p_event);
+	void add_event(const char *p_name, const char *p_category, const Clock::time_point &p_start,
+			const Clock::time_point &p_end, int64_t p_cells);
+
+	// Microseconds since the tracer was created, the trace timestamps base.
+	int64_t get_time_usec(const Clock::time_point &p_time) const;
+
+	// Chrome trace_event JSON of the buffered events. p_time_offset_usec is
+	// added to every timestamp to line them up with another clock.
+	void write_json(std::string &r_json, int64_t p_process_id, int64_t p_time_offset_usec) const;
+};
+
+// Records one complete event over its lifetime when tracing is enabled.
+class GridTraceScope {
+	GridTracer::Event event;
+	bool active = false;
+
+public:
+	explicit GridTraceScope(const char *p_name, const char *p_category = "InteractiveGrid3D") {
+		if (GridTracer::get_singleton().is_enabled()) {
+			active = true;
+			event.name = p_name;
+			event.category = p_category;
+			event.start = GridTracer::Clock::now();
+		}
+	}
+
+	void add_argument(const char *p_name, int64_t p_value) {
+		if (active) {
+			event.add_argument(p_name, p_value);
+		}
+	}
+
+	~GridTraceScope() {
+		if (active) {
+			event.end = GridTracer::Clock::now();
+			GridTracer::get_singleton().add_event(event);
+		}
+	}
+};
@@ -44,12 +44,37 @@ constexpr const char *default_shader_code = R"(
 		}
     )";
 
+namespace {
+
+// Live grids, summed into the global total of get_memory_usage.
+std::mutex live_grids_mutex;
+godot::LocalVector<const InteractiveGrid3D *> live_grids;
+
+// MultiMesh instance: a 3x4 transform and the custom data color, as floats.
+constexpr uint64_t MULTIMESH_INSTANCE_BYTES = (12 + 4) * sizeof(float);
+
+// FNV-1a step of the streaming signature.
+void hash_streaming_setting(uint64_t &r_hash, uint64_t p_value) {
+	for (int byte = 0; byte < 8; byte++) {
+		r_hash ^= (p_value >> (byte * 8)) & 0xFF;
+		r_hash *= 1099511628211ULL;
+	}
+}
+
+void hash_streaming_setting(uint64_t &r_hash, float p_value) {
+	uint32_t bits = 0;
+	std::memcpy(&bits, &p_value, sizeof(bits));
+	hash_streaming_setting(r_hash, static_cast<uint64_t>(bits));
+}
+
+} // namespace
+
 void InteractiveGrid3D::_create() {
 	if (!(data.flags & GFL_CREATED)) {
 		data.center_global_position = get_global_transform().origin;
 
 		_init_multi_mesh();
-		_init_astar();
+		_init_pathfinder();
 
 		data.flags |= GFL_CREATED;
 
@@ -70,7 +95,9 @@ void InteractiveGrid3D::_delete() {
 			data.multimesh_instance = nullptr;
 		}
 
-		data.astar = godot::Ref<godot::AStar2D>();
+		// Requests hold cell indexes of this grid.
+		data.path_requests.clear();
+
 		data.flags &= ~GFL_CREATED;
 	}
 }
@@ -114,8 +141,41 @@ void InteractiveGrid3D::_init_multi_mesh() {
 	}
 }
 
-void InteractiveGrid3D::_init_astar() {
-	data.astar.instantiate();
+void InteractiveGrid3D::_init_pathfinder() {
+	data.pathfinder.resize(data.columns, data.rows);
+	data.pathfinder.set_movement(static_cast<GridPathfinder::Movement>(data.movement));
+
+	data.field_of_view.resize(data.columns, data.rows);
+
+	data.highlighted_path_cells.clear();
+	data.highlighted_path_marks.resize(data.columns * data.rows);
+	for (uint32_t index = 0; index < data.highlighted_path_marks.size(); index++) {
+		data.highlighted_path_marks[index] = 0;
+	}
+	data.highlighted_path_generation = 0;
+	data.field_of_view.set_hexagonal(data.layout_index == LAYOUT_HEXAGONAL);
+
+	data.area.resize(data.columns, data.rows);
+	data.area.set_hexagonal(data.layout_index == LAYOUT_HEXAGONAL);
+	data.area.set_diagonal(data.movement != MOVEMENT_FOUR_DIRECTIONS);
+
+	data.dirty_cells.clear();
+	data.dirty_cell_marks.resize(data.columns * data.rows);
+	for (uint32_t index = 0; index < data.dirty_cell_marks.size(); index++) {
+		data.dirty_cell_marks[index] = 0;
+	}
+
+	data.cell_costs.resize(data.columns * data.rows);
+	data.cell_costs.fill(1.0f);
+
+	data.reachable_cell_indexes.clear();
+	data.reachable_parents.resize(data.columns * data.rows);
+	for (uint32_t index = 0; index < data.reachable_parents.size(); index++) {
+		data.reachable_parents[index] = -2;
+	}
+	_invalidate_search_caches();
+
+	data.flags |= GFL_PATHFINDER_DIRTY;
 }
 
 void InteractiveGrid3D::_layout(godot::Vector3 p_center_position) {
@@ -124,6 +184,8 @@ void InteractiveGrid3D::_layout(godot::Vector3 p_center_position) {
 		return;
 	}
 
+	auto start = std::chrono::high_resolution_clock::now();
+
 	switch (data.layout_index) {
 		case Layout::LAYOUT_SQUARE:
 			_layout_cells_as_square_grid(p_center_position);
@@ -132,27 +194,31 @@ void InteractiveGrid3D::_layout(godot::Vector3 p_center_position) {
 			_layout_cells_as_hexagonal_grid(p_center_position);
 			break;
 	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_LAYOUT, start, end, data.cells.size());
 }
 
 void InteractiveGrid3D::_layout_cells_as_square_grid(godot::Vector3 p_center_position) {
 	data.center_global_position = p_center_position;
 
-	godot::Vector2 center_to_edge;
-	center_to_edge.x = (data.columns / 2) * data.cell_size.x;
-	center_to_edge.y = (data.rows / 2) * data.cell_size.y;
-
 	godot::Vector2 top_left_global_position;
-	top_left_global_position.x = p_center_position.x - center_to_edge.x;
-	top_left_global_position.y = p_center_position.z - center_to_edge.y;
+	grid_layout_center_to_top_left(false, data.columns, data.rows, data.cell_size.x, data.cell_size.y,
+			top_left_global_position.x, top_left_global_position.y);
+	top_left_global_position.x += p_center_position.x;
+	top_left_global_position.y += p_center_position.z;
 
 	for (int row = 0; row < data.rows; row++) {
 		for (int column = 0; column < data.columns; column++) {
 			const int index = row * data.columns + column;
 
+			godot::Vector2 cell_offset;
+			grid_layout_cell_offset(false, column, row, data.cell_size.x, data.cell_size.y, cell_offset.x, cell_offset.y);
+
 			godot::Vector3 global_cell_pos;
-			global_cell_pos.x = top_left_global_position.x + column * data.cell_size.x;
+			global_cell_pos.x = top_left_global_position.x + cell_offset.x;
 			global_cell_pos.y = p_center_position.y;
-			global_cell_pos.z = top_left_global_position.y + row * data.cell_size.y;
+			global_cell_pos.z = top_left_global_position.y + cell_offset.y;
 
 			godot::Vector3 local_cell_pos = global_cell_pos - data.multimesh_instance->get_global_transform().origin;
 			godot::Transform3D cell_transform;
@@ -182,41 +248,23 @@ void InteractiveGrid3D::_layout_cells_as_square_grid(godot::Vector3 p_center_pos
 void InteractiveGrid3D::_layout_cells_as_hexagonal_grid(godot::Vector3 p_center_position) {
 	data.center_global_position = p_center_position;
 
-	const float hex_short_diagonal = data.cell_size.x; // s = a · √3
-	const float hex_side_length = hex_short_diagonal / sqrt(3); // a = s / √3.
-	const float hex_side_to_side = data.cell_size.x / 2;
-	const float hex_inradius = hex_side_length * sqrt(3) / 2; // r = a · √3 / 2.
-
-	godot::Vector2 center_to_edge;
-	center_to_edge.x = (data.columns / 2) * data.cell_size.x;
-	center_to_edge.y = (data.rows / 2) * data.cell_size.y;
-
-	if ((data.columns % 2)) {
-		center_to_edge.x;
-	}
-
-	if (!(data.rows % 2)) {
-		center_to_edge.y -= hex_side_length;
-	}
-
 	godot::Vector2 top_left_global_position;
-	top_left_global_position.x = p_center_position.x - center_to_edge.x;
-	top_left_global_position.y = p_center_position.z - center_to_edge.y;
+	grid_layout_center_to_top_left(true, data.columns, data.rows, data.cell_size.x, data.cell_size.y,
+			top_left_global_position.x, top_left_global_position.y);
+	top_left_global_position.x += p_center_position.x;
+	top_left_global_position.y += p_center_position.z;
 
 	for (int row = 0; row < data.rows; row++) {
 		for (int column = 0; column < data.columns; column++) {
 			const int index = row * data.columns + column;
 
-			godot::Vector3 global_cell_pos;
-
-			if (!(row % 2)) { // Even.
-				global_cell_pos.x = top_left_global_position.x + (column * data.cell_size.x);
-			} else {
-				global_cell_pos.x = top_left_global_position.x + (column * data.cell_size.x) + hex_side_to_side;
-			}
+			godot::Vector2 cell_offset;
+			grid_layout_cell_offset(true, column, row, data.cell_size.x, data.cell_size.y, cell_offset.x, cell_offset.y);
 
+			godot::Vector3 global_cell_pos;
+			global_cell_pos.x = top_left_global_position.x + cell_offset.x;
 			global_cell_pos.y = p_center_position.y;
-			global_cell_pos.z = top_left_global_position.y + (row * data.cell_size.y);
+			global_cell_pos.z = top_left_global_position.y + cell_offset.y;
 
 			godot::Vector3 local_cell_pos = global_cell_pos - data.multimesh_instance->get_global_transform().origin;
 			godot::Transform3D cell_transform;
@@ -244,207 +292,151 @@ void InteractiveGrid3D::_layout_cells_as_hexagonal_grid(godot::Vector3 p_center_
 	}
 }
 
-void InteractiveGrid3D::_configure_astar() {
-	if (godot::Engine::get_singleton()->is_editor_hint()) {
-		return;
-	}
-
+void InteractiveGrid3D::_breadth_first_search(const godot::LocalVector<int> &p_start_cell_indexes) {
 	auto start = std::chrono::high_resolution_clock::now();
 
-	data.astar->clear();
-
-	// Register all grid points and mark obstacles.
-	for (int index = 0; index < data.cells.size(); ++index) {
-		int x = index % data.columns;
-		int y = index / data.columns;
-		data.astar->add_point(index, godot::Vector2(x, y), 1.0);
-		data.astar->set_point_disabled(index, !is_cell_accessible(index));
-	}
+	_sync_pathfinder();
+	data.pathfinder.breadth_first_search(p_start_cell_indexes);
 
-	switch (data.movement) {
-		case Movement::MOVEMENT_FOUR_DIRECTIONS:
-			_configure_astar_4_dir();
-			break;
-		case Movement::MOVEMENT_SIX_DIRECTIONS:
-			_configure_astar_6_dir();
-			break;
-		case Movement::MOVEMENT_EIGH_DIRECTIONS:
-			_configure_astar_8_dir();
-			break;
+	for (int index = 0; index < data.cells.size(); index++) {
+		if (data.pathfinder.is_walkable(index) && !data.pathfinder.is_reached(index)) {
+			set_cell_reachable(index, false);
+		}
 	}
 
 	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_BREADTH_FIRST_SEARCH, start, end, data.cells.size());
 
-	if (_debug_options.print_execution_time_enabled) {
-		std::chrono::duration<double, std::milli> duration = end - start;
-		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	if (_debug_options.print_logs_enabled) {
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Unreachable cells computed.");
 	}
 }
 
-void InteractiveGrid3D::_configure_astar_4_dir() {
-	for (int row = 0; row < data.rows; row++) {
-		for (int column = 0; column < data.columns; column++) {
-			const int index = row * data.columns + column;
-
-			// Connect to the right
-			if (column + 1 < data.columns) {
-				int right = row * data.columns + (column + 1);
-				data.astar->connect_points(index, right);
-				data.cells[index]->neighbors.push_back(right);
-			}
-
-			// Connect to the left
-			if (column - 1 >= 0) {
-				int left = row * data.columns + (column - 1);
-				//_astar->connect_points(index, left);
-				data.cells[index]->neighbors.push_back(left);
-			}
+void InteractiveGrid3D::_mark_pathfinding_cell_dirty(int p_cell_index) {
+	if (data.flags & GFL_PATHFINDER_DIRTY) {
+		return; // A full rebuild is already pending, caches were dropped then.
+	}
 
-			// Connect to the down
-			if (row + 1 < data.rows) {
-				int down = (row + 1) * data.columns + column;
-				data.astar->connect_points(index, down);
-				data.cells[index]->neighbors.push_back(down);
-			}
+	// Every search syncs the pathfinder first, so while the cell still
+	// matches it nothing was cached from another state: the caches survive
+	// a cell that is re-asserted or flipped back before the next search.
+	if (data.pathfinder.is_walkable(p_cell_index) != is_cell_accessible(p_cell_index)) {
+		_invalidate_search_caches();
+	}
 
-			// Connect to the up
-			if (row - 1 >= 0) {
-				int up = (row - 1) * data.columns + column;
-				//_astar->connect_points(index, up);
-				data.cells[index]->neighbors.push_back(up);
-			}
-		}
+	if (p_cell_index >= data.dirty_cell_marks.size() || data.dirty_cell_marks[p_cell_index]) {
+		return;
 	}
-}
 
-void InteractiveGrid3D::_configure_astar_6_dir() {
-	const int even_directions[6][2] = {
-		{ +1, 0 }, // East.
-		{ -1, 0 }, // West.
-		{ 0, -1 }, // North-East.
-		{ -1, -1 }, // North-West.
-		{ 0, +1 }, // South-East.
-		{ -1, +1 } // South-West.
-	};
+	data.dirty_cell_marks[p_cell_index] = 1;
+	data.dirty_cells.push_back(p_cell_index);
+}
 
-	const int odd_directions[6][2] = {
-		{ +1, 0 }, // East.
-		{ -1, 0 }, // West.
-		{ +1, -1 }, // North-East.
-		{ 0, -1 }, // North-West.
-		{ +1, +1 }, // South-East.
-		{ 0, +1 } // South-West.
-	};
+void InteractiveGrid3D::_invalidate_search_caches() {
+	// Every cached search result depends on accessibility and costs.
+	data.topology_version++;
+	data.reachable_cache_valid = false;
 
-	for (int row = 0; row < data.rows; row++) {
-		for (int column = 0; column < data.columns; column++) {
-			const int index = row * data.columns + column;
+	for (godot::Ref<GridFlowField> &flow_field : data.flow_fields) {
+		flow_field->invalidate();
+	}
+	data.flow_fields.clear();
+}
 
-			const int(*dirs)[2] = (row % 2 == 0) ? even_directions : odd_directions;
+void InteractiveGrid3D::_apply_terrain_limits(GridPathfinder &r_pathfinder) const {
+	// Heights are measured in cells so they weigh like horizontal steps.
+	const float height_scale = 2.0f / (data.cell_size.x + data.cell_size.y);
+	r_pathfinder.set_terrain_limits(data.max_step_height, data.max_slope * DEGREES_TO_RADIANS, height_scale);
+	r_pathfinder.update_terrain();
+}
 
-			// Iterate over the 6 directions.
-			for (int d = 0; d < 6; d++) {
-				int nx = column + dirs[d][0];
-				int ny = row + dirs[d][1];
+void InteractiveGrid3D::_sync_pathfinder() {
+	// Native searches only need walkability, terrain and costs.
+	if (data.flags & GFL_PATHFINDER_DIRTY) {
+		data.pathfinder.set_movement(static_cast<GridPathfinder::Movement>(data.movement));
 
-				if (nx >= 0 && nx < data.columns && ny >= 0 && ny < data.rows) {
-					int neighbor_index = ny * data.columns + nx;
+		for (int index = 0; index < data.cells.size(); ++index) {
+			data.pathfinder.set_walkable(index, is_cell_accessible(index));
 
-					data.cells[index]->neighbors.push_back(neighbor_index);
+			const Cell *cell = data.cells[index];
+			const float slope = std::acos(std::max(-1.0f, std::min(1.0f, cell->floor_normal.y)));
+			data.pathfinder.set_cell_terrain(index, cell->local_xform.origin.y, slope);
+		}
 
-					if (!is_cell_accessible(index))
-						continue;
+		_apply_terrain_limits(data.pathfinder);
 
-					if (is_cell_accessible(neighbor_index)) {
-						if (!data.astar->has_point(neighbor_index)) {
-							data.astar->add_point(neighbor_index, godot::Vector2(nx, ny));
-						}
+		data.hierarchy.setup(&data.pathfinder, data.cluster_size);
 
-						data.astar->connect_points(index, neighbor_index);
-					}
-				}
+		data.flags &= ~GFL_PATHFINDER_DIRTY;
+	} else {
+		for (const int &index : data.dirty_cells) {
+			const bool accessible = is_cell_accessible(index);
+			if (data.pathfinder.is_walkable(index) != accessible) {
+				data.pathfinder.set_walkable(index, accessible);
+				data.hierarchy.mark_cell_dirty(index);
 			}
 		}
 	}
-}
 
-void InteractiveGrid3D::_configure_astar_8_dir() {
-	for (int row = 0; row < data.rows; row++) {
-		for (int column = 0; column < data.columns; column++) {
-			const int index = row * data.columns + column;
+	data.pathfinder.update_cost_bounds();
+}
 
-			for (int row_offset = -1; row_offset <= 1; ++row_offset) {
-				for (int col_offset = -1; col_offset <= 1; ++col_offset) {
-					if (col_offset == 0 && row_offset == 0)
-						continue; // Do not connect to itself.
+void InteractiveGrid3D::_update_pathfinding_graph() {
+	if (godot::Engine::get_singleton()->is_editor_hint()) {
+		return;
+	}
 
-					int nx = column + col_offset;
-					int ny = row + row_offset;
+	_sync_pathfinder();
 
-					if (nx >= 0 && nx < data.columns && ny >= 0 && ny < data.rows) {
-						int neighbor_index = ny * data.columns + nx;
-						data.cells[index]->neighbors.push_back(neighbor_index);
+	for (const int &index : data.dirty_cells) {
+		data.dirty_cell_marks[index] = 0;
+	}
+	data.dirty_cells.clear();
 
-						bool neighbor_accessible = is_cell_accessible(neighbor_index);
-						if (neighbor_accessible) {
-							data.astar->connect_points(index, neighbor_index);
-						}
-					}
-				}
-			}
-		}
+	// JPS+: jump distances only change with the topology, refresh them here.
+	if (_is_jump_point_search_usable()) {
+		data.pathfinder.update_jump_distances();
 	}
 }
 
-void InteractiveGrid3D::_breadth_first_search(int p_start_cell_index) {
-	struct BSFNode {
-		int index{ 0 };
-		bool visited = false;
-		bool is_accessible = false;
-		bool is_reachable = false;
-		godot::PackedInt64Array neighbors;
-	};
-
-	unsigned int grid_size = data.rows * data.columns;
-	godot::Vector<BSFNode> graph;
-	graph.resize(grid_size);
+bool InteractiveGrid3D::_is_jump_point_search_usable() const {
+	if (!data.jump_point_search_enabled) {
+		return false;
+	}
 
-	for (int index = 0; index < grid_size; index++) {
-		graph.write[index].is_accessible = is_cell_accessible(index);
-		graph.write[index].is_reachable = is_cell_reachable(index);
-		graph.write[index].is_reachable = is_cell_reachable(index);
-		graph.write[index].neighbors = get_neighbors(index);
+	if (data.layout_index != Layout::LAYOUT_SQUARE) {
+		return false;
 	}
 
-	godot::List<int> queue;
+	// JPS prunes on uniform step costs only, weighted grids go through A*.
+	if (!data.pathfinder.has_uniform_costs()) {
+		return false;
+	}
 
-	graph.write[p_start_cell_index].visited = true;
-	queue.push_back(p_start_cell_index);
+	return data.movement == Movement::MOVEMENT_FOUR_DIRECTIONS || data.movement == Movement::MOVEMENT_EIGH_DIRECTIONS;
+}
 
-	while (!queue.is_empty()) {
-		int current = queue.front()->get();
-		queue.pop_front();
+bool InteractiveGrid3D::_is_hierarchical_pathfinding_usable(int p_start_cell_index) const {
+	if (!data.hierarchical_pathfinding_enabled) {
+		return false;
+	}
 
-		if (!graph[current].is_accessible) {
-			continue;
-		}
+	// A start standing on an obstacle is not part of any entrance.
+	return data.pathfinder.is_walkable(p_start_cell_index);
+}
 
-		for (const int &neighbor : graph[current].neighbors) {
-			if (!graph[neighbor].is_accessible) {
-				continue;
-			}
+void InteractiveGrid3D::_update_cell_cost(int p_cell_index) {
+	float multiplier = data.cell_costs[p_cell_index];
+	float edge_cost = 0.0f;
+	_get_custom_flags_cost(data.cells[p_cell_index]->custom_flags, multiplier, edge_cost);
 
-			if (!graph[neighbor].visited) {
-				queue.push_back(neighbor);
-				graph.write[neighbor].visited = true;
-			}
-		}
+	if (data.pathfinder.get_cost_multiplier(p_cell_index) == multiplier && data.pathfinder.get_edge_cost(p_cell_index) == edge_cost) {
+		return;
 	}
 
-	for (int index = 0; index < grid_size; index++) {
-		if (graph[index].is_accessible && !graph[index].visited)
-			set_cell_reachable(index, false);
-	}
+	data.pathfinder.set_cell_cost(p_cell_index, multiplier, edge_cost);
+	data.hierarchy.mark_cell_dirty(p_cell_index);
+	_invalidate_search_caches();
 }
 
 void InteractiveGrid3D::_align_cells_with_floor() {
@@ -455,67 +447,30 @@ void InteractiveGrid3D::_align_cells_with_floor() {
 
 		auto start = std::chrono::high_resolution_clock::now();
 
-		const int ray_length = 500;
-		const godot::Transform3D global_transform = data.multimesh_instance->get_global_transform();
-		const godot::Transform3D global_to_local = global_transform.affine_inverse();
+		godot::PhysicsDirectSpaceState3D *space_state = get_world_3d()->get_direct_space_state();
 
 		for (int row = 0; row < data.rows; row++) {
 			for (int column = 0; column < data.columns; column++) {
 				const int index =
 						row * data.columns + column;
 
-				godot::Vector3 local_from = data.cells[index]->local_xform.origin;
-				godot::Vector3 global_from = data.cells[index]->global_xform.origin;
-				global_from.y += 100.0f;
-				godot::Vector3 global_to = global_from - godot::Vector3(0, ray_length, 0);
-
-				godot::Ref<godot::World3D> world = get_world_3d();
-				godot::PhysicsDirectSpaceState3D *space_state = world->get_direct_space_state();
-				godot::Ref<godot::PhysicsRayQueryParameters3D> ray_query;
-				ray_query.instantiate();
-				ray_query->set_collide_with_areas(true);
-				ray_query->set_from(global_from);
-				ray_query->set_to(global_to);
-				ray_query->set_collision_mask(data.floor_collision_mask);
-
-				godot::TypedArray<godot::RID> exclude_array;
-				exclude_array.append(data.multimesh->get_rid());
-				ray_query->set_exclude(exclude_array);
-
-				godot::Dictionary result = space_state->intersect_ray(ray_query);
-				if (!result.is_empty()) {
-					godot::Object *collider_obj = Object::cast_to<godot::Object>(result["collider"]);
-
-					if (collider_obj) {
-						godot::Node3D *collider_node = Object::cast_to<godot::Node3D>(collider_obj);
-
-						if (collider_node && !collider_node->is_visible_in_tree()) {
-							continue;
-						}
-					}
-
-					godot::Vector3 hit_position_global = result["position"];
-					godot::Vector3 floor_normal = result["normal"];
-					godot::Vector3 hit_position_local = global_to_local.xform(hit_position_global);
-
-					godot::Transform3D xform;
-					xform.origin = hit_position_local;
-					xform.basis.set_column(1, floor_normal.normalized());
-					godot::Vector3 basis_z = xform.basis.get_column(2);
-					godot::Vector3 basis_x = floor_normal.cross(basis_z).normalized();
-					xform.basis.set_column(0, basis_x);
-					basis_z = basis_x.cross(floor_normal).normalized();
-					xform.basis.set_column(2, basis_z);
-					xform.basis = xform.basis.orthonormalized();
-					data.multimesh->set_instance_transform(index, xform);
-					data.cells.write[index]->local_xform = xform;
-					data.cells.write[index]->global_xform = data.multimesh_instance->get_global_transform() * data.multimesh->get_instance_transform(index);
+				godot::Vector3 hit_position;
+				godot::Vector3 floor_normal;
+				const FloorHit floor_hit = _intersect_floor(space_state, data.cells[index]->global_xform.origin, hit_position, floor_normal);
+
+				if (floor_hit == FLOOR_HIDDEN) {
+					continue;
+				}
+
+				if (floor_hit == FLOOR_HIT) {
+					_set_cell_floor(index, hit_position, floor_normal);
 
 					set_cell_accessible(index, true);
 					set_cell_reachable(index, true);
 					set_cell_visible(index, true);
 
 				} else if (!godot::Engine::get_singleton()->is_editor_hint()) {
+					data.cells.write[index]->floor_normal = godot::Vector3(0.0f, 1.0f, 0.0f);
 					_set_cell_in_void(index, true);
 					set_cell_accessible(index, false);
 				} else {
@@ -526,7 +481,12 @@ void InteractiveGrid3D::_align_cells_with_floor() {
 			}
 		}
 
+		// Heights and slopes feed the step costs and connectivity.
+		data.flags |= GFL_PATHFINDER_DIRTY;
+		_invalidate_search_caches();
+
 		auto end = std::chrono::high_resolution_clock::now();
+		data.profiler.record(GridProfiler::PHASE_FLOOR_ALIGNMENT, start, end, data.cells.size());
 
 		if (_debug_options.print_execution_time_enabled) {
 			std::chrono::duration<double, std::milli> duration = end - start;
@@ -565,32 +525,15 @@ void InteractiveGrid3D::_scan_environnement_obstacles() {
 		for (int column = 0; column < data.columns; column++) {
 			const int index = row * data.columns + column;
 
-			godot::Transform3D cell_transform = data.cells.write[index]->global_xform;
-			godot::Ref<godot::PhysicsShapeQueryParameters3D> query;
-			query.instantiate();
-			query->set_shape(data.cell_shape);
-			query->set_transform(cell_transform);
-			query->set_collision_mask(data.obstacles_collision_masks);
-			query->set_collide_with_bodies(true);
-			query->set_collide_with_areas(true);
-
-			godot::TypedArray<godot::Dictionary> results = space_state->intersect_shape(query, 16);
-			if (results.size() > 0) {
-				for (int k = 0; k < results.size(); k++) {
-					godot::Dictionary hit = results[k];
-
-					godot::Object *collider_obj = hit["collider"];
-					godot::Node *collider = godot::Object::cast_to<godot::Node>(collider_obj);
-
-					if (collider) {
-						set_cell_accessible(index, false);
-					}
-				}
+			if (_intersects_obstacle(space_state, data.cells[index]->global_xform)) {
+				set_cell_accessible(index, false);
+				set_cell_opaque(index, true);
 			}
 		}
 	}
 
 	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_OBSTACLE_SCAN, start, end, data.cells.size());
 
 	if (_debug_options.print_execution_time_enabled) {
 		std::chrono::duration<double, std::milli> duration = end - start;
@@ -620,6 +563,8 @@ void InteractiveGrid3D::_scan_environnement_custom_data() {
 
 	auto start = std::chrono::high_resolution_clock::now();
 
+	godot::LocalVector<int> matches;
+
 	for (int row = 0; row < data.rows; row++) {
 		for (int column = 0; column < data.columns; column++) {
 			const int cell_index = row * data.columns + column;
@@ -628,69 +573,15 @@ void InteractiveGrid3D::_scan_environnement_custom_data() {
 				continue;
 			}
 
-			const godot::Vector3 cell_pos = data.cells[cell_index]->global_xform.origin;
-
-			godot::Ref<godot::PhysicsShapeQueryParameters3D> query;
-			query.instantiate();
-			query->set_shape(data.cell_shape);
-			query->set_transform(godot::Transform3D(godot::Basis(), cell_pos));
-			query->set_collision_mask(UINT32_MAX);
-			query->set_collide_with_bodies(true);
-			query->set_collide_with_areas(true);
-
-			godot::TypedArray<godot::Dictionary> results = space_state->intersect_shape(query, 16);
-			if (results.size() > 0) {
-				for (int k = 0; k < results.size(); k++) {
-					godot::Dictionary hit = results[k];
-					godot::Object *collider_obj = hit["collider"];
-					godot::Node *collider = godot::Object::cast_to<godot::Node>(collider_obj);
-					godot::CollisionObject3D *collision_object =
-							godot::Object::cast_to<godot::CollisionObject3D>(collider_obj);
-
-					if (collider) {
-						godot::Ref<CustomCellData> custom_cell_data;
-
-						for (int index = 0; index < data.custom_cell_data.size(); index++) {
-							custom_cell_data = data.custom_cell_data.get(index);
-
-							if (!collision_object) {
-								continue;
-							}
-
-							if (custom_cell_data.is_null()) {
-								continue;
-							}
-
-							if (custom_cell_data->get_collision_layer() == 0) {
-								continue;
-							}
-
-							if (custom_cell_data->get_layer_mask() == 0) {
-								continue;
-							}
-
-							uint32_t collision_layer = collision_object->get_collision_layer();
-							if (!custom_cell_data->has_layers_in_mask(collision_layer)) {
-								continue;
-							}
-
-							data.cells.write[cell_index]->custom_flags |= custom_cell_data->get_layer_mask();
-							data.cells.write[cell_index]->flags |= custom_cell_data->get_layer_mask();
-
-							if (custom_cell_data->get_custom_color_enabled()) {
-								data.cells.write[cell_index]->has_custom_color = true;
-								data.cells.write[cell_index]->custom_color = custom_cell_data->get_color();
-
-								set_cell_color(cell_index, data.cells[cell_index]->custom_color);
-							}
-						}
-					}
-				}
+			_intersect_custom_cell_data(space_state, data.cells[cell_index]->global_xform.origin, matches);
+			if (!matches.is_empty()) {
+				_apply_custom_cell_data(cell_index, matches);
 			}
 		}
 	}
 
 	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_CUSTOM_DATA_SCAN, start, end, data.cells.size());
 
 	if (_debug_options.print_execution_time_enabled) {
 		std::chrono::duration<double, std::milli> duration = end - start;
@@ -702,715 +593,2937 @@ void InteractiveGrid3D::_scan_environnement_custom_data() {
 	}
 }
 
-void InteractiveGrid3D::_apply_material(const godot::Ref<godot::Material> &p_material) {
-	if (data.multimesh_instance == nullptr) {
-		PrintError(__FILE__, __FUNCTION__, __LINE__, "No MultiMeshInstance found.");
-		return;
-	}
+InteractiveGrid3D::FloorHit InteractiveGrid3D::_intersect_floor(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Vector3 &p_global_position, godot::Vector3 &r_position, godot::Vector3 &r_normal) const {
+	const int ray_length = 500;
 
-	if (p_material.is_null()) {
-		data.multimesh_instance->set_material_override(nullptr);
-		apply_default_material();
-		return;
-	} else {
-		data.multimesh_instance->set_material_override(p_material);
-	}
-}
+	godot::Vector3 global_from = p_global_position;
+	global_from.y += 100.0f;
+	godot::Vector3 global_to = global_from - godot::Vector3(0, ray_length, 0);
 
-void InteractiveGrid3D::_set_cell_in_void(int p_cell_index, bool p_is_in_void) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
-	}
+	godot::Ref<godot::PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	ray_query->set_collide_with_areas(true);
+	ray_query->set_from(global_from);
+	ray_query->set_to(global_to);
+	ray_query->set_collision_mask(data.floor_collision_mask);
 
-	if (p_is_in_void) {
-		data.cells.write[p_cell_index]->flags |= CFL_IN_VOID;
-		set_cell_visible(p_cell_index, false);
-	} else if (!p_is_in_void) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_IN_VOID;
-	}
-}
+	godot::TypedArray<godot::RID> exclude_array;
+	exclude_array.append(data.multimesh->get_rid());
+	ray_query->set_exclude(exclude_array);
 
-void InteractiveGrid3D::_set_cell_hovered(int p_cell_index, bool p_is_hovered) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
+	godot::Dictionary result = p_space_state->intersect_ray(ray_query);
+	if (result.is_empty()) {
+		return FLOOR_MISSED;
 	}
 
-	if (p_is_hovered) {
-		data.cells.write[p_cell_index]->flags |= CFL_HOVERED;
-		set_cell_color(data.hovered_cell_index, data.hovered_color);
-	} else if (!p_is_hovered) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_HOVERED;
-	}
-}
+	godot::Object *collider_obj = Object::cast_to<godot::Object>(result["collider"]);
 
-void InteractiveGrid3D::_set_cell_selected(int p_cell_index, bool p_is_selected) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
-	}
+	if (collider_obj) {
+		godot::Node3D *collider_node = Object::cast_to<godot::Node3D>(collider_obj);
 
-	if (p_is_selected) {
-		data.cells.write[p_cell_index]->flags |= CFL_SELECTED;
-		set_cell_color(p_cell_index, data.selected_color);
-	} else if (!p_is_selected) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_SELECTED;
+		if (collider_node && !collider_node->is_visible_in_tree()) {
+			return FLOOR_HIDDEN;
+		}
 	}
+
+	r_position = result["position"];
+	godot::Vector3 floor_normal = result["normal"];
+	r_normal = floor_normal.normalized();
+
+	return FLOOR_HIT;
 }
 
-void InteractiveGrid3D::_set_cell_on_path(int p_cell_index, bool p_is_on_path) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
-	}
+bool InteractiveGrid3D::_intersects_obstacle(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Transform3D &p_global_xform) const {
+	godot::Ref<godot::PhysicsShapeQueryParameters3D> query;
+	query.instantiate();
+	query->set_shape(data.cell_shape);
+	query->set_transform(p_global_xform);
+	query->set_collision_mask(data.obstacles_collision_masks);
+	query->set_collide_with_bodies(true);
+	query->set_collide_with_areas(true);
 
-	if (p_is_on_path) {
-		data.cells.write[p_cell_index]->flags |= CFL_PATH;
-		set_cell_color(p_cell_index, data.path_color);
-	} else if (!p_is_on_path) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_PATH;
+	godot::TypedArray<godot::Dictionary> results = p_space_state->intersect_shape(query, 16);
+	for (int k = 0; k < results.size(); k++) {
+		godot::Dictionary hit = results[k];
+
+		godot::Object *collider_obj = hit["collider"];
+		godot::Node *collider = godot::Object::cast_to<godot::Node>(collider_obj);
+
+		if (collider) {
+			return true;
+		}
 	}
+
+	return false;
 }
 
-void InteractiveGrid3D::_bind_methods() {
-	godot::ClassDB::bind_method(godot::D_METHOD("set_rows"), &InteractiveGrid3D::set_rows);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_rows"), &InteractiveGrid3D::get_rows);
+void InteractiveGrid3D::_intersect_custom_cell_data(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Vector3 &p_global_position, godot::LocalVector<int> &r_matches) const {
+	// Indexes of the custom cell data matching a collider, in order.
+	r_matches.clear();
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_columns"), &InteractiveGrid3D::set_columns);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_columns"), &InteractiveGrid3D::get_columns);
+	godot::Ref<godot::PhysicsShapeQueryParameters3D> query;
+	query.instantiate();
+	query->set_shape(data.cell_shape);
+	query->set_transform(godot::Transform3D(godot::Basis(), p_global_position));
+	query->set_collision_mask(UINT32_MAX);
+	query->set_collide_with_bodies(true);
+	query->set_collide_with_areas(true);
 
-	godot::ClassDB::bind_method(godot::D_METHOD("get_size"), &InteractiveGrid3D::get_size);
+	godot::TypedArray<godot::Dictionary> results = p_space_state->intersect_shape(query, 16);
+	for (int k = 0; k < results.size(); k++) {
+		godot::Dictionary hit = results[k];
+		godot::Object *collider_obj = hit["collider"];
+		godot::CollisionObject3D *collision_object =
+				godot::Object::cast_to<godot::CollisionObject3D>(collider_obj);
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_size"), &InteractiveGrid3D::set_cell_size);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_size"), &InteractiveGrid3D::get_cell_size);
+		if (!collision_object) {
+			continue;
+		}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_mesh", "cell_mesh"), &InteractiveGrid3D::set_cell_mesh);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_mesh"), &InteractiveGrid3D::get_cell_mesh);
+		const uint32_t collision_layer = collision_object->get_collision_layer();
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_shape", "cell_shape"), &InteractiveGrid3D::set_cell_shape);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_shape"), &InteractiveGrid3D::get_cell_shape);
+		for (int index = 0; index < data.custom_cell_data.size(); index++) {
+			godot::Ref<CustomCellData> custom_cell_data = data.custom_cell_data.get(index);
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_shape_offset", "cell_shape_offset"), &InteractiveGrid3D::set_cell_shape_offset);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_shape_offset"), &InteractiveGrid3D::get_cell_shape_offset);
+			if (custom_cell_data.is_null()) {
+				continue;
+			}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_rotation", "cell_rotation"), &InteractiveGrid3D::set_cell_rotation);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_rotation"), &InteractiveGrid3D::get_cell_rotation);
+			if (custom_cell_data->get_collision_layer() == 0) {
+				continue;
+			}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_accessible_color"), &InteractiveGrid3D::set_accessible_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_accessible_color"), &InteractiveGrid3D::get_accessible_color);
+			if (custom_cell_data->get_layer_mask() == 0) {
+				continue;
+			}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_unaccessible_color"), &InteractiveGrid3D::set_unaccessible_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_unaccessible_color"), &InteractiveGrid3D::get_unaccessible_color);
+			if (!custom_cell_data->has_layers_in_mask(collision_layer)) {
+				continue;
+			}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_unreachable_color"), &InteractiveGrid3D::set_unreachable_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_unreachable_color"), &InteractiveGrid3D::get_unreachable_color);
+			if (r_matches.find(index) == -1) {
+				r_matches.push_back(index);
+			}
+		}
+	}
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_selected_color"), &InteractiveGrid3D::set_selected_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_selected_color"), &InteractiveGrid3D::get_selected_color);
+godot::Basis InteractiveGrid3D::_get_floor_basis(const godot::Vector3 &p_floor_normal) {
+	godot::Basis basis;
+	basis.set_column(1, p_floor_normal);
+	godot::Vector3 basis_z = basis.get_column(2);
+	godot::Vector3 basis_x = p_floor_normal.cross(basis_z).normalized();
+	basis.set_column(0, basis_x);
+	basis_z = basis_x.cross(p_floor_normal).normalized();
+	basis.set_column(2, basis_z);
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_path_color"), &InteractiveGrid3D::set_path_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_path_color"), &InteractiveGrid3D::get_path_color);
+	return basis.orthonormalized();
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_hovered_color"), &InteractiveGrid3D::set_hovered_color);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_hovered_color"), &InteractiveGrid3D::get_hovered_color);
+void InteractiveGrid3D::_set_cell_floor(int p_cell_index, const godot::Vector3 &p_global_position, const godot::Vector3 &p_floor_normal) {
+	const godot::Transform3D global_transform = data.multimesh_instance->get_global_transform();
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_custom_cells_data"), &InteractiveGrid3D::set_custom_cells_data);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_custom_cells_data"), &InteractiveGrid3D::get_custom_cells_data);
+	godot::Transform3D xform;
+	xform.origin = global_transform.affine_inverse().xform(p_global_position);
+	xform.basis = _get_floor_basis(p_floor_normal);
 
-	godot::ClassDB::bind_method(godot::D_METHOD("add_custom_cell_data", "cell_index", "custom_data_name"), &InteractiveGrid3D::add_custom_cell_data);
-	godot::ClassDB::bind_method(godot::D_METHOD("has_custom_cell_data", "cell_index", "custom_data_name"), &InteractiveGrid3D::has_custom_cell_data);
-	godot::ClassDB::bind_method(godot::D_METHOD("clear_custom_cell_data", "cell_index", "custom_data_name", "clear_custom_color"), &InteractiveGrid3D::clear_custom_cell_data);
-	godot::ClassDB::bind_method(godot::D_METHOD("clear_all_custom_cell_data", "cell_index"), &InteractiveGrid3D::clear_all_custom_cell_data);
+	data.multimesh->set_instance_transform(p_cell_index, xform);
+	data.cells.write[p_cell_index]->local_xform = xform;
+	data.cells.write[p_cell_index]->global_xform = global_transform * xform;
+	data.cells.write[p_cell_index]->floor_normal = p_floor_normal;
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("get_material_override"), &InteractiveGrid3D::get_material_override);
-	godot::ClassDB::bind_method(godot::D_METHOD("set_material_override", "material"), &InteractiveGrid3D::set_material_override);
+void InteractiveGrid3D::_apply_custom_cell_data(int p_cell_index, const godot::LocalVector<int> &p_matches) {
+	Cell *cell = data.cells.write[p_cell_index];
 
-	godot::ClassDB::bind_method(godot::D_METHOD("highlight_on_hover", "global_position"), &InteractiveGrid3D::highlight_on_hover);
-	godot::ClassDB::bind_method(godot::D_METHOD("highlight_path", "path"), &InteractiveGrid3D::highlight_path);
+	for (const int &index : p_matches) {
+		if (index >= data.custom_cell_data.size()) {
+			continue;
+		}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_hover_enabled", "enabled"), &InteractiveGrid3D::set_hover_enabled);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_hover_enabled"), &InteractiveGrid3D::is_hover_enabled);
+		godot::Ref<CustomCellData> custom_cell_data = data.custom_cell_data.get(index);
+		if (custom_cell_data.is_null()) {
+			continue;
+		}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("center", "center_position"), &InteractiveGrid3D::center);
-	godot::ClassDB::bind_method(godot::D_METHOD("update_custom_data"), &InteractiveGrid3D::update_custom_data);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_global_position", "cell_index"), &InteractiveGrid3D::get_cell_global_position);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_index_from_global_position", "global_position"), &InteractiveGrid3D::get_cell_index_from_global_position);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_center_global_position"), &InteractiveGrid3D::get_center_global_position);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_transform", "cell_index"), &InteractiveGrid3D::get_cell_transform);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_global_transform", "cell_index"), &InteractiveGrid3D::get_cell_global_transform);
+		cell->custom_flags |= custom_cell_data->get_layer_mask();
+		cell->flags |= custom_cell_data->get_layer_mask();
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_layout", "layout"), &InteractiveGrid3D::set_layout);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_layout"), &InteractiveGrid3D::get_layout);
+		if (custom_cell_data->get_custom_color_enabled()) {
+			cell->has_custom_color = true;
+			cell->custom_color = custom_cell_data->get_color();
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_movement", "movement"), &InteractiveGrid3D::set_movement);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_movement"), &InteractiveGrid3D::get_movement);
+			set_cell_color(p_cell_index, cell->custom_color);
+		}
+	}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("compute_unreachable_cells", "start_cell_index"), &InteractiveGrid3D::compute_unreachable_cells);
-	godot::ClassDB::bind_method(godot::D_METHOD("hide_distant_cells", "start_cell_index", "distance"), &InteractiveGrid3D::hide_distant_cells);
+	_mark_pathfinding_cell_dirty(p_cell_index); // Custom layers share the cell flags.
+	_update_cell_cost(p_cell_index);
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("is_grid_created"), &InteractiveGrid3D::is_created);
-	godot::ClassDB::bind_method(godot::D_METHOD("reset_cells_state"), &InteractiveGrid3D::reset_cells_state);
+uint32_t InteractiveGrid3D::_pack_custom_cell_data(const godot::LocalVector<int> &p_matches) {
+	// Bit i: the i-th custom cell data matched. Later data do not fit.
+	uint32_t custom_cell_data = 0;
+	for (const int &index : p_matches) {
+		if (index < MAX_STREAMED_CUSTOM_CELL_DATA) {
+			custom_cell_data |= 1u << index;
+		}
+	}
+	return custom_cell_data;
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_accessible", "cell_index"), &InteractiveGrid3D::is_cell_accessible);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_reachable", "cell_index"), &InteractiveGrid3D::is_cell_reachable);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_hovered", "cell_index"), &InteractiveGrid3D::is_cell_hovered);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_selected", "cell_index"), &InteractiveGrid3D::is_cell_selected);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_visible", "cell_index"), &InteractiveGrid3D::is_cell_visible);
+void InteractiveGrid3D::_unpack_custom_cell_data(uint32_t p_custom_cell_data, godot::LocalVector<int> &r_matches) {
+	r_matches.clear();
+	for (int index = 0; index < MAX_STREAMED_CUSTOM_CELL_DATA; index++) {
+		if (p_custom_cell_data & (1u << index)) {
+			r_matches.push_back(index);
+		}
+	}
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_accessible", "cell_index", "is_accessible"), &InteractiveGrid3D::set_cell_accessible);
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_reachable", "cell_index", "set_cell_reachable"), &InteractiveGrid3D::set_cell_reachable);
+void InteractiveGrid3D::_check_streamed_custom_cell_data_count() const {
+	if (data.streaming_enabled && data.custom_cell_data.size() > MAX_STREAMED_CUSTOM_CELL_DATA) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Streamed chunks only record the first ", MAX_STREAMED_CUSTOM_CELL_DATA,
+				" custom cell data, the others are ignored while streaming is enabled.");
+	}
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_color", "cell_index", "color"), &InteractiveGrid3D::set_cell_color);
+uint32_t InteractiveGrid3D::_get_custom_flags(uint32_t p_custom_cell_data) const {
+	uint32_t custom_flags = 0;
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_obstacles_collision_masks", "masks"), &InteractiveGrid3D::set_obstacles_collision_masks);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_obstacles_collision_masks"), &InteractiveGrid3D::get_obstacles_collision_masks);
+	for (int index = 0; index < data.custom_cell_data.size() && index < MAX_STREAMED_CUSTOM_CELL_DATA; index++) {
+		if (!(p_custom_cell_data & (1u << index))) {
+			continue;
+		}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_floor_collision_masks", "masks"), &InteractiveGrid3D::set_floor_collision_mask);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_floor_collision_masks"), &InteractiveGrid3D::get_floor_collision_mask);
+		godot::Ref<CustomCellData> custom_cell_data = data.custom_cell_data.get(index);
+		if (custom_cell_data.is_valid()) {
+			custom_flags |= custom_cell_data->get_layer_mask();
+		}
+	}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("select_cell", "global_position"), &InteractiveGrid3D::select_cell);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_selected_cells"), &InteractiveGrid3D::get_selected_cells);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_latest_selected"), &InteractiveGrid3D::get_latest_selected);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_path", "start_cell_index", "target_cell_index"), &InteractiveGrid3D::get_path);
-	godot::ClassDB::bind_method(godot::D_METHOD("get_neighbors", "cell_index"), &InteractiveGrid3D::get_neighbors);
+	return custom_flags;
+}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_print_logs_enabled", "enabled"), &InteractiveGrid3D::set_print_logs_enabled);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_print_logs_enabled"), &InteractiveGrid3D::is_print_logs_enabled);
+void InteractiveGrid3D::_get_custom_flags_cost(uint32_t p_custom_flags, float &r_multiplier, float &r_edge_cost) const {
+	if (p_custom_flags == 0) {
+		return;
+	}
 
-	godot::ClassDB::bind_method(godot::D_METHOD("set_print_execution_time_enabled", "enabled"), &InteractiveGrid3D::set_print_execution_time_enabled);
-	godot::ClassDB::bind_method(godot::D_METHOD("is_print_execution_time_enabled"), &InteractiveGrid3D::is_print_execution_time_enabled);
+	godot::Ref<CustomCellData> custom_cell_data;
 
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "rows"), "set_rows", "get_rows");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "columns"), "set_columns", "get_columns");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "cell_mesh", godot::PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_cell_mesh", "get_cell_mesh");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "cell_shape", godot::PROPERTY_HINT_RESOURCE_TYPE, "Shape3D"), "set_cell_shape", "get_cell_shape");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR3, "cell_shape_offset"), "set_cell_shape_offset", "get_cell_shape_offset");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR3, "cell_rotation", godot::PROPERTY_HINT_RANGE, "-360,360,0.1,or_less,or_greater,radians_as_degrees", godot::PROPERTY_USAGE_EDITOR), "set_cell_rotation", "get_cell_rotation");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "accessible_color"), "set_accessible_color", "get_accessible_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "unaccessible_color"), "set_unaccessible_color", "get_unaccessible_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "unreachable_color"), "set_unreachable_color", "get_unreachable_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "selected_color"), "set_selected_color", "get_selected_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "path_color"), "set_path_color", "get_path_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "hovered_color"), "set_hovered_color", "get_hovered_color");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::ARRAY, "custom_cells_data", godot::PROPERTY_HINT_RESOURCE_TYPE, "CustomCellData"), "set_custom_cells_data", "get_custom_cells_data");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "material_override", godot::PROPERTY_HINT_RESOURCE_TYPE, "Material"), "set_material_override", "get_material_override");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "layout", godot::PROPERTY_HINT_ENUM, "SQUARE, HEXAGONAL"), "set_layout", "get_layout");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "movement", godot::PROPERTY_HINT_ENUM, "FOUR-DIRECTIONS,SIX-DIRECTIONS,EIGH-DIRECTIONS"), "set_movement", "get_movement");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "obstacles_collision_masks", godot::PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_obstacles_collision_masks", "get_obstacles_collision_masks");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "floor_collision_masks", godot::PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_floor_collision_masks", "get_floor_collision_masks");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "print_logs_enabled"), "set_print_logs_enabled", "is_print_logs_enabled");
-	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "print_execution_time_enabled"), "set_print_execution_time_enabled", "is_print_execution_time_enabled");
+	for (int index = 0; index < data.custom_cell_data.size(); index++) {
+		custom_cell_data = data.custom_cell_data.get(index);
 
-	BIND_ENUM_CONSTANT(LAYOUT_SQUARE);
-	BIND_ENUM_CONSTANT(LAYOUT_HEXAGONAL);
+		if (custom_cell_data.is_null()) {
+			continue;
+		}
 
-	BIND_ENUM_CONSTANT(MOVEMENT_FOUR_DIRECTIONS);
-	BIND_ENUM_CONSTANT(MOVEMENT_SIX_DIRECTIONS);
-	BIND_ENUM_CONSTANT(MOVEMENT_EIGH_DIRECTIONS);
-}
+		const uint32_t layer_mask = custom_cell_data->get_layer_mask();
+		if (layer_mask == 0 || (p_custom_flags & layer_mask) != layer_mask) {
+			continue;
+		}
 
-void InteractiveGrid3D::_ready() {
+		r_multiplier *= custom_cell_data->get_traversal_cost();
+		r_edge_cost += custom_cell_data->get_edge_cost();
+	}
 }
 
-void InteractiveGrid3D::_physics_process(double p_delta) {
-	_create();
+uint64_t InteractiveGrid3D::_get_streaming_signature() const {
+	// Every setting a chunk scan depends on: cached chunks scanned with other
+	// settings are dropped. Shapes are not compared, clear_streaming_cache()
+	// must be called after changing them.
+	uint64_t signature = 14695981039346656037ULL;
 
-	if (godot::Engine::get_singleton()->is_editor_hint()) {
-		if (data.center_global_position != get_global_transform().origin) {
-			_delete();
+	hash_streaming_setting(signature, static_cast<uint64_t>(data.layout_index));
+	hash_streaming_setting(signature, data.cell_size.x);
+	hash_streaming_setting(signature, data.cell_size.y);
+	hash_streaming_setting(signature, data.cell_rotation.x);
+	hash_streaming_setting(signature, data.cell_rotation.y);
+	hash_streaming_setting(signature, data.cell_rotation.z);
+	hash_streaming_setting(signature, static_cast<uint64_t>(data.floor_collision_mask));
+	hash_streaming_setting(signature, static_cast<uint64_t>(data.obstacles_collision_masks));
+	hash_streaming_setting(signature, static_cast<uint64_t>(data.cell_mesh.is_valid() && data.cell_shape.is_valid()));
+	hash_streaming_setting(signature, static_cast<uint64_t>(data.custom_cell_data.size()));
+
+	for (int index = 0; index < data.custom_cell_data.size(); index++) {
+		godot::Ref<CustomCellData> custom_cell_data = data.custom_cell_data.get(index);
+
+		if (custom_cell_data.is_null()) {
+			hash_streaming_setting(signature, static_cast<uint64_t>(0));
+			continue;
 		}
+
+		hash_streaming_setting(signature, static_cast<uint64_t>(custom_cell_data->get_collision_layer()));
+		hash_streaming_setting(signature, static_cast<uint64_t>(custom_cell_data->get_layer_mask()));
 	}
+
+	return signature;
 }
 
-void InteractiveGrid3D::set_rows(int p_rows) {
-	data.rows = p_rows;
-	_delete();
+void InteractiveGrid3D::_configure_chunk_store() {
+	data.chunk_streamer.get_store().configure(data.chunk_size, _get_streaming_signature());
+
+	if (data.streaming_cache_path.is_empty() || data.streaming_cache_file_failed || data.chunk_streamer.get_store().is_file_open()) {
+		return;
+	}
+
+	const godot::String path = godot::ProjectSettings::get_singleton()->globalize_path(data.streaming_cache_path);
+
+	if (!data.chunk_streamer.get_store().open_file(path.utf8().get_data())) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cannot open the streaming cache file: ", path);
+		data.streaming_cache_file_failed = true; // Not retried until the path changes.
+	}
 }
 
-int InteractiveGrid3D::get_rows(void) const {
-	return data.rows;
+godot::Vector3 InteractiveGrid3D::_snap_to_world_cells(const godot::Vector3 &p_center_position, int &r_column, int &r_row) const {
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+
+	godot::Vector2 top_left_offset;
+	grid_layout_center_to_top_left(hexagonal, data.columns, data.rows, data.cell_size.x, data.cell_size.y,
+			top_left_offset.x, top_left_offset.y);
+
+	r_row = static_cast<int>(std::floor((p_center_position.z + top_left_offset.y) / data.cell_size.y + 0.5f));
+	if (hexagonal && (r_row % 2)) {
+		r_row--; // The odd rows of the grid stay odd world rows, shifted the same way.
+	}
+	r_column = static_cast<int>(std::floor((p_center_position.x + top_left_offset.x) / data.cell_size.x + 0.5f));
+
+	return godot::Vector3(r_column * data.cell_size.x - top_left_offset.x, p_center_position.y,
+			r_row * data.cell_size.y - top_left_offset.y);
 }
 
-void InteractiveGrid3D::set_columns(int p_columns) {
-	data.columns = p_columns;
-	_delete();
+void InteractiveGrid3D::_scan_chunk(godot::PhysicsDirectSpaceState3D *p_space_state, int p_chunk_x, int p_chunk_z, float p_reference_height, GridChunkCell *r_cells) {
+	// Same queries as _align_cells_with_floor and the environment scans, on
+	// world cells instead of grid cells.
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+	const int chunk_size = data.chunk_streamer.get_store().get_chunk_size();
+
+	const bool scan_shapes = data.cell_mesh.is_valid() && data.cell_shape.is_valid();
+	const bool scan_obstacles = scan_shapes && data.obstacles_collision_masks != 0;
+
+	const godot::Basis global_basis = data.multimesh_instance->get_global_transform().basis;
+
+	godot::Basis rotation_basis;
+	rotation_basis = rotation_basis.rotated(godot::Vector3(1, 0, 0), data.cell_rotation.x);
+	rotation_basis = rotation_basis.rotated(godot::Vector3(0, 1, 0), data.cell_rotation.y);
+	rotation_basis = rotation_basis.rotated(godot::Vector3(0, 0, 1), data.cell_rotation.z);
+
+	godot::LocalVector<int> matches;
+
+	for (int local_row = 0; local_row < chunk_size; local_row++) {
+		for (int local_column = 0; local_column < chunk_size; local_column++) {
+			const int column = p_chunk_x * chunk_size + local_column;
+			const int row = p_chunk_z * chunk_size + local_row;
+
+			godot::Vector2 cell_position;
+			grid_layout_cell_offset(hexagonal, column, row, data.cell_size.x, data.cell_size.y, cell_position.x, cell_position.y);
+
+			GridChunkCell &cell = r_cells[local_row * chunk_size + local_column];
+			cell.height = p_reference_height;
+
+			godot::Transform3D cell_xform(global_basis * rotation_basis,
+					godot::Vector3(cell_position.x, p_reference_height, cell_position.y));
+
+			if (data.floor_collision_mask != 0) {
+				godot::Vector3 hit_position;
+				godot::Vector3 floor_normal;
+
+				switch (_intersect_floor(p_space_state, cell_xform.origin, hit_position, floor_normal)) {
+					case FLOOR_HIT:
+						cell.flags |= GridChunkStore::CELL_FLOOR;
+						cell.height = hit_position.y;
+						cell.normal_x = floor_normal.x;
+						cell.normal_y = floor_normal.y;
+						cell.normal_z = floor_normal.z;
+						cell_xform = godot::Transform3D(global_basis * _get_floor_basis(floor_normal), hit_position);
+						break;
+					case FLOOR_MISSED:
+						cell.flags |= GridChunkStore::CELL_VOID;
+						break;
+					case FLOOR_HIDDEN:
+						break;
+				}
+			}
+
+			if (scan_obstacles && _intersects_obstacle(p_space_state, cell_xform)) {
+				cell.flags |= GridChunkStore::CELL_OBSTACLE;
+			}
+
+			if (scan_shapes && !(cell.flags & GridChunkStore::CELL_VOID)) {
+				_intersect_custom_cell_data(p_space_state, cell_xform.origin, matches);
+				cell.custom_data = _pack_custom_cell_data(matches);
+			}
+		}
+	}
 }
 
-int InteractiveGrid3D::get_columns() const {
-	return data.columns;
+const GridChunkCell *InteractiveGrid3D::_acquire_chunk(int p_chunk_x, int p_chunk_z, float p_reference_height) {
+	const GridChunkCell *cached_cells = data.chunk_streamer.acquire(p_chunk_x, p_chunk_z);
+	if (cached_cells) {
+		return cached_cells;
+	}
+
+	if (!is_inside_tree()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid is not in the scene tree, chunks cannot be scanned.");
+		return nullptr;
+	}
+
+	godot::PhysicsDirectSpaceState3D *space_state = get_world_3d()->get_direct_space_state();
+
+	if (!space_state) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "No PhysicsDirectSpaceState3D available.");
+		return nullptr;
+	}
+
+	GridChunkStore &chunk_store = data.chunk_streamer.get_store();
+	auto start = std::chrono::high_resolution_clock::now();
+
+	GridChunkCell *chunk_cells = chunk_store.create(p_chunk_x, p_chunk_z);
+	_scan_chunk(space_state, p_chunk_x, p_chunk_z, p_reference_height, chunk_cells);
+
+	const bool file_open = chunk_store.is_file_open();
+	chunk_store.store(p_chunk_x, p_chunk_z);
+
+	if (file_open && !chunk_store.is_file_open()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The streaming cache file cannot grow, chunks are no longer saved: ", data.streaming_cache_path);
+		data.streaming_cache_file_failed = true;
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_CHUNK_SCAN, start, end, chunk_store.get_cells_per_chunk());
+
+	if (_debug_options.print_logs_enabled) {
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Chunk scanned: ", godot::Vector2i(p_chunk_x, p_chunk_z));
+	}
+
+	return chunk_cells;
 }
 
-int InteractiveGrid3D::get_size() const {
-	return data.rows * data.columns;
+void InteractiveGrid3D::_apply_streamed_cells() {
+	const bool editor_hint = godot::Engine::get_singleton()->is_editor_hint();
+
+	// Consecutive cells mostly share a chunk: it is only acquired again when
+	// the chunk changes, which keeps the previous pointer valid meanwhile.
+	const GridChunkCell *chunk_cells = nullptr;
+	int chunk_x = 0;
+	int chunk_z = 0;
+
+	godot::LocalVector<int> matches;
+
+	for (int row = 0; row < data.rows; row++) {
+		for (int column = 0; column < data.columns; column++) {
+			const int index = row * data.columns + column;
+
+			int cell_chunk_x = 0;
+			int cell_chunk_z = 0;
+			const int chunk_cell_index = data.chunk_streamer.get_store().get_cell_chunk(data.streamed_column + column, data.streamed_row + row,
+					cell_chunk_x, cell_chunk_z);
+
+			if (chunk_cells == nullptr || cell_chunk_x != chunk_x || cell_chunk_z != chunk_z) {
+				chunk_x = cell_chunk_x;
+				chunk_z = cell_chunk_z;
+				chunk_cells = _acquire_chunk(chunk_x, chunk_z, data.center_global_position.y);
+
+				if (chunk_cells == nullptr) {
+					return;
+				}
+			}
+
+			const GridChunkCell &cell = chunk_cells[chunk_cell_index];
+
+			if (cell.flags & GridChunkStore::CELL_FLOOR) {
+				godot::Vector3 floor_position = data.cells[index]->global_xform.origin;
+				floor_position.y = cell.height;
+				_set_cell_floor(index, floor_position, godot::Vector3(cell.normal_x, cell.normal_y, cell.normal_z));
+
+				set_cell_accessible(index, true);
+				set_cell_reachable(index, true);
+				set_cell_visible(index, true);
+			} else if (cell.flags & GridChunkStore::CELL_VOID) {
+				if (!editor_hint) {
+					data.cells.write[index]->floor_normal = godot::Vector3(0.0f, 1.0f, 0.0f);
+					_set_cell_in_void(index, true);
+					set_cell_accessible(index, false);
+				} else {
+					set_cell_accessible(index, true);
+					set_cell_reachable(index, true);
+					set_cell_visible(index, true);
+				}
+			}
+
+			if (cell.flags & GridChunkStore::CELL_OBSTACLE) {
+				set_cell_accessible(index, false);
+				set_cell_opaque(index, true);
+			}
+
+			if (cell.custom_data != 0 && !is_cell_in_void(index)) {
+				_unpack_custom_cell_data(cell.custom_data, matches);
+				_apply_custom_cell_data(index, matches);
+			}
+		}
+	}
+
+	// Heights and slopes feed the step costs and connectivity.
+	data.flags |= GFL_PATHFINDER_DIRTY;
+	_invalidate_search_caches();
 }
 
-void InteractiveGrid3D::set_cell_size(godot::Vector2 p_cell_size) {
-	data.cell_size = p_cell_size;
-	_delete();
+void InteractiveGrid3D::_apply_material(const godot::Ref<godot::Material> &p_material) {
+	if (data.multimesh_instance == nullptr) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "No MultiMeshInstance found.");
+		return;
+	}
+
+	if (p_material.is_null()) {
+		data.multimesh_instance->set_material_override(nullptr);
+		apply_default_material();
+		return;
+	} else {
+		data.multimesh_instance->set_material_override(p_material);
+	}
 }
 
-godot::Vector2 InteractiveGrid3D::get_cell_size(void) const {
-	return data.cell_size;
+void InteractiveGrid3D::_set_cell_in_void(int p_cell_index, bool p_is_in_void) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	if (p_is_in_void) {
+		data.cells.write[p_cell_index]->flags |= CFL_IN_VOID;
+		set_cell_visible(p_cell_index, false);
+	} else if (!p_is_in_void) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_IN_VOID;
+	}
 }
 
-void InteractiveGrid3D::set_cell_mesh(const godot::Ref<godot::Mesh> &p_mesh) {
-	if (p_mesh == data.cell_mesh) {
+void InteractiveGrid3D::_set_cell_hovered(int p_cell_index, bool p_is_hovered) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
 		return;
 	}
 
-	data.cell_mesh = p_mesh;
-	_delete();
+	if (p_is_hovered) {
+		data.cells.write[p_cell_index]->flags |= CFL_HOVERED;
+		set_cell_color(data.hovered_cell_index, data.hovered_color);
+	} else if (!p_is_hovered) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_HOVERED;
+	}
 }
 
-godot::Ref<godot::Mesh> InteractiveGrid3D::get_cell_mesh() const {
-	return data.cell_mesh;
+void InteractiveGrid3D::_set_cell_selected(int p_cell_index, bool p_is_selected) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	if (p_is_selected) {
+		data.cells.write[p_cell_index]->flags |= CFL_SELECTED;
+		set_cell_color(p_cell_index, data.selected_color);
+	} else if (!p_is_selected) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_SELECTED;
+	}
+}
+
+void InteractiveGrid3D::_set_cell_on_path(int p_cell_index, bool p_is_on_path) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	if (p_is_on_path) {
+		data.cells.write[p_cell_index]->flags |= CFL_PATH;
+		set_cell_color(p_cell_index, data.path_color);
+	} else if (!p_is_on_path) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_PATH;
+	}
+}
+
+void InteractiveGrid3D::_restore_cell_color(int p_cell_index) {
+	const Cell *cell = data.cells[p_cell_index];
+
+	if (cell->flags & CFL_SELECTED) {
+		set_cell_color(p_cell_index, data.selected_color);
+	} else if (cell->flags & CFL_HOVERED) {
+		set_cell_color(p_cell_index, data.hovered_color);
+	} else if (!(cell->flags & CFL_ACCESSIBLE)) {
+		set_cell_color(p_cell_index, data.unaccessible_color);
+	} else if (!(cell->flags & CFL_REACHABLE)) {
+		set_cell_color(p_cell_index, data.unreachable_color);
+	} else if (cell->has_custom_color) {
+		set_cell_color(p_cell_index, cell->custom_color);
+	} else {
+		set_cell_color(p_cell_index, data.accessible_color);
+	}
+
+	if (!(cell->flags & CFL_VISIBLE)) {
+		set_cell_visible(p_cell_index, false);
+	}
+}
+
+void InteractiveGrid3D::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("set_rows"), &InteractiveGrid3D::set_rows);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_rows"), &InteractiveGrid3D::get_rows);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_columns"), &InteractiveGrid3D::set_columns);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_columns"), &InteractiveGrid3D::get_columns);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_size"), &InteractiveGrid3D::get_size);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_size"), &InteractiveGrid3D::set_cell_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_size"), &InteractiveGrid3D::get_cell_size);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_mesh", "cell_mesh"), &InteractiveGrid3D::set_cell_mesh);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_mesh"), &InteractiveGrid3D::get_cell_mesh);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_shape", "cell_shape"), &InteractiveGrid3D::set_cell_shape);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_shape"), &InteractiveGrid3D::get_cell_shape);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_shape_offset", "cell_shape_offset"), &InteractiveGrid3D::set_cell_shape_offset);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_shape_offset"), &InteractiveGrid3D::get_cell_shape_offset);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_rotation", "cell_rotation"), &InteractiveGrid3D::set_cell_rotation);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_rotation"), &InteractiveGrid3D::get_cell_rotation);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_accessible_color"), &InteractiveGrid3D::set_accessible_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_accessible_color"), &InteractiveGrid3D::get_accessible_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_unaccessible_color"), &InteractiveGrid3D::set_unaccessible_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_unaccessible_color"), &InteractiveGrid3D::get_unaccessible_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_unreachable_color"), &InteractiveGrid3D::set_unreachable_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_unreachable_color"), &InteractiveGrid3D::get_unreachable_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_selected_color"), &InteractiveGrid3D::set_selected_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_selected_color"), &InteractiveGrid3D::get_selected_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_path_color"), &InteractiveGrid3D::set_path_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path_color"), &InteractiveGrid3D::get_path_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_hovered_color"), &InteractiveGrid3D::set_hovered_color);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_hovered_color"), &InteractiveGrid3D::get_hovered_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_custom_cells_data"), &InteractiveGrid3D::set_custom_cells_data);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_custom_cells_data"), &InteractiveGrid3D::get_custom_cells_data);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("add_custom_cell_data", "cell_index", "custom_data_name"), &InteractiveGrid3D::add_custom_cell_data);
+	godot::ClassDB::bind_method(godot::D_METHOD("has_custom_cell_data", "cell_index", "custom_data_name"), &InteractiveGrid3D::has_custom_cell_data);
+	godot::ClassDB::bind_method(godot::D_METHOD("clear_custom_cell_data", "cell_index", "custom_data_name", "clear_custom_color"), &InteractiveGrid3D::clear_custom_cell_data);
+	godot::ClassDB::bind_method(godot::D_METHOD("clear_all_custom_cell_data", "cell_index"), &InteractiveGrid3D::clear_all_custom_cell_data);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_material_override"), &InteractiveGrid3D::get_material_override);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_material_override", "material"), &InteractiveGrid3D::set_material_override);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("highlight_on_hover", "global_position"), &InteractiveGrid3D::highlight_on_hover);
+	godot::ClassDB::bind_method(godot::D_METHOD("highlight_path", "path"), &InteractiveGrid3D::highlight_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_highlighted_path", "path"), &InteractiveGrid3D::set_highlighted_path);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_hover_enabled", "enabled"), &InteractiveGrid3D::set_hover_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_hover_enabled"), &InteractiveGrid3D::is_hover_enabled);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("center", "center_position"), &InteractiveGrid3D::center);
+	godot::ClassDB::bind_method(godot::D_METHOD("update_custom_data"), &InteractiveGrid3D::update_custom_data);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_global_position", "cell_index"), &InteractiveGrid3D::get_cell_global_position);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_index_from_global_position", "global_position"), &InteractiveGrid3D::get_cell_index_from_global_position);
+	godot::ClassDB::bind_method(godot::D_METHOD("pick_cell_from_ray", "origin", "direction"), &InteractiveGrid3D::pick_cell_from_ray);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_center_global_position"), &InteractiveGrid3D::get_center_global_position);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_transform", "cell_index"), &InteractiveGrid3D::get_cell_transform);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_global_transform", "cell_index"), &InteractiveGrid3D::get_cell_global_transform);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_layout", "layout"), &InteractiveGrid3D::set_layout);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_layout"), &InteractiveGrid3D::get_layout);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_movement", "movement"), &InteractiveGrid3D::set_movement);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_movement"), &InteractiveGrid3D::get_movement);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_jump_point_search_enabled", "enabled"), &InteractiveGrid3D::set_jump_point_search_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_jump_point_search_enabled"), &InteractiveGrid3D::is_jump_point_search_enabled);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_hierarchical_pathfinding_enabled", "enabled"), &InteractiveGrid3D::set_hierarchical_pathfinding_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_hierarchical_pathfinding_enabled"), &InteractiveGrid3D::is_hierarchical_pathfinding_enabled);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cluster_size", "cluster_size"), &InteractiveGrid3D::set_cluster_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cluster_size"), &InteractiveGrid3D::get_cluster_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_max_step_height", "max_step_height"), &InteractiveGrid3D::set_max_step_height);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_max_step_height"), &InteractiveGrid3D::get_max_step_height);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_max_slope", "max_slope"), &InteractiveGrid3D::set_max_slope);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_max_slope"), &InteractiveGrid3D::get_max_slope);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_path_cache_size", "path_cache_size"), &InteractiveGrid3D::set_path_cache_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path_cache_size"), &InteractiveGrid3D::get_path_cache_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_path_requests_per_frame", "path_requests_per_frame"), &InteractiveGrid3D::set_path_requests_per_frame);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path_requests_per_frame"), &InteractiveGrid3D::get_path_requests_per_frame);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_enabled", "enabled"), &InteractiveGrid3D::set_streaming_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_streaming_enabled"), &InteractiveGrid3D::is_streaming_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_chunk_size", "chunk_size"), &InteractiveGrid3D::set_chunk_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_chunk_size"), &InteractiveGrid3D::get_chunk_size);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_radius", "radius"), &InteractiveGrid3D::set_streaming_radius);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_radius"), &InteractiveGrid3D::get_streaming_radius);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_memory_budget", "megabytes"), &InteractiveGrid3D::set_streaming_memory_budget);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_memory_budget"), &InteractiveGrid3D::get_streaming_memory_budget);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_chunks_per_update", "chunks"), &InteractiveGrid3D::set_streaming_chunks_per_update);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_chunks_per_update"), &InteractiveGrid3D::get_streaming_chunks_per_update);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_cache_path", "path"), &InteractiveGrid3D::set_streaming_cache_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_cache_path"), &InteractiveGrid3D::get_streaming_cache_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_streaming_focus_points", "points"), &InteractiveGrid3D::set_streaming_focus_points);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_focus_points"), &InteractiveGrid3D::get_streaming_focus_points);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("compute_unreachable_cells", "start_cell_index"), &InteractiveGrid3D::compute_unreachable_cells);
+	godot::ClassDB::bind_method(godot::D_METHOD("compute_unreachable_cells_from", "start_cell_indexes"), &InteractiveGrid3D::compute_unreachable_cells_from);
+	godot::ClassDB::bind_method(godot::D_METHOD("compute_fov", "origin_cell_index", "radius"), &InteractiveGrid3D::compute_fov);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cells_in_radius", "origin_cell_index", "radius"), &InteractiveGrid3D::get_cells_in_radius);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cells_in_ring", "origin_cell_index", "radius"), &InteractiveGrid3D::get_cells_in_ring);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cells_on_line", "from_cell_index", "to_cell_index"), &InteractiveGrid3D::get_cells_on_line);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cells_in_cone", "origin_cell_index", "direction", "angle", "radius"), &InteractiveGrid3D::get_cells_in_cone);
+	godot::ClassDB::bind_method(godot::D_METHOD("hide_distant_cells", "start_cell_index", "distance"), &InteractiveGrid3D::hide_distant_cells);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("is_grid_created"), &InteractiveGrid3D::is_created);
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_cells_state"), &InteractiveGrid3D::reset_cells_state);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_accessible", "cell_index"), &InteractiveGrid3D::is_cell_accessible);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_reachable", "cell_index"), &InteractiveGrid3D::is_cell_reachable);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_hovered", "cell_index"), &InteractiveGrid3D::is_cell_hovered);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_selected", "cell_index"), &InteractiveGrid3D::is_cell_selected);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_visible", "cell_index"), &InteractiveGrid3D::is_cell_visible);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_cell_opaque", "cell_index"), &InteractiveGrid3D::is_cell_opaque);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_accessible", "cell_index", "is_accessible"), &InteractiveGrid3D::set_cell_accessible);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_reachable", "cell_index", "set_cell_reachable"), &InteractiveGrid3D::set_cell_reachable);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_opaque", "cell_index", "is_opaque"), &InteractiveGrid3D::set_cell_opaque);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_color", "cell_index", "color"), &InteractiveGrid3D::set_cell_color);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_costs", "costs"), &InteractiveGrid3D::set_cell_costs);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_costs"), &InteractiveGrid3D::get_cell_costs);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_cell_cost", "cell_index", "cost"), &InteractiveGrid3D::set_cell_cost);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_cost", "cell_index"), &InteractiveGrid3D::get_cell_cost);
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_cell_costs"), &InteractiveGrid3D::reset_cell_costs);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_obstacles_collision_masks", "masks"), &InteractiveGrid3D::set_obstacles_collision_masks);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_obstacles_collision_masks"), &InteractiveGrid3D::get_obstacles_collision_masks);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_floor_collision_masks", "masks"), &InteractiveGrid3D::set_floor_collision_mask);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_floor_collision_masks"), &InteractiveGrid3D::get_floor_collision_mask);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("select_cell", "global_position"), &InteractiveGrid3D::select_cell);
+	godot::ClassDB::bind_method(godot::D_METHOD("select_cells", "cell_indexes"), &InteractiveGrid3D::select_cells);
+	godot::ClassDB::bind_method(godot::D_METHOD("select_rect", "from_cell_index", "to_cell_index"), &InteractiveGrid3D::select_rect);
+	godot::ClassDB::bind_method(godot::D_METHOD("select_polygon", "polygon"), &InteractiveGrid3D::select_polygon);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_selected_cells"), &InteractiveGrid3D::get_selected_cells);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_selected_cell_indexes"), &InteractiveGrid3D::get_selected_cell_indexes);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_latest_selected"), &InteractiveGrid3D::get_latest_selected);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path", "start_cell_index", "target_cell_index"), &InteractiveGrid3D::get_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_world_path", "start_cell_index", "target_cell_index", "smooth"), &InteractiveGrid3D::get_world_path, DEFVAL(false));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_paths", "start_cell_index", "target_cell_indexes"), &InteractiveGrid3D::get_paths);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cooperative_paths", "start_cell_indexes", "target_cell_indexes", "max_time_steps"), &InteractiveGrid3D::get_cooperative_paths, DEFVAL(0));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_topology_version"), &InteractiveGrid3D::get_topology_version);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path_cache_stats"), &InteractiveGrid3D::get_path_cache_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("clear_path_cache"), &InteractiveGrid3D::clear_path_cache);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_profile_stats"), &InteractiveGrid3D::get_profile_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_profile_stats"), &InteractiveGrid3D::reset_profile_stats);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("get_memory_usage"), &InteractiveGrid3D::get_memory_usage);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("update_streaming"), &InteractiveGrid3D::update_streaming);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streamed_cell", "global_position"), &InteractiveGrid3D::get_streamed_cell);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streamed_path", "from", "to"), &InteractiveGrid3D::get_streamed_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_streaming_stats"), &InteractiveGrid3D::get_streaming_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("clear_streaming_cache"), &InteractiveGrid3D::clear_streaming_cache);
+
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("start_trace", "capacity"), &InteractiveGrid3D::start_trace, DEFVAL(65536));
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("stop_trace"), &InteractiveGrid3D::stop_trace);
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("clear_trace"), &InteractiveGrid3D::clear_trace);
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("is_trace_enabled"), &InteractiveGrid3D::is_trace_enabled);
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("get_trace_json"), &InteractiveGrid3D::get_trace_json);
+	godot::ClassDB::bind_static_method("InteractiveGrid3D", godot::D_METHOD("save_trace", "path"), &InteractiveGrid3D::save_trace);
+	godot::ClassDB::bind_method(godot::D_METHOD("request_path", "start_cell_index", "target_cell_index"), &InteractiveGrid3D::request_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_path_request_status", "request_id"), &InteractiveGrid3D::get_path_request_status);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_requested_path", "request_id"), &InteractiveGrid3D::get_requested_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("cancel_path_request", "request_id"), &InteractiveGrid3D::cancel_path_request);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_reachable_cells", "start_cell_index", "max_cost"), &InteractiveGrid3D::get_reachable_cells);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_reachable_path", "target_cell_index"), &InteractiveGrid3D::get_reachable_path);
+	godot::ClassDB::bind_method(godot::D_METHOD("build_flow_field", "target_cell_index"), &InteractiveGrid3D::build_flow_field);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_neighbors", "cell_index"), &InteractiveGrid3D::get_neighbors);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("offset_to_axial", "offset"), &InteractiveGrid3D::offset_to_axial);
+	godot::ClassDB::bind_method(godot::D_METHOD("axial_to_offset", "axial"), &InteractiveGrid3D::axial_to_offset);
+	godot::ClassDB::bind_method(godot::D_METHOD("axial_to_cube", "axial"), &InteractiveGrid3D::axial_to_cube);
+	godot::ClassDB::bind_method(godot::D_METHOD("cube_to_axial", "cube"), &InteractiveGrid3D::cube_to_axial);
+	godot::ClassDB::bind_method(godot::D_METHOD("offset_to_cube", "offset"), &InteractiveGrid3D::offset_to_cube);
+	godot::ClassDB::bind_method(godot::D_METHOD("cube_to_offset", "cube"), &InteractiveGrid3D::cube_to_offset);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_cube_coordinates", "cell_index"), &InteractiveGrid3D::get_cell_cube_coordinates);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_cell_index_from_cube_coordinates", "cube"), &InteractiveGrid3D::get_cell_index_from_cube_coordinates);
+	godot::ClassDB::bind_method(godot::D_METHOD("hex_distance", "cell_index_a", "cell_index_b"), &InteractiveGrid3D::hex_distance);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_print_logs_enabled", "enabled"), &InteractiveGrid3D::set_print_logs_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_print_logs_enabled"), &InteractiveGrid3D::is_print_logs_enabled);
+
+	godot::ClassDB::bind_method(godot::D_METHOD("set_print_execution_time_enabled", "enabled"), &InteractiveGrid3D::set_print_execution_time_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_print_execution_time_enabled"), &InteractiveGrid3D::is_print_execution_time_enabled);
+
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "rows"), "set_rows", "get_rows");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "columns"), "set_columns", "get_columns");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "cell_mesh", godot::PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_cell_mesh", "get_cell_mesh");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "cell_shape", godot::PROPERTY_HINT_RESOURCE_TYPE, "Shape3D"), "set_cell_shape", "get_cell_shape");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR3, "cell_shape_offset"), "set_cell_shape_offset", "get_cell_shape_offset");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::VECTOR3, "cell_rotation", godot::PROPERTY_HINT_RANGE, "-360,360,0.1,or_less,or_greater,radians_as_degrees", godot::PROPERTY_USAGE_EDITOR), "set_cell_rotation", "get_cell_rotation");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "accessible_color"), "set_accessible_color", "get_accessible_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "unaccessible_color"), "set_unaccessible_color", "get_unaccessible_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "unreachable_color"), "set_unreachable_color", "get_unreachable_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "selected_color"), "set_selected_color", "get_selected_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "path_color"), "set_path_color", "get_path_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::COLOR, "hovered_color"), "set_hovered_color", "get_hovered_color");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::ARRAY, "custom_cells_data", godot::PROPERTY_HINT_RESOURCE_TYPE, "CustomCellData"), "set_custom_cells_data", "get_custom_cells_data");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "material_override", godot::PROPERTY_HINT_RESOURCE_TYPE, "Material"), "set_material_override", "get_material_override");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "layout", godot::PROPERTY_HINT_ENUM, "SQUARE, HEXAGONAL"), "set_layout", "get_layout");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "movement", godot::PROPERTY_HINT_ENUM, "FOUR-DIRECTIONS,SIX-DIRECTIONS,EIGH-DIRECTIONS"), "set_movement", "get_movement");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "jump_point_search_enabled"), "set_jump_point_search_enabled", "is_jump_point_search_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "hierarchical_pathfinding_enabled"), "set_hierarchical_pathfinding_enabled", "is_hierarchical_pathfinding_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "cluster_size", godot::PROPERTY_HINT_RANGE, "4,128,1"), "set_cluster_size", "get_cluster_size");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "max_step_height", godot::PROPERTY_HINT_RANGE, "0,100,0.01,or_greater,suffix:m"), "set_max_step_height", "get_max_step_height");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "max_slope", godot::PROPERTY_HINT_RANGE, "0,90,0.1,degrees"), "set_max_slope", "get_max_slope");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "path_cache_size", godot::PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_path_cache_size", "get_path_cache_size");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "path_requests_per_frame", godot::PROPERTY_HINT_RANGE, "1,1024,1,or_greater"), "set_path_requests_per_frame", "get_path_requests_per_frame");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "streaming_enabled"), "set_streaming_enabled", "is_streaming_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "chunk_size", godot::PROPERTY_HINT_RANGE, "2,256,2,or_greater"), "set_chunk_size", "get_chunk_size");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "streaming_radius", godot::PROPERTY_HINT_RANGE, "0,16,1,or_greater"), "set_streaming_radius", "get_streaming_radius");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "streaming_memory_budget", godot::PROPERTY_HINT_RANGE, "1,4096,1,or_greater,suffix:MiB"), "set_streaming_memory_budget", "get_streaming_memory_budget");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "streaming_chunks_per_update", godot::PROPERTY_HINT_RANGE, "1,64,1,or_greater"), "set_streaming_chunks_per_update", "get_streaming_chunks_per_update");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::STRING, "streaming_cache_path", godot::PROPERTY_HINT_SAVE_FILE, "*.chunks"), "set_streaming_cache_path", "get_streaming_cache_path");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::PACKED_VECTOR3_ARRAY, "streaming_focus_points"), "set_streaming_focus_points", "get_streaming_focus_points");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "obstacles_collision_masks", godot::PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_obstacles_collision_masks", "get_obstacles_collision_masks");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "floor_collision_masks", godot::PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_floor_collision_masks", "get_floor_collision_masks");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "print_logs_enabled"), "set_print_logs_enabled", "is_print_logs_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "print_execution_time_enabled"), "set_print_execution_time_enabled", "is_print_execution_time_enabled");
+
+	BIND_ENUM_CONSTANT(LAYOUT_SQUARE);
+	BIND_ENUM_CONSTANT(LAYOUT_HEXAGONAL);
+
+	BIND_ENUM_CONSTANT(MOVEMENT_FOUR_DIRECTIONS);
+	BIND_ENUM_CONSTANT(MOVEMENT_SIX_DIRECTIONS);
+	BIND_ENUM_CONSTANT(MOVEMENT_EIGH_DIRECTIONS);
+
+	BIND_ENUM_CONSTANT(PATH_REQUEST_UNKNOWN);
+	BIND_ENUM_CONSTANT(PATH_REQUEST_PENDING);
+	BIND_ENUM_CONSTANT(PATH_REQUEST_RUNNING);
+	BIND_ENUM_CONSTANT(PATH_REQUEST_DONE);
+
+	ADD_SIGNAL(godot::MethodInfo("path_ready", godot::PropertyInfo(godot::Variant::INT, "request_id"), godot::PropertyInfo(godot::Variant::PACKED_INT64_ARRAY, "path")));
+}
+
+void InteractiveGrid3D::_ready() {
+}
+
+void InteractiveGrid3D::_enter_tree() {
+	_register_profile_monitors();
+}
+
+void InteractiveGrid3D::_exit_tree() {
+	_unregister_profile_monitors();
+}
+
+void InteractiveGrid3D::_register_profile_monitors() {
+	if (godot::Engine::get_singleton()->is_editor_hint()) {
+		return;
+	}
+
+	godot::Performance *performance = godot::Performance::get_singleton();
+
+	// Monitors are grouped by grid in the debugger, the instance id keeps
+	// grids sharing a node name apart.
+	godot::String category = godot::String("InteractiveGrid3D ") + godot::String(get_name());
+	if (performance->has_custom_monitor(category + "/" + GridProfiler::get_phase_name(GridProfiler::PHASE_LAYOUT) + " last (us)")) {
+		category += godot::String(" ") + godot::String::num_uint64(get_instance_id());
+	}
+
+	for (int phase = 0; phase < GridProfiler::PHASE_MAX; phase++) {
+		const godot::String phase_name = GridProfiler::get_phase_name(static_cast<GridProfiler::Phase>(phase));
+
+		for (int field = 0; field < PROFILE_MONITOR_MAX; field++) {
+			const godot::String monitor_id = category + "/" + phase_name + (field == PROFILE_MONITOR_LAST_USEC ? " last (us)" : " calls");
+			if (performance->has_custom_monitor(monitor_id)) {
+				continue;
+			}
+
+			godot::Array arguments;
+			arguments.push_back(phase);
+			arguments.push_back(field);
+			performance->add_custom_monitor(monitor_id, callable_mp(this, &InteractiveGrid3D::_get_profile_monitor), arguments);
+			data.profile_monitor_ids.push_back(monitor_id);
+		}
+	}
+}
+
+void InteractiveGrid3D::_unregister_profile_monitors() {
+	godot::Performance *performance = godot::Performance::get_singleton();
+
+	for (int64_t index = 0; index < data.profile_monitor_ids.size(); index++) {
+		performance->remove_custom_monitor(data.profile_monitor_ids[index]);
+	}
+	data.profile_monitor_ids.clear();
+}
+
+double InteractiveGrid3D::_get_profile_monitor(int p_phase, int p_field) {
+	const GridProfiler::PhaseStats &stats = data.profiler.get_stats(static_cast<GridProfiler::Phase>(p_phase));
+	return p_field == PROFILE_MONITOR_LAST_USEC ? static_cast<double>(stats.last_usec) : static_cast<double>(stats.calls);
+}
+
+godot::Dictionary InteractiveGrid3D::get_profile_stats() const {
+	godot::Dictionary profile_stats;
+
+	for (int phase = 0; phase < GridProfiler::PHASE_MAX; phase++) {
+		const GridProfiler::PhaseStats &stats = data.profiler.get_stats(static_cast<GridProfiler::Phase>(phase));
+
+		godot::Dictionary phase_stats;
+		phase_stats["calls"] = static_cast<int64_t>(stats.calls);
+		phase_stats["total_usec"] = static_cast<int64_t>(stats.total_usec);
+		phase_stats["last_usec"] = static_cast<int64_t>(stats.last_usec);
+		phase_stats["max_usec"] = static_cast<int64_t>(stats.max_usec);
+		phase_stats["cells"] = static_cast<int64_t>(stats.cells);
+
+		profile_stats[GridProfiler::get_phase_name(static_cast<GridProfiler::Phase>(phase))] = phase_stats;
+	}
+
+	return profile_stats;
+}
+
+void InteractiveGrid3D::reset_profile_stats() {
+	data.profiler.reset();
+}
+
+void InteractiveGrid3D::_get_memory_usage(uint64_t r_bytes[MEMORY_MAX]) const {
+	r_bytes[MEMORY_CELLS] = data.cells.size() * (sizeof(Cell) + sizeof(Cell *)) +
+			data.selected_cells.size() * sizeof(int32_t) + data.cell_costs.size() * sizeof(float) +
+			grid_memory_usage(data.dirty_cells) + grid_memory_usage(data.dirty_cell_marks) +
+			grid_memory_usage(data.highlighted_path_cells) + grid_memory_usage(data.highlighted_path_marks);
+
+	r_bytes[MEMORY_PATHFINDING] = data.pathfinder.get_memory_usage() + data.hierarchy.get_memory_usage() +
+			data.field_of_view.get_memory_usage() + data.cooperative_planner.get_memory_usage();
+	r_bytes[MEMORY_PATHFINDING] += data.path_requests.get_snapshot_memory_usage();
+
+	r_bytes[MEMORY_RENDER] = data.multimesh.is_valid() ? data.multimesh->get_instance_count() * MULTIMESH_INSTANCE_BYTES : 0;
+
+	r_bytes[MEMORY_CACHES] = data.path_cache.get_memory_usage() + data.path_requests.get_memory_usage() +
+			grid_memory_usage(data.reachable_cell_indexes) + grid_memory_usage(data.reachable_parents);
+	if (data.reachable_cache_valid) {
+		// cells, costs and parents arrays of the cached get_reachable_cells result.
+		r_bytes[MEMORY_CACHES] += data.reachable_cell_indexes.size() * (sizeof(int32_t) + sizeof(float) + sizeof(int32_t));
+	}
+	for (const godot::Ref<GridFlowField> &flow_field : data.flow_fields) {
+		r_bytes[MEMORY_CACHES] += flow_field->get_memory_usage();
+	}
+
+	r_bytes[MEMORY_PATHFINDING] += data.chunk_streamer.get_memory_usage();
+	r_bytes[MEMORY_CACHES] += data.chunk_streamer.get_store().get_memory_usage();
+}
+
+godot::Dictionary InteractiveGrid3D::get_memory_usage() const {
+	const char *subsystem_names[MEMORY_MAX] = { "cells", "pathfinding", "render", "caches" };
+
+	uint64_t bytes[MEMORY_MAX];
+	_get_memory_usage(bytes);
+
+	godot::Dictionary memory_usage;
+	uint64_t total = 0;
+
+	for (int subsystem = 0; subsystem < MEMORY_MAX; subsystem++) {
+		memory_usage[subsystem_names[subsystem]] = static_cast<int64_t>(bytes[subsystem]);
+		total += bytes[subsystem];
+	}
+	memory_usage["total"] = static_cast<int64_t>(total);
+
+	uint64_t global_total = 0;
+	{
+		std::lock_guard<std::mutex> lock(live_grids_mutex);
+
+		for (const InteractiveGrid3D *grid : live_grids) {
+			uint64_t grid_bytes[MEMORY_MAX];
+			grid->_get_memory_usage(grid_bytes);
+
+			for (int subsystem = 0; subsystem < MEMORY_MAX; subsystem++) {
+				global_total += grid_bytes[subsystem];
+			}
+		}
+		memory_usage["grid_count"] = static_cast<int64_t>(live_grids.size());
+	}
+	memory_usage["global_total"] = static_cast<int64_t>(global_total);
+
+	return memory_usage;
+}
+
+int InteractiveGrid3D::update_streaming() {
+	GridTraceScope trace("update_streaming");
+	trace.add_argument("grid", get_instance_id());
+
+	if (!data.streaming_enabled) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Streaming is not enabled.");
+		return 0;
+	}
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return 0;
+	}
+
+	_configure_chunk_store();
+
+	// Chunks around the focus points, the closest first.
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+	data.chunk_streamer.clear_streamed_chunks();
+
+	for (int point = 0; point < data.streaming_focus_points.size(); point++) {
+		const godot::Vector3 focus_point = data.streaming_focus_points[point];
+
+		int column = 0;
+		int row = 0;
+		grid_layout_world_cell_at(hexagonal, focus_point.x, focus_point.z, data.cell_size.x, data.cell_size.y, column, row);
+		data.chunk_streamer.add_focus_cell(column, row, focus_point.y);
+	}
+
+	data.chunk_streamer.sort_streamed_chunks();
+
+	// Cached chunks are only refreshed in the LRU order (or read back from the
+	// cache file); at most streaming_chunks_per_update chunks are scanned.
+	int scanned_chunks = 0;
+
+	for (const GridChunkStreamer::StreamedChunk &streamed_chunk : data.chunk_streamer.get_streamed_chunks()) {
+		if (!data.chunk_streamer.get_store().is_cached(streamed_chunk.x, streamed_chunk.z)) {
+			if (scanned_chunks >= data.streaming_chunks_per_update) {
+				continue;
+			}
+			scanned_chunks++;
+		}
+
+		if (_acquire_chunk(streamed_chunk.x, streamed_chunk.z, streamed_chunk.height) == nullptr) {
+			break;
+		}
+	}
+
+	return data.chunk_streamer.get_missing_chunk_count();
+}
+
+godot::Dictionary InteractiveGrid3D::get_streamed_cell(const godot::Vector3 &p_global_position) {
+	godot::Dictionary streamed_cell;
+
+	if (!data.streaming_enabled) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Streaming is not enabled.");
+		return streamed_cell;
+	}
+
+	_configure_chunk_store();
+
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+
+	int column = 0;
+	int row = 0;
+	grid_layout_world_cell_at(hexagonal, p_global_position.x, p_global_position.z, data.cell_size.x, data.cell_size.y, column, row);
+
+	int chunk_x = 0;
+	int chunk_z = 0;
+	const int chunk_cell_index = data.chunk_streamer.get_store().get_cell_chunk(column, row, chunk_x, chunk_z);
+
+	// Lookups never scan: unknown chunks are reported as an empty Dictionary.
+	if (!data.chunk_streamer.get_store().is_cached(chunk_x, chunk_z)) {
+		return streamed_cell;
+	}
+
+	const GridChunkCell &cell = _acquire_chunk(chunk_x, chunk_z, p_global_position.y)[chunk_cell_index];
+
+	godot::Vector2 cell_position;
+	grid_layout_cell_offset(hexagonal, column, row, data.cell_size.x, data.cell_size.y, cell_position.x, cell_position.y);
+
+	const bool in_void = cell.flags & GridChunkStore::CELL_VOID;
+
+	streamed_cell["cell"] = godot::Vector2i(column, row);
+	streamed_cell["chunk"] = godot::Vector2i(chunk_x, chunk_z);
+	streamed_cell["position"] = godot::Vector3(cell_position.x, cell.height, cell_position.y);
+	streamed_cell["normal"] = godot::Vector3(cell.normal_x, cell.normal_y, cell.normal_z);
+	streamed_cell["accessible"] = !in_void && !(cell.flags & GridChunkStore::CELL_OBSTACLE);
+	streamed_cell["in_void"] = in_void;
+	streamed_cell["custom_flags"] = static_cast<int64_t>(_get_custom_flags(cell.custom_data));
+
+	return streamed_cell;
+}
+
+godot::PackedVector3Array InteractiveGrid3D::get_streamed_path(const godot::Vector3 &p_from, const godot::Vector3 &p_to) {
+	GridTraceScope trace("get_streamed_path");
+	trace.add_argument("grid", get_instance_id());
+
+	godot::PackedVector3Array path;
+
+	if (!data.streaming_enabled) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Streaming is not enabled.");
+		return path;
+	}
+
+	_configure_chunk_store();
+
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+
+	int from_column = 0;
+	int from_row = 0;
+	int to_column = 0;
+	int to_row = 0;
+	grid_layout_world_cell_at(hexagonal, p_from.x, p_from.z, data.cell_size.x, data.cell_size.y, from_column, from_row);
+	grid_layout_world_cell_at(hexagonal, p_to.x, p_to.z, data.cell_size.x, data.cell_size.y, to_column, to_row);
+
+	int64_t cell_count = 0;
+	switch (data.chunk_streamer.build_region(from_column, from_row, to_column, to_row,
+			static_cast<GridPathfinder::Movement>(data.movement), MAX_STREAMED_PATH_CELLS, cell_count)) {
+		case GridChunkStreamer::REGION_READY:
+			break;
+		case GridChunkStreamer::REGION_NOT_CACHED:
+			return path;
+		case GridChunkStreamer::REGION_TOO_LARGE:
+			PrintError(__FILE__, __FUNCTION__, __LINE__, "The path spans too many chunks: ", cell_count, " cells.");
+			return path;
+	}
+
+	GridPathfinder &pathfinder = data.chunk_streamer.get_region_pathfinder();
+
+	for (const GridChunkStreamer::CustomCell &custom_cell : data.chunk_streamer.get_region_custom_cells()) {
+		float multiplier = 1.0f;
+		float edge_cost = 0.0f;
+		_get_custom_flags_cost(_get_custom_flags(custom_cell.custom_data), multiplier, edge_cost);
+		pathfinder.set_cell_cost(custom_cell.index, multiplier, edge_cost);
+	}
+
+	_apply_terrain_limits(pathfinder);
+	pathfinder.update_cost_bounds();
+
+	const int from_index = data.chunk_streamer.get_region_index(from_column, from_row);
+	const int to_index = data.chunk_streamer.get_region_index(to_column, to_row);
+
+	godot::LocalVector<int> path_cells;
+	if (!pathfinder.find_path(from_index, to_index, path_cells)) {
+		return path;
+	}
+
+	path.resize(path_cells.size());
+
+	for (uint32_t step = 0; step < path_cells.size(); step++) {
+		const int index = path_cells[step];
+		int column = 0;
+		int row = 0;
+		data.chunk_streamer.get_region_cell(index, column, row);
+
+		godot::Vector2 cell_position;
+		grid_layout_cell_offset(hexagonal, column, row, data.cell_size.x, data.cell_size.y, cell_position.x, cell_position.y);
+		path.set(step, godot::Vector3(cell_position.x, pathfinder.get_cell_height(index), cell_position.y));
+	}
+
+	return path;
+}
+
+godot::Dictionary InteractiveGrid3D::get_streaming_stats() const {
+	const GridChunkStore &chunk_store = data.chunk_streamer.get_store();
+
+	godot::Dictionary stats;
+	stats["loaded_chunks"] = chunk_store.get_loaded_count();
+	stats["cached_chunks"] = chunk_store.get_cached_count();
+	stats["memory_bytes"] = static_cast<int64_t>(chunk_store.get_memory_usage());
+	stats["scans"] = static_cast<int64_t>(chunk_store.get_scans());
+	stats["file_loads"] = static_cast<int64_t>(chunk_store.get_file_loads());
+	stats["evictions"] = static_cast<int64_t>(chunk_store.get_evictions());
+	stats["cache_file_open"] = chunk_store.is_file_open();
+	return stats;
+}
+
+void InteractiveGrid3D::clear_streaming_cache() {
+	data.chunk_streamer.get_store().clear();
+}
+
+void InteractiveGrid3D::start_trace(int p_capacity) {
+	GridTracer::get_singleton().start(std::max(p_capacity, 2));
+}
+
+void InteractiveGrid3D::stop_trace() {
+	GridTracer::get_singleton().stop();
+}
+
+void InteractiveGrid3D::clear_trace() {
+	GridTracer::get_singleton().clear();
+}
+
+bool InteractiveGrid3D::is_trace_enabled() {
+	return GridTracer::get_singleton().is_enabled();
+}
+
+godot::String InteractiveGrid3D::get_trace_json() {
+	const GridTracer &tracer = GridTracer::get_singleton();
+
+	// Timestamps are moved onto Time.get_ticks_usec(), the clock of the game markers.
+	const int64_t time_offset_usec = static_cast<int64_t>(godot::Time::get_singleton()->get_ticks_usec()) -
+			tracer.get_time_usec(GridTracer::Clock::now());
+
+	std::string json;
+	tracer.write_json(json, godot::OS::get_singleton()->get_process_id(), time_offset_usec);
+	return godot::String::utf8(json.c_str(), json.size());
+}
+
+bool InteractiveGrid3D::save_trace(const godot::String &p_path) {
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(p_path, godot::FileAccess::WRITE);
+
+	if (file.is_null()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cannot open the trace file: ", p_path);
+		return false;
+	}
+
+	file->store_string(get_trace_json());
+	return true;
+}
+
+void InteractiveGrid3D::_physics_process(double p_delta) {
+	_create();
+
+	if (godot::Engine::get_singleton()->is_editor_hint()) {
+		if (data.center_global_position != get_global_transform().origin) {
+			_delete();
+		}
+	}
+
+	_process_path_requests();
+}
+
+void InteractiveGrid3D::set_rows(int p_rows) {
+	data.rows = p_rows;
+	_delete();
+}
+
+int InteractiveGrid3D::get_rows(void) const {
+	return data.rows;
+}
+
+void InteractiveGrid3D::set_columns(int p_columns) {
+	data.columns = p_columns;
+	_delete();
+}
+
+int InteractiveGrid3D::get_columns() const {
+	return data.columns;
+}
+
+int InteractiveGrid3D::get_size() const {
+	return data.rows * data.columns;
+}
+
+void InteractiveGrid3D::set_cell_size(godot::Vector2 p_cell_size) {
+	data.cell_size = p_cell_size;
+	_delete();
+}
+
+godot::Vector2 InteractiveGrid3D::get_cell_size(void) const {
+	return data.cell_size;
+}
+
+void InteractiveGrid3D::set_cell_mesh(const godot::Ref<godot::Mesh> &p_mesh) {
+	if (p_mesh == data.cell_mesh) {
+		return;
+	}
+
+	data.cell_mesh = p_mesh;
+	_delete();
+}
+
+godot::Ref<godot::Mesh> InteractiveGrid3D::get_cell_mesh() const {
+	return data.cell_mesh;
+}
+
+void InteractiveGrid3D::set_cell_shape(const godot::Ref<godot::Shape3D> &p_shape) {
+	if (p_shape == data.cell_shape) {
+		return;
+	}
+
+	data.cell_shape = p_shape;
+	_delete();
+}
+
+godot::Ref<godot::Shape3D> InteractiveGrid3D::get_cell_shape() const {
+	return data.cell_shape;
+}
+
+void InteractiveGrid3D::set_cell_shape_offset(godot::Vector3 p_offset) {
+	data.cell_shape_offset = p_offset;
+}
+
+godot::Vector3 InteractiveGrid3D::get_cell_shape_offset() {
+	return data.cell_shape_offset;
+}
+
+void InteractiveGrid3D::set_cell_rotation(godot::Vector3 p_rotation) {
+	data.cell_rotation = p_rotation;
+	_delete();
+}
+
+godot::Vector3 InteractiveGrid3D::get_cell_rotation() {
+	return data.cell_rotation;
+}
+
+void InteractiveGrid3D::InteractiveGrid3D::set_layout(Layout p_layout) {
+	data.layout_index = p_layout;
+	_delete();
+}
+
+InteractiveGrid3D::Layout InteractiveGrid3D::get_layout() const {
+	return data.layout_index;
+}
+
+void InteractiveGrid3D::set_movement(Movement p_movement) {
+	data.movement = p_movement;
+	data.area.set_diagonal(data.movement != MOVEMENT_FOUR_DIRECTIONS);
+
+	// Neighbors come from the pathfinder topology, which only needs the movement.
+	data.pathfinder.set_movement(static_cast<GridPathfinder::Movement>(data.movement));
+
+	if (data.flags & GFL_CREATED) {
+		data.flags |= GFL_PATHFINDER_DIRTY;
+		_invalidate_search_caches();
+	}
+}
+
+InteractiveGrid3D::Movement InteractiveGrid3D::get_movement() const {
+	return data.movement;
+}
+
+void InteractiveGrid3D::set_jump_point_search_enabled(bool p_enabled) {
+	data.jump_point_search_enabled = p_enabled;
+	data.path_cache.clear();
+}
+
+bool InteractiveGrid3D::is_jump_point_search_enabled() const {
+	return data.jump_point_search_enabled;
+}
+
+void InteractiveGrid3D::set_hierarchical_pathfinding_enabled(bool p_enabled) {
+	data.hierarchical_pathfinding_enabled = p_enabled;
+	data.path_cache.clear();
+}
+
+bool InteractiveGrid3D::is_hierarchical_pathfinding_enabled() const {
+	return data.hierarchical_pathfinding_enabled;
+}
+
+void InteractiveGrid3D::set_cluster_size(int p_cluster_size) {
+	data.cluster_size = p_cluster_size;
+	data.path_cache.clear();
+
+	if (data.flags & GFL_CREATED) {
+		data.hierarchy.setup(&data.pathfinder, data.cluster_size);
+	}
+}
+
+int InteractiveGrid3D::get_cluster_size() const {
+	return data.cluster_size;
+}
+
+void InteractiveGrid3D::set_max_step_height(float p_max_step_height) {
+	data.max_step_height = p_max_step_height < 0.0f ? 0.0f : p_max_step_height;
+
+	if (data.flags & GFL_CREATED) {
+		data.flags |= GFL_PATHFINDER_DIRTY;
+		_invalidate_search_caches();
+	}
+}
+
+float InteractiveGrid3D::get_max_step_height() const {
+	return data.max_step_height;
+}
+
+void InteractiveGrid3D::set_max_slope(float p_max_slope) {
+	data.max_slope = std::max(0.0f, std::min(90.0f, p_max_slope));
+
+	if (data.flags & GFL_CREATED) {
+		data.flags |= GFL_PATHFINDER_DIRTY;
+		_invalidate_search_caches();
+	}
+}
+
+float InteractiveGrid3D::get_max_slope() const {
+	return data.max_slope;
+}
+
+void InteractiveGrid3D::set_path_cache_size(int p_path_cache_size) {
+	data.path_cache_size = p_path_cache_size;
+	data.path_cache.set_capacity(p_path_cache_size);
+}
+
+int InteractiveGrid3D::get_path_cache_size() const {
+	return data.path_cache_size;
+}
+
+void InteractiveGrid3D::set_path_requests_per_frame(int p_path_requests_per_frame) {
+	data.path_requests_per_frame = p_path_requests_per_frame < 1 ? 1 : p_path_requests_per_frame;
+}
+
+int InteractiveGrid3D::get_path_requests_per_frame() const {
+	return data.path_requests_per_frame;
+}
+
+void InteractiveGrid3D::set_streaming_enabled(bool p_enabled) {
+	data.streaming_enabled = p_enabled;
+	_check_streamed_custom_cell_data_count();
+}
+
+bool InteractiveGrid3D::is_streaming_enabled() const {
+	return data.streaming_enabled;
+}
+
+void InteractiveGrid3D::set_chunk_size(int p_chunk_size) {
+	// Even, so hexagonal rows keep their parity from one chunk to the next.
+	data.chunk_size = std::max(2, p_chunk_size + (p_chunk_size & 1));
+}
+
+int InteractiveGrid3D::get_chunk_size() const {
+	return data.chunk_size;
+}
+
+void InteractiveGrid3D::set_streaming_radius(int p_radius) {
+	data.chunk_streamer.set_radius(p_radius);
+}
+
+int InteractiveGrid3D::get_streaming_radius() const {
+	return data.chunk_streamer.get_radius();
+}
+
+void InteractiveGrid3D::set_streaming_memory_budget(int p_megabytes) {
+	data.streaming_memory_budget = std::max(1, p_megabytes);
+	data.chunk_streamer.get_store().set_memory_budget(static_cast<uint64_t>(data.streaming_memory_budget) * 1024 * 1024);
+}
+
+int InteractiveGrid3D::get_streaming_memory_budget() const {
+	return data.streaming_memory_budget;
+}
+
+void InteractiveGrid3D::set_streaming_chunks_per_update(int p_chunks) {
+	data.streaming_chunks_per_update = std::max(1, p_chunks);
+}
+
+int InteractiveGrid3D::get_streaming_chunks_per_update() const {
+	return data.streaming_chunks_per_update;
+}
+
+void InteractiveGrid3D::set_streaming_cache_path(const godot::String &p_path) {
+	if (p_path == data.streaming_cache_path) {
+		return;
+	}
+
+	// Opened on the next streaming operation, once the settings are known.
+	data.chunk_streamer.get_store().close_file();
+	data.streaming_cache_path = p_path;
+	data.streaming_cache_file_failed = false;
+}
+
+godot::String InteractiveGrid3D::get_streaming_cache_path() const {
+	return data.streaming_cache_path;
+}
+
+void InteractiveGrid3D::set_streaming_focus_points(const godot::PackedVector3Array &p_points) {
+	data.streaming_focus_points = p_points;
+}
+
+godot::PackedVector3Array InteractiveGrid3D::get_streaming_focus_points() const {
+	return data.streaming_focus_points;
+}
+
+void InteractiveGrid3D::set_accessible_color(const godot::Color &p_color) {
+	data.accessible_color = p_color;
+	_delete();
+}
+
+godot::Color InteractiveGrid3D::get_accessible_color() const {
+	return data.accessible_color;
+}
+
+void InteractiveGrid3D::set_unaccessible_color(const godot::Color &p_color) {
+	data.unaccessible_color = p_color;
+	_delete();
+}
+
+godot::Color InteractiveGrid3D::get_unaccessible_color() const {
+	return data.unaccessible_color;
+}
+
+void InteractiveGrid3D::set_unreachable_color(const godot::Color &p_color) {
+	data.unreachable_color = p_color;
+}
+
+godot::Color InteractiveGrid3D::get_unreachable_color() const {
+	return data.unreachable_color;
+}
+
+void InteractiveGrid3D::set_selected_color(const godot::Color &p_color) {
+	data.selected_color = p_color;
+}
+
+godot::Color InteractiveGrid3D::get_selected_color() const {
+	return data.selected_color;
+}
+
+void InteractiveGrid3D::set_path_color(const godot::Color &p_color) {
+	data.path_color = p_color;
+}
+
+godot::Color InteractiveGrid3D::get_path_color() const {
+	return data.path_color;
+}
+
+void InteractiveGrid3D::set_hovered_color(const godot::Color &p_color) {
+	data.hovered_color = p_color;
+}
+
+godot::Color InteractiveGrid3D::get_hovered_color() const {
+	return data.hovered_color;
+}
+
+void InteractiveGrid3D::set_custom_cells_data(const godot::Array &p_custom_cell_data) {
+	data.custom_cell_data = p_custom_cell_data;
+	_check_streamed_custom_cell_data_count();
+}
+
+godot::Array InteractiveGrid3D::get_custom_cells_data() const {
+	return data.custom_cell_data;
+}
+
+void InteractiveGrid3D::add_custom_cell_data(int p_cell_index, godot::String p_custom_data_name) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	godot::Ref<CustomCellData> custom_cell_data;
+
+	for (int index = 0; index < data.custom_cell_data.size(); index++) {
+		custom_cell_data = data.custom_cell_data.get(index);
+
+		if (custom_cell_data.is_null()) {
+			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
+			continue;
+		}
+
+		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
+			continue;
+		}
+
+		data.cells.write[p_cell_index]->custom_flags |= custom_cell_data->get_layer_mask();
+		data.cells.write[p_cell_index]->flags |= custom_cell_data->get_layer_mask();
+		_mark_pathfinding_cell_dirty(p_cell_index); // Custom layers share the cell flags.
+		_update_cell_cost(p_cell_index);
+
+		if (custom_cell_data->get_custom_color_enabled()) {
+			data.cells.write[p_cell_index]->has_custom_color = true;
+			data.cells.write[p_cell_index]->custom_color = custom_cell_data->get_color();
+			set_cell_color(p_cell_index, data.cells[p_cell_index]->custom_color);
+		}
+	}
+}
+
+bool InteractiveGrid3D::has_custom_cell_data(int p_cell_index, godot::String p_custom_data_name) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return false;
+	}
+
+	godot::Ref<CustomCellData> custom_cell_data;
+
+	for (int index = 0; index < data.custom_cell_data.size(); index++) {
+		custom_cell_data = data.custom_cell_data.get(index);
+
+		if (custom_cell_data.is_null()) {
+			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
+			continue;
+		}
+
+		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
+			continue;
+		}
+
+		uint32_t cell_flags = data.cells[p_cell_index]->flags;
+		uint32_t custom_cell_data_flags = custom_cell_data->get_layer_mask();
+
+		if ((cell_flags & custom_cell_data_flags) == custom_cell_data_flags) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void InteractiveGrid3D::clear_custom_cell_data(int p_cell_index, godot::String p_custom_data_name, bool p_clear_custom_color) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	godot::Ref<CustomCellData> custom_cell_data;
+
+	for (int index = 0; index < data.custom_cell_data.size(); index++) {
+		custom_cell_data = data.custom_cell_data.get(index);
+
+		if (custom_cell_data.is_null()) {
+			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
+			continue;
+		}
+
+		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
+			continue;
+		}
+
+		if (p_clear_custom_color) {
+			data.cells.write[p_cell_index]->has_custom_color = false;
+			set_cell_color(p_cell_index, data.accessible_color);
+		}
+
+		break;
+	}
+}
+
+void InteractiveGrid3D::clear_all_custom_cell_data(int p_cell_index) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
+
+	data.cells.write[p_cell_index]->flags &= ~data.cells[p_cell_index]->custom_flags;
+	data.cells.write[p_cell_index]->custom_flags = 0;
+	_mark_pathfinding_cell_dirty(p_cell_index);
+	_update_cell_cost(p_cell_index);
+	data.cells.write[p_cell_index]->has_custom_color = false;
+	set_cell_color(p_cell_index, data.accessible_color);
+}
+
+void InteractiveGrid3D::set_material_override(const godot::Ref<godot::Material> &p_material) {
+	data.material_override = p_material;
+	_delete();
+}
+
+godot::Ref<godot::Material> InteractiveGrid3D::get_material_override() const {
+	return data.material_override;
+}
+
+void InteractiveGrid3D::apply_default_material() {
+	if (data.multimesh_instance == nullptr) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "No MultiMeshInstance found.");
+		return;
+	}
+
+	godot::Ref<godot::Shader> shader;
+	shader.instantiate();
+	shader->set_code(default_shader_code);
+
+	godot::Ref<godot::ShaderMaterial> shader_material;
+	shader_material.instantiate();
+	shader_material->set_shader(shader);
+
+	data.multimesh_instance->set_material_override(shader_material);
+
+	if (_debug_options.print_logs_enabled) {
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Default ShaderMaterial created and applied.");
+	}
+}
+
+void InteractiveGrid3D::highlight_on_hover(godot::Vector3 p_global_position) {
+	GridTraceScope trace("highlight_on_hover");
+	trace.add_argument("grid", get_instance_id());
+
+	if (is_visible() == false) {
+		return;
+	}
+
+	if (is_centered() == false) {
+		return;
+	}
+
+	if (is_hover_enabled() == false) {
+		return;
+	}
+
+	int closest_index = get_cell_index_from_global_position(p_global_position);
+
+	if (closest_index == -1 || !is_cell_visible(closest_index)) {
+		if (data.hovered_cell_index > -1) {
+			_set_cell_hovered(data.hovered_cell_index, false);
+
+			if (!is_cell_selected(data.hovered_cell_index)) {
+				if (data.cells[data.hovered_cell_index]->has_custom_color) {
+					set_cell_color(data.hovered_cell_index, data.cells[data.hovered_cell_index]->custom_color);
+				} else {
+					set_cell_color(data.hovered_cell_index, data.accessible_color);
+				}
+			}
+
+			data.hovered_cell_index = -1;
+		}
+		return;
+	}
+
+	if (closest_index == data.hovered_cell_index) {
+		return;
+	}
+
+	if (data.hovered_cell_index > -1) {
+		_set_cell_hovered(data.hovered_cell_index, false);
+
+		if (!is_cell_selected(data.hovered_cell_index)) {
+			if (data.cells[data.hovered_cell_index]->has_custom_color) {
+				set_cell_color(data.hovered_cell_index, data.cells[data.hovered_cell_index]->custom_color);
+			} else {
+				set_cell_color(data.hovered_cell_index, data.accessible_color);
+			}
+		}
+
+		data.hovered_cell_index = -1;
+	}
+
+	if (!is_cell_accessible(closest_index)) {
+		return;
+	}
+
+	if (!is_cell_reachable(closest_index)) {
+		return;
+	}
+
+	if (!is_cell_selected(closest_index)) {
+		data.hovered_cell_index = closest_index;
+		_set_cell_hovered(data.hovered_cell_index, true);
+	}
+}
+
+void InteractiveGrid3D::highlight_path(const godot::PackedInt64Array &p_path) {
+	GridTraceScope trace("highlight_path");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("cells", p_path.size());
+
+	for (int step = 0; step < p_path.size(); step++) {
+		int cell_index = p_path[step];
+		_set_cell_on_path(cell_index, true);
+	}
+}
+
+void InteractiveGrid3D::set_highlighted_path(const godot::PackedInt64Array &p_path) {
+	GridTraceScope trace("set_highlighted_path");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("cells", p_path.size());
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
+
+	data.highlighted_path_generation++;
+	if (data.highlighted_path_generation == 0) {
+		for (uint32_t index = 0; index < data.highlighted_path_marks.size(); index++) {
+			data.highlighted_path_marks[index] = 0;
+		}
+		data.highlighted_path_generation = 1;
+	}
+
+	const uint32_t generation = data.highlighted_path_generation;
+	const int cell_count = data.cells.size();
+
+	godot::LocalVector<int> path_cells;
+	path_cells.reserve(p_path.size());
+
+	// Cells entering the path are highlighted, the others are left untouched.
+	for (int64_t step = 0; step < p_path.size(); step++) {
+		const int64_t cell_index = p_path[step];
+		if (cell_index < 0 || cell_index >= cell_count) {
+			PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell index out of bounds: ", cell_index);
+			continue;
+		}
+		if (data.highlighted_path_marks[cell_index] == generation) {
+			continue;
+		}
+
+		data.highlighted_path_marks[cell_index] = generation;
+		path_cells.push_back(cell_index);
+
+		if (!is_cell_on_path(cell_index)) {
+			_set_cell_on_path(cell_index, true);
+		}
+	}
+
+	// Cells leaving the path get the color of their current state back.
+	for (const int &cell_index : data.highlighted_path_cells) {
+		if (data.highlighted_path_marks[cell_index] != generation) {
+			_set_cell_on_path(cell_index, false);
+			_restore_cell_color(cell_index);
+		}
+	}
+
+	data.highlighted_path_cells = path_cells;
+}
+
+godot::Vector3 InteractiveGrid3D::get_cell_global_position(int p_cell_index) const {
+	godot::Vector3 cell_global_position = data.cells[p_cell_index]->global_xform.origin;
+	return cell_global_position;
+}
+
+int InteractiveGrid3D::get_cell_index_from_global_position(godot::Vector3 p_global_position) const {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created.");
+		return -1;
+	}
+
+	if (!data.multimesh.is_valid()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid multimesh is not valid.");
+		return -1;
+	}
+
+	float center_to_edge_x{ 0.0f }, center_to_edge_z{ 0.0f };
+	godot::Vector3 top_left_global_position;
+
+	switch (data.layout_index) {
+		case Layout::LAYOUT_SQUARE:
+
+			center_to_edge_x = (data.columns / 2) * data.cell_size.x + data.cell_size.x / 2;
+			center_to_edge_z = (data.rows / 2) * data.cell_size.y + data.cell_size.y / 2;
+
+			top_left_global_position.x = data.center_global_position.x - center_to_edge_x;
+			top_left_global_position.z = data.center_global_position.z - center_to_edge_z;
+
+			if (!(data.rows % 2)) { // Even.
+				if (p_global_position.x > (data.center_global_position.x + center_to_edge_x - data.cell_size.x) || p_global_position.x < (data.center_global_position.x - center_to_edge_x)) {
+					return -1;
+				}
+				if (p_global_position.z > (data.center_global_position.z + center_to_edge_z - data.cell_size.y) || p_global_position.z < (data.center_global_position.z - center_to_edge_z)) {
+					return -1;
+				}
+			} else {
+				if (p_global_position.x > (data.center_global_position.x + center_to_edge_x) || p_global_position.x < (data.center_global_position.x - center_to_edge_x)) {
+					return -1;
+				}
+				if (p_global_position.z > (data.center_global_position.z + center_to_edge_z) || p_global_position.z < (data.center_global_position.z - center_to_edge_z)) {
+					return -1;
+				}
+			}
+			break;
+		case Layout::LAYOUT_HEXAGONAL:
+
+			const float hex_short_diagonal = data.cell_size.x; // s = a · √3
+			const float hex_side_length = hex_short_diagonal / sqrt(3); // a = s / √3.
+			const float hex_side_to_side = data.cell_size.x / 2;
+			const float hex_inradius = hex_side_length * sqrt(3) / 2; // r = a · √3 / 2.
+
+			float center_to_edge_x = (data.columns / 2) * data.cell_size.x;
+			float center_to_edge_z = (data.rows / 2) * data.cell_size.y;
+
+			if (data.rows % 2) { // Odd.
+				center_to_edge_z += hex_side_length;
+			}
+
+			top_left_global_position.x = data.center_global_position.x - center_to_edge_x;
+			top_left_global_position.z = data.center_global_position.z - center_to_edge_z;
+
+			if (p_global_position.x < (top_left_global_position.x - hex_side_to_side)) {
+				return -1;
+			}
+
+			if (p_global_position.x > (top_left_global_position.x + center_to_edge_x * 2 + data.cell_size.x)) {
+				return -1;
+			}
+
+			if (p_global_position.z < top_left_global_position.z) {
+				return -1;
+			}
+
+			if (p_global_position.z > (top_left_global_position.z + center_to_edge_z * 2)) {
+				return -1;
+			}
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	float closest_distance = std::numeric_limits<float>::max();
+	int closest_index = -1;
+
+	for (int row = 0; row < data.rows; row++) {
+		for (int column = 0; column < data.columns; column++) {
+			const int index =
+					row * data.columns + column;
+
+			const godot::Vector3 cell_pos = data.cells[index]->global_xform.origin;
+			const float distance = p_global_position.distance_to(cell_pos);
+
+			if (distance < closest_distance) {
+				closest_distance = distance;
+				closest_index = index;
+			}
+		}
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_HOVER_LOOKUP, start, end, data.cells.size());
+
+	return closest_index;
+}
+
+float InteractiveGrid3D::_get_cell_surface_height(int p_cell_index, float p_x, float p_z) const {
+	// Plane through the cell origin, tilted by the floor normal.
+	const godot::Vector3 &origin = data.cells[p_cell_index]->global_xform.origin;
+	const godot::Vector3 &normal = data.cells[p_cell_index]->floor_normal;
+
+	if (normal.y <= 0.0f) {
+		return origin.y;
+	}
+	return origin.y - (normal.x * (p_x - origin.x) + normal.z * (p_z - origin.z)) / normal.y;
+}
+
+int InteractiveGrid3D::_get_closest_hexagonal_cell(float p_x, float p_z) const {
+	const godot::Vector3 &first_cell = data.cells[0]->global_xform.origin;
+	const int rows = data.rows;
+	const int columns = data.columns;
+	const int middle_row = static_cast<int>(std::floor((p_z - first_cell.z) / data.cell_size.y + 0.5f));
+
+	float closest_distance = std::numeric_limits<float>::max();
+	int closest_index = -1;
+
+	// Pointy hexes reach into the neighboring rows, so three rows are checked.
+	for (int row = std::max(0, middle_row - 1); row <= std::min(rows - 1, middle_row + 1); row++) {
+		const float row_x = first_cell.x + ((row & 1) ? data.cell_size.x / 2 : 0.0f);
+		const int column = static_cast<int>(std::floor((p_x - row_x) / data.cell_size.x + 0.5f));
+		if (column < 0 || column >= columns) {
+			continue;
+		}
+
+		const int index = row * columns + column;
+		const godot::Vector3 &position = data.cells[index]->global_xform.origin;
+		const float distance = (position.x - p_x) * (position.x - p_x) + (position.z - p_z) * (position.z - p_z);
+		if (distance < closest_distance) {
+			closest_distance = distance;
+			closest_index = index;
+		}
+	}
+
+	return closest_index;
+}
+
+int InteractiveGrid3D::pick_cell_from_ray(const godot::Vector3 &p_origin, const godot::Vector3 &p_direction) const {
+	GridTraceScope trace("pick_cell_from_ray");
+	trace.add_argument("grid", get_instance_id());
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created.");
+		return -1;
+	}
+
+	if (p_direction.length_squared() == 0.0f) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The ray direction must not be zero.");
+		return -1;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	int visited_cells = 0;
+	const int cell_index = _pick_cell_from_ray(p_origin, p_direction, visited_cells);
+
+	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_HOVER_LOOKUP, start, end, visited_cells);
+
+	return cell_index;
+}
+
+int InteractiveGrid3D::_pick_cell_from_ray(const godot::Vector3 &p_origin, const godot::Vector3 &p_direction, int &r_visited_cells) const {
+	const godot::Vector3 direction = p_direction.normalized();
+
+	// Cells keep their layout position on the XZ plane, floor alignment only
+	// moves them vertically, so the first cell gives the layout origin.
+	const godot::Vector3 &first_cell = data.cells[0]->global_xform.origin;
+	const bool hexagonal = data.layout_index == LAYOUT_HEXAGONAL;
+
+	float min_x = first_cell.x - data.cell_size.x / 2;
+	float max_x = min_x + data.columns * data.cell_size.x + (hexagonal ? data.cell_size.x / 2 : 0.0f);
+	float min_z = first_cell.z - data.cell_size.y / 2;
+	float max_z = min_z + data.rows * data.cell_size.y;
+	if (hexagonal) {
+		// Pointy hexes stick out by a side length over the row spacing.
+		const float hex_side_length = data.cell_size.x / std::sqrt(3.0f);
+		min_z = first_cell.z - hex_side_length;
+		max_z = first_cell.z + (data.rows - 1) * data.cell_size.y + hex_side_length;
+	}
+
+	// Clip the ray to the grid bounds on the XZ plane.
+	float t_enter = 0.0f;
+	float t_exit = std::numeric_limits<float>::max();
+
+	const float origins[2] = { p_origin.x, p_origin.z };
+	const float directions[2] = { direction.x, direction.z };
+	const float mins[2] = { min_x, min_z };
+	const float maxs[2] = { max_x, max_z };
+
+	for (int axis = 0; axis < 2; axis++) {
+		if (std::abs(directions[axis]) < 1e-6f) {
+			if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+				return -1;
+			}
+			continue;
+		}
+
+		float t0 = (mins[axis] - origins[axis]) / directions[axis];
+		float t1 = (maxs[axis] - origins[axis]) / directions[axis];
+		if (t0 > t1) {
+			std::swap(t0, t1);
+		}
+		t_enter = std::max(t_enter, t0);
+		t_exit = std::min(t_exit, t1);
+	}
+
+	if (t_enter > t_exit) {
+		return -1;
+	}
+
+	const int rows = data.rows;
+	const int columns = data.columns;
+	const float planar_length = std::sqrt(direction.x * direction.x + direction.z * direction.z);
+
+	if (planar_length < 1e-6f || t_exit == std::numeric_limits<float>::max()) {
+		// Vertical ray: only the cell below (or above) the origin.
+		int index;
+		if (hexagonal) {
+			index = _get_closest_hexagonal_cell(p_origin.x, p_origin.z);
+		} else {
+			const int column = std::min(columns - 1, static_cast<int>((p_origin.x - min_x) / data.cell_size.x));
+			const int row = std::min(rows - 1, static_cast<int>((p_origin.z - min_z) / data.cell_size.y));
+			index = row * columns + column;
+		}
+		if (index < 0) {
+			return -1;
+		}
+		r_visited_cells++;
+		const bool facing = (p_origin.y >= _get_cell_surface_height(index, p_origin.x, p_origin.z)) == (direction.y < 0.0f);
+		return facing ? index : -1;
+	}
+
+	if (hexagonal) {
+		// March by a quarter cell: no cell is skipped along the ray.
+		const float step = std::min(data.cell_size.x, data.cell_size.y) * 0.25f / planar_length;
+
+		for (float t = t_enter; t <= t_exit + step; t += step) {
+			const float t_sample = std::min(t, t_exit);
+			const godot::Vector3 point = p_origin + direction * t_sample;
+
+			const int index = _get_closest_hexagonal_cell(point.x, point.z);
+			r_visited_cells++;
+			if (index >= 0 && point.y <= _get_cell_surface_height(index, point.x, point.z)) {
+				return index;
+			}
+		}
+		return -1;
+	}
+
+	// DDA over the square cells crossed by the ray (Amanatides and Woo).
+	const godot::Vector3 entry = p_origin + direction * t_enter;
+	int column = std::min(columns - 1, std::max(0, static_cast<int>(std::floor((entry.x - min_x) / data.cell_size.x))));
+	int row = std::min(rows - 1, std::max(0, static_cast<int>(std::floor((entry.z - min_z) / data.cell_size.y))));
+
+	const int step_column = direction.x > 0.0f ? 1 : -1;
+	const int step_row = direction.z > 0.0f ? 1 : -1;
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	float t_max_x = infinity;
+	float t_delta_x = infinity;
+	if (std::abs(direction.x) >= 1e-6f) {
+		t_max_x = (min_x + (column + (step_column > 0 ? 1 : 0)) * data.cell_size.x - p_origin.x) / direction.x;
+		t_delta_x = data.cell_size.x / std::abs(direction.x);
+	}
+
+	float t_max_z = infinity;
+	float t_delta_z = infinity;
+	if (std::abs(direction.z) >= 1e-6f) {
+		t_max_z = (min_z + (row + (step_row > 0 ? 1 : 0)) * data.cell_size.y - p_origin.z) / direction.z;
+		t_delta_z = data.cell_size.y / std::abs(direction.z);
+	}
+
+	float t = t_enter;
+
+	while (column >= 0 && column < columns && row >= 0 && row < rows && t <= t_exit) {
+		const int index = row * columns + column;
+		const float t_next = std::min(std::min(t_max_x, t_max_z), t_exit);
+		r_visited_cells++;
+
+		// The ray crosses the cell surface if it is below it on either side
+		// of the cell, both being linear over the crossed segment.
+		const godot::Vector3 from = p_origin + direction * t;
+		const godot::Vector3 to = p_origin + direction * t_next;
+		if (from.y <= _get_cell_surface_height(index, from.x, from.z) || to.y <= _get_cell_surface_height(index, to.x, to.z)) {
+			return index;
+		}
+
+		if (t_max_x < t_max_z) {
+			column += step_column;
+			t = t_max_x;
+			t_max_x += t_delta_x;
+		} else {
+			row += step_row;
+			t = t_max_z;
+			t_max_z += t_delta_z;
+		}
+	}
+
+	return -1;
+}
+
+godot::Vector3 InteractiveGrid3D::get_center_global_position() const {
+	return data.center_global_position;
+}
+
+godot::Transform3D InteractiveGrid3D::get_cell_transform(int p_cell_index) const {
+	return data.cells[p_cell_index]->local_xform;
+}
+
+godot::Transform3D InteractiveGrid3D::get_cell_global_transform(int p_cell_index) const {
+	return data.cells[p_cell_index]->global_xform;
+}
+
+void InteractiveGrid3D::center(godot::Vector3 p_center_position) {
+	GridTraceScope trace("center");
+	trace.add_argument("grid", get_instance_id());
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	data.flags &= ~GFL_CENTERED;
+
+	set_hover_enabled(false);
+	reset_cells_state();
+
+	if (data.streaming_enabled) {
+		// Laid out on the world cells, then filled from their cached chunks.
+		_configure_chunk_store();
+		p_center_position = _snap_to_world_cells(p_center_position, data.streamed_column, data.streamed_row);
+		_layout(p_center_position);
+		_apply_streamed_cells();
+	} else {
+		_layout(p_center_position);
+		_align_cells_with_floor();
+		_scan_environnement_obstacles();
+		_scan_environnement_custom_data();
+	}
+
+	for (int cell_index = 0; cell_index < get_size(); cell_index++) {
+		if (data.material_override.is_valid()) {
+			uint32_t cell_flags = data.cells[cell_index]->flags;
+			godot::Color current_cell_color = data.cells[cell_index]->color;
+			godot::Color new_cell_color{ current_cell_color.r, current_cell_color.g, current_cell_color.b, static_cast<float>(cell_flags) };
+			data.cells.write[cell_index]->color = new_cell_color;
+			data.multimesh->set_instance_custom_data(cell_index, new_cell_color);
+		}
+	}
+
+	set_hover_enabled(true);
+
+	data.flags |= GFL_CENTERED;
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+
+	if (_debug_options.print_logs_enabled) {
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Grid centered.");
+	}
+}
+
+void InteractiveGrid3D::update_custom_data() {
+	GridTraceScope trace("update_custom_data");
+	trace.add_argument("grid", get_instance_id());
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	set_hover_enabled(false);
+	_scan_environnement_custom_data();
+
+	for (int cell_index = 0; cell_index < get_size(); cell_index++) {
+		if (data.material_override.is_valid()) {
+			uint32_t cell_flags = data.cells[cell_index]->flags;
+			godot::Color current_cell_color = data.cells[cell_index]->color;
+			godot::Color new_cell_color{ current_cell_color.r, current_cell_color.g, current_cell_color.b, static_cast<float>(cell_flags) };
+			data.cells.write[cell_index]->color = new_cell_color;
+			data.multimesh->set_instance_custom_data(cell_index, new_cell_color);
+		}
+	}
+
+	set_hover_enabled(true);
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+
+	if (_debug_options.print_logs_enabled) {
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Grid centered.");
+	}
+}
+
+void InteractiveGrid3D::compute_unreachable_cells(int p_start_cell_index) {
+	GridTraceScope trace("compute_unreachable_cells");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
+		return;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	if ((is_visible()) && !(data.flags & GFL_CELL_UNREACHABLE_HIDDEN)) {
+		godot::LocalVector<int> start_cell_indexes;
+		start_cell_indexes.push_back(p_start_cell_index);
+
+		_breadth_first_search(start_cell_indexes);
+		data.flags |= GFL_CELL_UNREACHABLE_HIDDEN;
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+}
+
+void InteractiveGrid3D::compute_unreachable_cells_from(const godot::PackedInt32Array &p_start_cell_indexes) {
+	GridTraceScope trace("compute_unreachable_cells_from");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("sources", p_start_cell_indexes.size());
+
+	godot::LocalVector<int> start_cell_indexes;
+
+	for (int index = 0; index < p_start_cell_indexes.size(); index++) {
+		if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_indexes[index])) {
+			return;
+		}
+		start_cell_indexes.push_back(p_start_cell_indexes[index]);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	if ((is_visible()) && !(data.flags & GFL_CELL_UNREACHABLE_HIDDEN)) {
+		_breadth_first_search(start_cell_indexes);
+		data.flags |= GFL_CELL_UNREACHABLE_HIDDEN;
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+}
+
+godot::PackedInt32Array InteractiveGrid3D::compute_fov(int p_origin_cell_index, int p_radius) {
+	GridTraceScope trace("compute_fov");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("origin", p_origin_cell_index);
+	trace.add_argument("radius", p_radius);
+
+	godot::PackedInt32Array visible_cells;
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return visible_cells;
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_origin_cell_index)) {
+		return visible_cells;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	godot::LocalVector<int> cells;
+	data.field_of_view.compute(p_origin_cell_index, p_radius, cells);
+
+	visible_cells.resize(cells.size());
+	for (uint32_t index = 0; index < cells.size(); index++) {
+		visible_cells.set(index, cells[index]);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+
+	return visible_cells;
+}
+
+godot::PackedInt32Array InteractiveGrid3D::_to_packed_cells(const godot::LocalVector<int> &p_cells) {
+	godot::PackedInt32Array packed_cells;
+	packed_cells.resize(p_cells.size());
+	for (uint32_t index = 0; index < p_cells.size(); index++) {
+		packed_cells.set(index, p_cells[index]);
+	}
+	return packed_cells;
+}
+
+godot::PackedInt32Array InteractiveGrid3D::get_cells_in_radius(int p_origin_cell_index, int p_radius) {
+	GridTraceScope trace("get_cells_in_radius");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("origin", p_origin_cell_index);
+	trace.add_argument("radius", p_radius);
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return godot::PackedInt32Array();
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_origin_cell_index)) {
+		return godot::PackedInt32Array();
+	}
+
+	godot::LocalVector<int> cells;
+	data.area.cells_in_radius(p_origin_cell_index, p_radius, cells);
+	return _to_packed_cells(cells);
+}
+
+godot::PackedInt32Array InteractiveGrid3D::get_cells_in_ring(int p_origin_cell_index, int p_radius) {
+	GridTraceScope trace("get_cells_in_ring");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("origin", p_origin_cell_index);
+	trace.add_argument("radius", p_radius);
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return godot::PackedInt32Array();
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_origin_cell_index)) {
+		return godot::PackedInt32Array();
+	}
+
+	godot::LocalVector<int> cells;
+	data.area.cells_in_ring(p_origin_cell_index, p_radius, cells);
+	return _to_packed_cells(cells);
+}
+
+godot::PackedInt32Array InteractiveGrid3D::get_cells_on_line(int p_from_cell_index, int p_to_cell_index) {
+	GridTraceScope trace("get_cells_on_line");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("from", p_from_cell_index);
+	trace.add_argument("to", p_to_cell_index);
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return godot::PackedInt32Array();
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_from_cell_index) ||
+			is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_to_cell_index)) {
+		return godot::PackedInt32Array();
+	}
+
+	godot::LocalVector<int> cells;
+	data.area.cells_on_line(p_from_cell_index, p_to_cell_index, cells);
+	return _to_packed_cells(cells);
+}
+
+godot::PackedInt32Array InteractiveGrid3D::get_cells_in_cone(int p_origin_cell_index, const godot::Vector2 &p_direction, float p_angle, int p_radius) {
+	GridTraceScope trace("get_cells_in_cone");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("origin", p_origin_cell_index);
+	trace.add_argument("radius", p_radius);
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return godot::PackedInt32Array();
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_origin_cell_index)) {
+		return godot::PackedInt32Array();
+	}
+
+	if (p_direction.x == 0.0f && p_direction.y == 0.0f) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The cone direction must not be zero.");
+		return godot::PackedInt32Array();
+	}
+
+	godot::LocalVector<int> cells;
+	data.area.cells_in_cone(p_origin_cell_index, p_direction.x, p_direction.y, p_angle * DEGREES_TO_RADIANS, p_radius, cells);
+	return _to_packed_cells(cells);
+}
+
+void InteractiveGrid3D::hide_distant_cells(int p_start_cell_index, float p_distance) {
+	GridTraceScope trace("hide_distant_cells");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
+		return;
+	}
+
+	if ((is_visible()) && !(data.flags & GFL_CELL_DISTANT_HIDDEN)) {
+		for (int row = 0; row < data.rows; row++) {
+			for (int column = 0; column < data.columns; column++) {
+				const int index = row * data.columns + column;
+
+				godot::Vector3 start_cell_position = data.cells[p_start_cell_index]->global_xform.origin;
+				godot::Vector3 index_cell_position = data.cells[index]->global_xform.origin;
+
+				if (start_cell_position.distance_to(index_cell_position) > p_distance) {
+					set_cell_visible(index, false);
+					data.cells.write[index]->flags &= ~CFL_ACCESSIBLE;
+					_mark_pathfinding_cell_dirty(index);
+				}
+			}
+		}
+		data.flags |= GFL_CELL_DISTANT_HIDDEN;
+	}
 }
 
-void InteractiveGrid3D::set_cell_shape(const godot::Ref<godot::Shape3D> &p_shape) {
-	if (p_shape == data.cell_shape) {
+void InteractiveGrid3D::set_hover_enabled(bool p_enabled) {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
 		return;
 	}
 
-	data.cell_shape = p_shape;
-	_delete();
+	if (p_enabled) {
+		data.flags |= GFL_HOVER_ENABLED;
+	} else {
+		data.flags &= ~GFL_HOVER_ENABLED;
+	}
 }
 
-godot::Ref<godot::Shape3D> InteractiveGrid3D::get_cell_shape() const {
-	return data.cell_shape;
+bool InteractiveGrid3D::is_hover_enabled() const {
+	return (data.flags & GFL_HOVER_ENABLED) != 0;
 }
 
-void InteractiveGrid3D::set_cell_shape_offset(godot::Vector3 p_offset) {
-	data.cell_shape_offset = p_offset;
+bool InteractiveGrid3D::is_created() const {
+	return (data.flags & GFL_CREATED) != 0;
 }
 
-godot::Vector3 InteractiveGrid3D::get_cell_shape_offset() {
-	return data.cell_shape_offset;
+bool InteractiveGrid3D::is_centered() const {
+	return (data.flags & GFL_CENTERED) != 0;
 }
 
-void InteractiveGrid3D::set_cell_rotation(godot::Vector3 p_rotation) {
-	data.cell_rotation = p_rotation;
-	_delete();
+bool InteractiveGrid3D::is_cell_accessible(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_ACCESSIBLE) != 0;
 }
 
-godot::Vector3 InteractiveGrid3D::get_cell_rotation() {
-	return data.cell_rotation;
+bool InteractiveGrid3D::is_cell_reachable(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_REACHABLE) != 0;
 }
 
-void InteractiveGrid3D::InteractiveGrid3D::set_layout(Layout p_layout) {
-	data.layout_index = p_layout;
-	_delete();
+bool InteractiveGrid3D::is_cell_in_void(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_IN_VOID) != 0;
 }
 
-InteractiveGrid3D::Layout InteractiveGrid3D::get_layout() const {
-	return data.layout_index;
+bool InteractiveGrid3D::is_cell_hovered(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_HOVERED) != 0;
 }
 
-void InteractiveGrid3D::set_movement(Movement p_movement) {
-	data.movement = p_movement;
+bool InteractiveGrid3D::is_cell_selected(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_SELECTED) != 0;
 }
 
-InteractiveGrid3D::Movement InteractiveGrid3D::get_movement() const {
-	return data.movement;
+bool InteractiveGrid3D::is_cell_on_path(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_PATH) != 0;
 }
 
-void InteractiveGrid3D::set_accessible_color(const godot::Color &p_color) {
-	data.accessible_color = p_color;
-	_delete();
+bool InteractiveGrid3D::is_cell_visible(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_VISIBLE) != 0;
 }
 
-godot::Color InteractiveGrid3D::get_accessible_color() const {
-	return data.accessible_color;
+bool InteractiveGrid3D::is_cell_opaque(int p_cell_index) const {
+	return (data.cells[p_cell_index]->flags & CFL_OPAQUE) != 0;
 }
 
-void InteractiveGrid3D::set_unaccessible_color(const godot::Color &p_color) {
-	data.unaccessible_color = p_color;
-	_delete();
-}
+void InteractiveGrid3D::set_cell_opaque(int p_cell_index, bool p_is_opaque) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
 
-godot::Color InteractiveGrid3D::get_unaccessible_color() const {
-	return data.unaccessible_color;
-}
+	if (p_is_opaque) {
+		data.cells.write[p_cell_index]->flags |= CFL_OPAQUE;
+	} else {
+		data.cells.write[p_cell_index]->flags &= ~CFL_OPAQUE;
+	}
 
-void InteractiveGrid3D::set_unreachable_color(const godot::Color &p_color) {
-	data.unreachable_color = p_color;
+	data.field_of_view.set_opaque(p_cell_index, p_is_opaque);
 }
 
-godot::Color InteractiveGrid3D::get_unreachable_color() const {
-	return data.unreachable_color;
-}
+void InteractiveGrid3D::set_cell_accessible(int p_cell_index, bool p_is_accessible) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+		return;
+	}
 
-void InteractiveGrid3D::set_selected_color(const godot::Color &p_color) {
-	data.selected_color = p_color;
-}
+	const bool was_accessible = is_cell_accessible(p_cell_index);
 
-godot::Color InteractiveGrid3D::get_selected_color() const {
-	return data.selected_color;
-}
+	if (p_is_accessible) {
+		data.cells.write[p_cell_index]->flags |= CFL_ACCESSIBLE;
+		set_cell_color(p_cell_index, data.accessible_color);
+	} else if (!p_is_accessible) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_ACCESSIBLE;
+		set_cell_color(p_cell_index, data.unaccessible_color);
+	}
 
-void InteractiveGrid3D::set_path_color(const godot::Color &p_color) {
-	data.path_color = p_color;
+	// Re-asserting the same state each frame keeps the search caches.
+	if (was_accessible != p_is_accessible) {
+		_mark_pathfinding_cell_dirty(p_cell_index);
+	}
 }
 
-godot::Color InteractiveGrid3D::get_path_color() const {
-	return data.path_color;
-}
+void InteractiveGrid3D::set_cell_costs(const godot::PackedFloat32Array &p_costs) {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
 
-void InteractiveGrid3D::set_hovered_color(const godot::Color &p_color) {
-	data.hovered_color = p_color;
-}
+	if (p_costs.size() != get_size()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The number of costs must match the number of cells.");
+		return;
+	}
 
-godot::Color InteractiveGrid3D::get_hovered_color() const {
-	return data.hovered_color;
-}
+	for (int index = 0; index < p_costs.size(); ++index) {
+		if (p_costs[index] < 0.0f || std::isnan(p_costs[index])) {
+			PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell costs must be positive or zero.");
+			return;
+		}
+	}
 
-void InteractiveGrid3D::set_custom_cells_data(const godot::Array &p_custom_cell_data) {
-	data.custom_cell_data = p_custom_cell_data;
+	data.cell_costs = p_costs;
+
+	for (int index = 0; index < data.cells.size(); ++index) {
+		_update_cell_cost(index);
+	}
 }
 
-godot::Array InteractiveGrid3D::get_custom_cells_data() const {
-	return data.custom_cell_data;
+godot::PackedFloat32Array InteractiveGrid3D::get_cell_costs() const {
+	return data.cell_costs;
 }
 
-void InteractiveGrid3D::add_custom_cell_data(int p_cell_index, godot::String p_custom_data_name) {
+void InteractiveGrid3D::set_cell_cost(int p_cell_index, float p_cost) {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
+
 	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
 		return;
 	}
 
-	godot::Ref<CustomCellData> custom_cell_data;
+	if (p_cost < 0.0f || std::isnan(p_cost)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell cost must be positive or zero.");
+		return;
+	}
 
-	for (int index = 0; index < data.custom_cell_data.size(); index++) {
-		custom_cell_data = data.custom_cell_data.get(index);
+	data.cell_costs.set(p_cell_index, p_cost);
+	_update_cell_cost(p_cell_index);
+}
 
-		if (custom_cell_data.is_null()) {
-			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
-			continue;
-		}
+float InteractiveGrid3D::get_cell_cost(int p_cell_index) const {
+	if (p_cell_index < 0 || p_cell_index >= data.cell_costs.size()) {
+		return 1.0f;
+	}
+	return data.cell_costs[p_cell_index];
+}
 
-		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
-			continue;
-		}
+void InteractiveGrid3D::reset_cell_costs() {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
 
-		data.cells.write[p_cell_index]->custom_flags |= custom_cell_data->get_layer_mask();
-		data.cells.write[p_cell_index]->flags |= custom_cell_data->get_layer_mask();
+	data.cell_costs.fill(1.0f);
 
-		if (custom_cell_data->get_custom_color_enabled()) {
-			data.cells.write[p_cell_index]->has_custom_color = true;
-			data.cells.write[p_cell_index]->custom_color = custom_cell_data->get_color();
-			set_cell_color(p_cell_index, data.cells[p_cell_index]->custom_color);
-		}
+	for (int index = 0; index < data.cells.size(); ++index) {
+		_update_cell_cost(index);
 	}
 }
 
-bool InteractiveGrid3D::has_custom_cell_data(int p_cell_index, godot::String p_custom_data_name) {
+void InteractiveGrid3D::set_cell_reachable(int p_cell_index, bool p_is_reachable) {
 	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return false;
+		return;
 	}
 
-	godot::Ref<CustomCellData> custom_cell_data;
-
-	for (int index = 0; index < data.custom_cell_data.size(); index++) {
-		custom_cell_data = data.custom_cell_data.get(index);
-
-		if (custom_cell_data.is_null()) {
-			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
-			continue;
-		}
-
-		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
-			continue;
-		}
-
-		uint32_t cell_flags = data.cells[p_cell_index]->flags;
-		uint32_t custom_cell_data_flags = custom_cell_data->get_layer_mask();
-
-		if ((cell_flags & custom_cell_data_flags) == custom_cell_data_flags) {
-			return true;
-		}
+	if (p_is_reachable) {
+		data.cells.write[p_cell_index]->flags |= CFL_REACHABLE;
+	} else if (!p_is_reachable) {
+		data.cells.write[p_cell_index]->flags &= ~CFL_REACHABLE;
+		set_cell_color(p_cell_index, data.unreachable_color);
 	}
-
-	return false;
 }
 
-void InteractiveGrid3D::clear_custom_cell_data(int p_cell_index, godot::String p_custom_data_name, bool p_clear_custom_color) {
+void InteractiveGrid3D::set_cell_visible(int p_cell_index, bool p_is_visible) {
 	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
 		return;
 	}
 
-	godot::Ref<CustomCellData> custom_cell_data;
+	godot::Color current_cell_color = data.cells[p_cell_index]->color;
 
-	for (int index = 0; index < data.custom_cell_data.size(); index++) {
-		custom_cell_data = data.custom_cell_data.get(index);
+	if (p_is_visible) {
+		data.cells.write[p_cell_index]->flags |= CFL_VISIBLE;
+		set_cell_color(p_cell_index, current_cell_color);
+	} else if (!p_is_visible) {
+		current_cell_color.a = 0.0;
+		data.multimesh->set_instance_custom_data(p_cell_index, current_cell_color);
+		data.cells.write[p_cell_index]->flags &= ~CFL_VISIBLE;
+	}
+}
 
-		if (custom_cell_data.is_null()) {
-			godot::print_error("custom_cell_data is NULL at index: ", p_cell_index);
-			continue;
-		}
+void InteractiveGrid3D::InteractiveGrid3D::reset_cells_state() {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return;
+	}
 
-		if (p_custom_data_name != custom_cell_data->get_custom_data_name()) {
-			continue;
+	// Base cell costs are set by scripts and survive center(), see reset_cell_costs.
+	for (int row = 0; row < data.rows; row++) {
+		for (int column = 0; column < data.columns; column++) {
+			const int index = row * data.columns + column;
+			clear_all_custom_cell_data(index);
+			data.cells.write[index]->flags = 0;
+			set_cell_accessible(index, true);
 		}
+	}
 
-		if (p_clear_custom_color) {
-			data.cells.write[p_cell_index]->has_custom_color = false;
-			set_cell_color(p_cell_index, data.accessible_color);
-		}
+	data.field_of_view.clear_opaque();
 
-		break;
-	}
+	data.flags &= ~GFL_CELL_UNREACHABLE_HIDDEN;
+	data.flags &= ~GFL_CELL_DISTANT_HIDDEN;
+
+	data.hovered_cell_index = -1;
+	data.selected_cells.clear();
+	data.highlighted_path_cells.clear();
 }
 
-void InteractiveGrid3D::clear_all_custom_cell_data(int p_cell_index) {
+void InteractiveGrid3D::set_cell_color(int p_cell_index, const godot::Color &p_color) {
 	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
 		return;
 	}
 
-	data.cells.write[p_cell_index]->flags &= ~data.cells[p_cell_index]->custom_flags;
-	data.cells.write[p_cell_index]->custom_flags = 0;
-	data.cells.write[p_cell_index]->has_custom_color = false;
-	set_cell_color(p_cell_index, data.accessible_color);
+	if (data.material_override.is_valid()) {
+		uint32_t cell_flags = data.cells[p_cell_index]->flags;
+		godot::Color new_cell_color{ p_color.r, p_color.g, p_color.b, static_cast<float>(cell_flags) };
+		data.cells.write[p_cell_index]->color = new_cell_color;
+		data.multimesh->set_instance_custom_data(p_cell_index, new_cell_color);
+	} else {
+		data.cells.write[p_cell_index]->color = p_color;
+		data.multimesh->set_instance_custom_data(p_cell_index, p_color);
+	}
 }
 
-void InteractiveGrid3D::set_material_override(const godot::Ref<godot::Material> &p_material) {
-	data.material_override = p_material;
-	_delete();
+void InteractiveGrid3D::set_obstacles_collision_masks(int p_mask) {
+	data.obstacles_collision_masks = p_mask;
+}
+
+int InteractiveGrid3D::get_obstacles_collision_masks() {
+	return data.obstacles_collision_masks;
+}
+
+void InteractiveGrid3D::set_floor_collision_mask(int p_mask) {
+	data.floor_collision_mask = p_mask;
 }
 
-godot::Ref<godot::Material> InteractiveGrid3D::get_material_override() const {
-	return data.material_override;
+int InteractiveGrid3D::get_floor_collision_mask() {
+	return data.floor_collision_mask;
 }
 
-void InteractiveGrid3D::apply_default_material() {
-	if (data.multimesh_instance == nullptr) {
-		PrintError(__FILE__, __FUNCTION__, __LINE__, "No MultiMeshInstance found.");
+void InteractiveGrid3D::_select_cell(int p_cell_index) {
+	if (p_cell_index == -1) {
+		return;
+	} else if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
 		return;
 	}
 
-	godot::Ref<godot::Shader> shader;
-	shader.instantiate();
-	shader->set_code(default_shader_code);
+	// Already selected cells keep their place in the selection order.
+	if (is_cell_selected(p_cell_index)) {
+		return;
+	}
 
-	godot::Ref<godot::ShaderMaterial> shader_material;
-	shader_material.instantiate();
-	shader_material->set_shader(shader);
+	bool visible = is_cell_visible(p_cell_index);
+	if (!visible) {
+		return;
+	}
 
-	data.multimesh_instance->set_material_override(shader_material);
+	bool unreachable = !is_cell_reachable(p_cell_index);
+	if (unreachable) {
+		return;
+	}
 
-	if (_debug_options.print_logs_enabled) {
-		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Default ShaderMaterial created and applied.");
+	bool accessible = is_cell_accessible(p_cell_index);
+	if (accessible) {
+		_set_cell_selected(p_cell_index, true);
+		data.selected_cells.push_back(p_cell_index);
 	}
 }
 
-void InteractiveGrid3D::highlight_on_hover(godot::Vector3 p_global_position) {
+void InteractiveGrid3D::select_cell(int p_cell_index) {
+	GridTraceScope trace("select_cell");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("cell", p_cell_index);
+
 	if (is_visible() == false) {
 		return;
 	}
 
-	if (is_centered() == false) {
-		return;
-	}
+	_select_cell(p_cell_index);
+}
 
-	if (is_hover_enabled() == false) {
+void InteractiveGrid3D::select_cells(const godot::PackedInt32Array &p_cell_indexes) {
+	GridTraceScope trace("select_cells");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("cells", p_cell_indexes.size());
+
+	if (is_visible() == false) {
 		return;
 	}
 
-	int closest_index = get_cell_index_from_global_position(p_global_position);
-
-	if (closest_index == -1 || !is_cell_visible(closest_index)) {
-		if (data.hovered_cell_index > -1) {
-			_set_cell_hovered(data.hovered_cell_index, false);
+	const int32_t *cell_indexes = p_cell_indexes.ptr();
+	for (int64_t i = 0; i < p_cell_indexes.size(); i++) {
+		_select_cell(cell_indexes[i]);
+	}
+}
 
-			if (!is_cell_selected(data.hovered_cell_index)) {
-				if (data.cells[data.hovered_cell_index]->has_custom_color) {
-					set_cell_color(data.hovered_cell_index, data.cells[data.hovered_cell_index]->custom_color);
-				} else {
-					set_cell_color(data.hovered_cell_index, data.accessible_color);
-				}
-			}
+void InteractiveGrid3D::select_rect(int p_from_cell_index, int p_to_cell_index) {
+	GridTraceScope trace("select_rect");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("from", p_from_cell_index);
+	trace.add_argument("to", p_to_cell_index);
 
-			data.hovered_cell_index = -1;
-		}
+	if (is_visible() == false) {
 		return;
 	}
 
-	if (closest_index == data.hovered_cell_index) {
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_from_cell_index) ||
+			is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_to_cell_index)) {
 		return;
 	}
 
-	if (data.hovered_cell_index > -1) {
-		_set_cell_hovered(data.hovered_cell_index, false);
+	const int first_column = std::min(p_from_cell_index % data.columns, p_to_cell_index % data.columns);
+	const int last_column = std::max(p_from_cell_index % data.columns, p_to_cell_index % data.columns);
+	const int first_row = std::min(p_from_cell_index / data.columns, p_to_cell_index / data.columns);
+	const int last_row = std::max(p_from_cell_index / data.columns, p_to_cell_index / data.columns);
 
-		if (!is_cell_selected(data.hovered_cell_index)) {
-			if (data.cells[data.hovered_cell_index]->has_custom_color) {
-				set_cell_color(data.hovered_cell_index, data.cells[data.hovered_cell_index]->custom_color);
-			} else {
-				set_cell_color(data.hovered_cell_index, data.accessible_color);
-			}
+	for (int row = first_row; row <= last_row; row++) {
+		for (int column = first_column; column <= last_column; column++) {
+			_select_cell(row * data.columns + column);
 		}
+	}
+}
 
-		data.hovered_cell_index = -1;
+void InteractiveGrid3D::select_polygon(const godot::PackedVector2Array &p_polygon) {
+	GridTraceScope trace("select_polygon");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("points", p_polygon.size());
+
+	if (is_visible() == false) {
+		return;
 	}
 
-	if (!is_cell_accessible(closest_index)) {
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
 		return;
 	}
 
-	if (!is_cell_reachable(closest_index)) {
+	const int64_t point_count = p_polygon.size();
+	if (point_count < 3) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The polygon needs at least 3 points.");
 		return;
 	}
 
-	if (!is_cell_selected(closest_index)) {
-		data.hovered_cell_index = closest_index;
-		_set_cell_hovered(data.hovered_cell_index, true);
+	const godot::Vector2 *points = p_polygon.ptr();
+
+	godot::Vector2 min_point = points[0];
+	godot::Vector2 max_point = points[0];
+	for (int64_t i = 1; i < point_count; i++) {
+		min_point.x = std::min(min_point.x, points[i].x);
+		min_point.y = std::min(min_point.y, points[i].y);
+		max_point.x = std::max(max_point.x, points[i].x);
+		max_point.y = std::max(max_point.y, points[i].y);
+	}
+
+	// The polygon lies on the XZ plane: a cell is inside when the crossing
+	// count of a ray from its global position is odd.
+	for (int index = 0; index < data.cells.size(); index++) {
+		const godot::Vector3 &position = data.cells[index]->global_xform.origin;
+		if (position.x < min_point.x || position.x > max_point.x || position.z < min_point.y || position.z > max_point.y) {
+			continue;
+		}
+
+		bool inside = false;
+		for (int64_t i = 0, j = point_count - 1; i < point_count; j = i++) {
+			const godot::Vector2 &a = points[i];
+			const godot::Vector2 &b = points[j];
+			if ((a.y > position.z) != (b.y > position.z) &&
+					position.x < (b.x - a.x) * (position.z - a.y) / (b.y - a.y) + a.x) {
+				inside = !inside;
+			}
+		}
+
+		if (inside) {
+			_select_cell(index);
+		}
 	}
 }
 
-void InteractiveGrid3D::highlight_path(const godot::PackedInt64Array &p_path) {
-	for (int step = 0; step < p_path.size(); step++) {
-		int cell_index = p_path[step];
-		_set_cell_on_path(cell_index, true);
+godot::Array InteractiveGrid3D::get_selected_cells() {
+	godot::Array selected_cells;
+	selected_cells.resize(data.selected_cells.size());
+	for (int64_t i = 0; i < data.selected_cells.size(); i++) {
+		selected_cells[i] = data.selected_cells[i];
 	}
+	return selected_cells;
 }
 
-godot::Vector3 InteractiveGrid3D::get_cell_global_position(int p_cell_index) const {
-	godot::Vector3 cell_global_position = data.cells[p_cell_index]->global_xform.origin;
-	return cell_global_position;
+godot::PackedInt32Array InteractiveGrid3D::get_selected_cell_indexes() const {
+	// Packed arrays are copy-on-write, the selection is shared until modified.
+	return data.selected_cells;
 }
 
-int InteractiveGrid3D::get_cell_index_from_global_position(godot::Vector3 p_global_position) const {
-	if (!(data.flags & GFL_CREATED)) {
-		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created.");
+int InteractiveGrid3D::get_latest_selected() const {
+	if (data.selected_cells.is_empty()) {
 		return -1;
 	}
+	return data.selected_cells[data.selected_cells.size() - 1];
+}
 
-	if (!data.multimesh.is_valid()) {
-		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid multimesh is not valid.");
-		return -1;
+godot::PackedInt64Array InteractiveGrid3D::get_path(int p_start_cell_index, int p_target_cell_index) {
+	GridTraceScope trace("get_path");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+	trace.add_argument("target", p_target_cell_index);
+
+	godot::PackedInt64Array path;
+
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return path;
 	}
 
-	float center_to_edge_x{ 0.0f }, center_to_edge_z{ 0.0f };
-	godot::Vector3 top_left_global_position;
+	auto start = std::chrono::high_resolution_clock::now();
 
-	switch (data.layout_index) {
-		case Layout::LAYOUT_SQUARE:
+	// Out of bounds queries are not cached so their errors are reported every time.
+	const int cell_count = data.cells.size();
+	const bool cacheable = p_start_cell_index >= 0 && p_start_cell_index < cell_count && p_target_cell_index >= 0 && p_target_cell_index < cell_count;
 
-			center_to_edge_x = (data.columns / 2) * data.cell_size.x + data.cell_size.x / 2;
-			center_to_edge_z = (data.rows / 2) * data.cell_size.y + data.cell_size.y / 2;
+	// The topology version is bumped as soon as a change is recorded, so a
+	// hit is valid even before the pending changes are synced.
+	const bool cache_hit = cacheable && data.path_cache.get(p_start_cell_index, p_target_cell_index, data.movement, data.topology_version, path);
 
-			top_left_global_position.x = data.center_global_position.x - center_to_edge_x;
-			top_left_global_position.z = data.center_global_position.z - center_to_edge_z;
+	if (cache_hit) {
+		if (_debug_options.print_logs_enabled) {
+			PrintLine(__FILE__, __FUNCTION__, __LINE__, "Path served from the cache.");
+		}
+	} else if (!cacheable) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell index out of bounds.");
+	} else {
+		_sync_pathfinder();
 
-			if (!(data.rows % 2)) { // Even.
-				if (p_global_position.x > (data.center_global_position.x + center_to_edge_x - data.cell_size.x) || p_global_position.x < (data.center_global_position.x - center_to_edge_x)) {
-					return -1;
-				}
-				if (p_global_position.z > (data.center_global_position.z + center_to_edge_z - data.cell_size.y) || p_global_position.z < (data.center_global_position.z - center_to_edge_z)) {
-					return -1;
-				}
+		// Same native searches as the asynchronous path requests.
+		godot::LocalVector<int> cell_path;
+		if (_is_hierarchical_pathfinding_usable(p_start_cell_index)) {
+			data.hierarchy.find_path(p_start_cell_index, p_target_cell_index, cell_path);
+		} else {
+			_update_pathfinding_graph();
+
+			if (_is_jump_point_search_usable()) {
+				data.pathfinder.find_path_jps(p_start_cell_index, p_target_cell_index, cell_path);
 			} else {
-				if (p_global_position.x > (data.center_global_position.x + center_to_edge_x) || p_global_position.x < (data.center_global_position.x - center_to_edge_x)) {
-					return -1;
-				}
-				if (p_global_position.z > (data.center_global_position.z + center_to_edge_z) || p_global_position.z < (data.center_global_position.z - center_to_edge_z)) {
-					return -1;
-				}
+				data.pathfinder.find_path(p_start_cell_index, p_target_cell_index, cell_path);
 			}
-			break;
-		case Layout::LAYOUT_HEXAGONAL:
+		}
 
-			const float hex_short_diagonal = data.cell_size.x; // s = a · √3
-			const float hex_side_length = hex_short_diagonal / sqrt(3); // a = s / √3.
-			const float hex_side_to_side = data.cell_size.x / 2;
-			const float hex_inradius = hex_side_length * sqrt(3) / 2; // r = a · √3 / 2.
+		path.resize(cell_path.size());
+		for (uint32_t step = 0; step < cell_path.size(); step++) {
+			path.set(step, cell_path[step]);
+		}
+	}
 
-			float center_to_edge_x = (data.columns / 2) * data.cell_size.x;
-			float center_to_edge_z = (data.rows / 2) * data.cell_size.y;
+	if (cacheable && !cache_hit) {
+		data.path_cache.put(p_start_cell_index, p_target_cell_index, data.movement, data.topology_version, path);
+	}
 
-			if (data.rows % 2) { // Odd.
-				center_to_edge_z += hex_side_length;
-			}
+	auto end = std::chrono::high_resolution_clock::now();
+	data.profiler.record(GridProfiler::PHASE_GET_PATH, start, end, path.size());
 
-			top_left_global_position.x = data.center_global_position.x - center_to_edge_x;
-			top_left_global_position.z = data.center_global_position.z - center_to_edge_z;
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
 
-			if (p_global_position.x < (top_left_global_position.x - hex_side_to_side)) {
-				return -1;
-			}
+	return path;
+}
 
-			if (p_global_position.x > (top_left_global_position.x + center_to_edge_x * 2 + data.cell_size.x)) {
-				return -1;
-			}
+godot::PackedVector3Array InteractiveGrid3D::get_world_path(int p_start_cell_index, int p_target_cell_index, bool p_smooth) {
+	GridTraceScope trace("get_world_path");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+	trace.add_argument("target", p_target_cell_index);
+	trace.add_argument("smooth", p_smooth);
 
-			if (p_global_position.z < top_left_global_position.z) {
-				return -1;
-			}
+	godot::PackedVector3Array world_path;
 
-			if (p_global_position.z > (top_left_global_position.z + center_to_edge_z * 2)) {
-				return -1;
-			}
+	const godot::PackedInt64Array path = get_path(p_start_cell_index, p_target_cell_index);
+	if (path.is_empty()) {
+		return world_path;
 	}
 
-	float closest_distance = std::numeric_limits<float>::max();
-	int closest_index = -1;
-
-	for (int row = 0; row < data.rows; row++) {
-		for (int column = 0; column < data.columns; column++) {
-			const int index =
-					row * data.columns + column;
+	godot::LocalVector<int> waypoints;
+	waypoints.reserve(path.size());
+	for (int64_t step = 0; step < path.size(); step++) {
+		waypoints.push_back(static_cast<int>(path[step]));
+	}
 
-			const godot::Vector3 cell_pos = data.cells[index]->global_xform.origin;
-			const float distance = p_global_position.distance_to(cell_pos);
+	if (p_smooth) {
+		// A cached path can be served before the pending changes are synced.
+		_sync_pathfinder();
 
-			if (distance < closest_distance) {
-				closest_distance = distance;
-				closest_index = index;
-			}
-		}
+		godot::LocalVector<int> smoothed_path;
+		data.pathfinder.smooth_path(waypoints, smoothed_path);
+		waypoints = smoothed_path;
 	}
 
-	return closest_index;
-}
+	// Cell origins are aligned with the floor, so the waypoints follow the terrain.
+	world_path.resize(waypoints.size());
+	for (uint32_t step = 0; step < waypoints.size(); step++) {
+		world_path.set(step, data.cells[waypoints[step]]->global_xform.origin);
+	}
 
-godot::Vector3 InteractiveGrid3D::get_center_global_position() const {
-	return data.center_global_position;
+	return world_path;
 }
 
-godot::Transform3D InteractiveGrid3D::get_cell_transform(int p_cell_index) const {
-	return data.cells[p_cell_index]->local_xform;
-}
+godot::Dictionary InteractiveGrid3D::get_paths(int p_start_cell_index, const godot::PackedInt32Array &p_target_cell_indexes) {
+	GridTraceScope trace("get_paths");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+	trace.add_argument("targets", p_target_cell_indexes.size());
 
-godot::Transform3D InteractiveGrid3D::get_cell_global_transform(int p_cell_index) const {
-	return data.cells[p_cell_index]->global_xform;
-}
+	godot::Dictionary result;
 
-void InteractiveGrid3D::center(godot::Vector3 p_center_position) {
 	if (!(data.flags & GFL_CREATED)) {
 		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
-		return;
+		return result;
 	}
 
-	auto start = std::chrono::high_resolution_clock::now();
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
+		return result;
+	}
 
-	data.flags &= ~GFL_CENTERED;
+	auto start = std::chrono::high_resolution_clock::now();
 
-	set_hover_enabled(false);
-	reset_cells_state();
-	_layout(p_center_position);
-	_align_cells_with_floor();
-	_scan_environnement_obstacles();
-	_scan_environnement_custom_data();
-	_configure_astar();
+	_sync_pathfinder();
 
-	for (int cell_index = 0; cell_index < get_size(); cell_index++) {
-		if (data.material_override.is_valid()) {
-			uint32_t cell_flags = data.cells[cell_index]->flags;
-			godot::Color current_cell_color = data.cells[cell_index]->color;
-			godot::Color new_cell_color{ current_cell_color.r, current_cell_color.g, current_cell_color.b, static_cast<float>(cell_flags) };
-			data.cells.write[cell_index]->color = new_cell_color;
-			data.multimesh->set_instance_custom_data(cell_index, new_cell_color);
-		}
+	godot::LocalVector<int> targets;
+	targets.resize(p_target_cell_indexes.size());
+	for (int index = 0; index < p_target_cell_indexes.size(); index++) {
+		targets[index] = p_target_cell_indexes[index];
 	}
 
-	set_hover_enabled(true);
+	godot::LocalVector<int> paths;
+	godot::LocalVector<int> offsets;
+	data.pathfinder.find_paths(p_start_cell_index, targets, paths, offsets);
 
-	data.flags |= GFL_CENTERED;
+	result["paths"] = _to_packed_cells(paths);
+	result["offsets"] = _to_packed_cells(offsets);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
@@ -1419,59 +3532,51 @@ void InteractiveGrid3D::center(godot::Vector3 p_center_position) {
 		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
 	}
 
-	if (_debug_options.print_logs_enabled) {
-		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Grid centered.");
-	}
+	return result;
 }
 
-void InteractiveGrid3D::update_custom_data() {
-	if (!(data.flags & GFL_CREATED)) {
-		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
-		return;
-	}
-
-	auto start = std::chrono::high_resolution_clock::now();
-
-	set_hover_enabled(false);
-	_scan_environnement_custom_data();
-	_configure_astar();
-
-	for (int cell_index = 0; cell_index < get_size(); cell_index++) {
-		if (data.material_override.is_valid()) {
-			uint32_t cell_flags = data.cells[cell_index]->flags;
-			godot::Color current_cell_color = data.cells[cell_index]->color;
-			godot::Color new_cell_color{ current_cell_color.r, current_cell_color.g, current_cell_color.b, static_cast<float>(cell_flags) };
-			data.cells.write[cell_index]->color = new_cell_color;
-			data.multimesh->set_instance_custom_data(cell_index, new_cell_color);
-		}
-	}
-
-	set_hover_enabled(true);
+godot::Dictionary InteractiveGrid3D::get_cooperative_paths(const godot::PackedInt32Array &p_start_cell_indexes, const godot::PackedInt32Array &p_target_cell_indexes, int p_max_time_steps) {
+	GridTraceScope trace("get_cooperative_paths");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("agents", p_start_cell_indexes.size());
+	trace.add_argument("max_time_steps", p_max_time_steps);
 
-	auto end = std::chrono::high_resolution_clock::now();
+	godot::Dictionary result;
 
-	if (_debug_options.print_execution_time_enabled) {
-		std::chrono::duration<double, std::milli> duration = end - start;
-		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	if (!(data.flags & GFL_CREATED)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
+		return result;
 	}
 
-	if (_debug_options.print_logs_enabled) {
-		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Grid centered.");
+	if (p_start_cell_indexes.size() != p_target_cell_indexes.size()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The number of start cells must match the number of target cells.");
+		return result;
 	}
-}
 
-void InteractiveGrid3D::compute_unreachable_cells(int p_start_cell_index) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
-		return;
+	godot::LocalVector<int> starts;
+	godot::LocalVector<int> targets;
+	for (int index = 0; index < p_start_cell_indexes.size(); index++) {
+		if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_indexes[index]) ||
+				is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_target_cell_indexes[index])) {
+			return result;
+		}
+		starts.push_back(p_start_cell_indexes[index]);
+		targets.push_back(p_target_cell_indexes[index]);
 	}
 
 	auto start = std::chrono::high_resolution_clock::now();
 
-	if ((is_visible()) && !(data.flags & GFL_CELL_UNREACHABLE_HIDDEN)) {
-		_configure_astar();
-		_breadth_first_search(p_start_cell_index);
-		data.flags |= GFL_CELL_UNREACHABLE_HIDDEN;
-	}
+	_sync_pathfinder();
+
+	// Enough time to cross the grid and let every other agent go by.
+	const int max_time_steps = p_max_time_steps > 0 ? p_max_time_steps : 2 * (data.columns + data.rows) + starts.size();
+
+	godot::LocalVector<int> paths;
+	godot::LocalVector<int> offsets;
+	data.cooperative_planner.plan(&data.pathfinder, starts, targets, max_time_steps, paths, offsets);
+
+	result["paths"] = _to_packed_cells(paths);
+	result["offsets"] = _to_packed_cells(offsets);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
@@ -1479,229 +3584,301 @@ void InteractiveGrid3D::compute_unreachable_cells(int p_start_cell_index) {
 		std::chrono::duration<double, std::milli> duration = end - start;
 		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
 	}
-}
 
-void InteractiveGrid3D::hide_distant_cells(int p_start_cell_index, float p_distance) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
-		return;
-	}
+	return result;
+}
 
-	if ((is_visible()) && !(data.flags & GFL_CELL_DISTANT_HIDDEN)) {
-		for (int row = 0; row < data.rows; row++) {
-			for (int column = 0; column < data.columns; column++) {
-				const int index = row * data.columns + column;
+int InteractiveGrid3D::get_topology_version() const {
+	return static_cast<int>(data.topology_version);
+}
 
-				godot::Vector3 start_cell_position = data.cells[p_start_cell_index]->global_xform.origin;
-				godot::Vector3 index_cell_position = data.cells[index]->global_xform.origin;
+godot::Dictionary InteractiveGrid3D::get_path_cache_stats() const {
+	godot::Dictionary stats;
+	stats["hits"] = static_cast<int64_t>(data.path_cache.get_hits());
+	stats["misses"] = static_cast<int64_t>(data.path_cache.get_misses());
+	stats["size"] = data.path_cache.get_size();
+	stats["capacity"] = data.path_cache.get_capacity();
+	stats["topology_version"] = data.topology_version;
+	return stats;
+}
 
-				if (start_cell_position.distance_to(index_cell_position) > p_distance) {
-					set_cell_visible(index, false);
-					data.cells.write[index]->flags &= ~CFL_ACCESSIBLE;
-				}
-			}
-		}
-		data.flags |= GFL_CELL_DISTANT_HIDDEN;
-	}
+void InteractiveGrid3D::clear_path_cache() {
+	data.path_cache.clear();
+	data.path_cache.reset_stats();
 }
 
-void InteractiveGrid3D::set_hover_enabled(bool p_enabled) {
+int InteractiveGrid3D::request_path(int p_start_cell_index, int p_target_cell_index) {
+	GridTraceScope trace("request_path");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+	trace.add_argument("target", p_target_cell_index);
+
 	if (!(data.flags & GFL_CREATED)) {
 		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
-		return;
+		return -1;
 	}
 
-	if (p_enabled) {
-		data.flags |= GFL_HOVER_ENABLED;
-	} else {
-		data.flags &= ~GFL_HOVER_ENABLED;
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index) ||
+			is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_target_cell_index)) {
+		return -1;
 	}
-}
 
-bool InteractiveGrid3D::is_hover_enabled() const {
-	return (data.flags & GFL_HOVER_ENABLED) != 0;
+	return data.path_requests.push(p_start_cell_index, p_target_cell_index);
 }
 
-bool InteractiveGrid3D::is_created() const {
-	return (data.flags & GFL_CREATED) != 0;
+InteractiveGrid3D::PathRequestStatus InteractiveGrid3D::get_path_request_status(int p_request_id) const {
+	return static_cast<PathRequestStatus>(data.path_requests.get_status(p_request_id));
 }
 
-bool InteractiveGrid3D::is_centered() const {
-	return (data.flags & GFL_CENTERED) != 0;
-}
+godot::PackedInt64Array InteractiveGrid3D::get_requested_path(int p_request_id) {
+	godot::PackedInt64Array path;
 
-bool InteractiveGrid3D::is_cell_accessible(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_ACCESSIBLE) != 0;
-}
+	if (!data.path_requests.take_result(p_request_id, path)) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "The path request is not done: ", p_request_id);
+	}
 
-bool InteractiveGrid3D::is_cell_reachable(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_REACHABLE) != 0;
+	return path;
 }
 
-bool InteractiveGrid3D::is_cell_in_void(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_IN_VOID) != 0;
+void InteractiveGrid3D::cancel_path_request(int p_request_id) {
+	data.path_requests.cancel(p_request_id);
 }
 
-bool InteractiveGrid3D::is_cell_hovered(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_HOVERED) != 0;
+void InteractiveGrid3D::_complete_path_request(int p_request_id, const godot::PackedInt64Array &p_path) {
+	data.path_requests.complete(p_request_id, p_path);
+	emit_signal("path_ready", p_request_id, p_path);
 }
 
-bool InteractiveGrid3D::is_cell_selected(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_SELECTED) != 0;
-}
+void InteractiveGrid3D::_run_path_request_batch() {
+	// Runs on a worker thread: only the batch and the snapshot are touched.
+	GridTraceScope trace("path_request_batch");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("requests", data.path_requests.get_batch_size());
 
-bool InteractiveGrid3D::is_cell_on_path(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_PATH) != 0;
+	data.path_requests.run_batch();
 }
 
-bool InteractiveGrid3D::is_cell_visible(int p_cell_index) const {
-	return (data.cells[p_cell_index]->flags & CFL_VISIBLE) != 0;
-}
+void InteractiveGrid3D::_process_path_requests() {
+	if (data.path_request_task_id != -1) {
+		godot::WorkerThreadPool *worker_thread_pool = godot::WorkerThreadPool::get_singleton();
+		if (!worker_thread_pool->is_task_completed(data.path_request_task_id)) {
+			return;
+		}
 
-void InteractiveGrid3D::set_cell_accessible(int p_cell_index, bool p_is_accessible) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
-	}
+		worker_thread_pool->wait_for_task_completion(data.path_request_task_id);
+		data.path_request_task_id = -1;
+		data.path_requests.finish_batch();
 
-	if (p_is_accessible) {
-		data.cells.write[p_cell_index]->flags |= CFL_ACCESSIBLE;
-		set_cell_color(p_cell_index, data.accessible_color);
-	} else if (!p_is_accessible) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_ACCESSIBLE;
-		set_cell_color(p_cell_index, data.unaccessible_color);
+		for (const GridPathRequestQueue::Request &request : data.path_requests.get_batch()) {
+			if (data.path_requests.is_cancelled(request.id)) {
+				continue;
+			}
+
+			if (data.path_requests.get_snapshot_version() == data.topology_version) {
+				data.path_cache.put(request.start_cell_index, request.target_cell_index, data.movement, data.topology_version, request.path);
+			}
+
+			_complete_path_request(request.id, request.path);
+		}
+
+		data.path_requests.clear_batch();
 	}
-}
 
-void InteractiveGrid3D::set_cell_reachable(int p_cell_index, bool p_is_reachable) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+	if (data.path_requests.get_pending_count() == 0 || !(data.flags & GFL_CREATED)) {
 		return;
 	}
 
-	if (p_is_reachable) {
-		data.cells.write[p_cell_index]->flags |= CFL_REACHABLE;
-	} else if (!p_is_reachable) {
-		data.cells.write[p_cell_index]->flags &= ~CFL_REACHABLE;
-		set_cell_color(p_cell_index, data.unreachable_color);
+	auto start = std::chrono::high_resolution_clock::now();
+
+	_sync_pathfinder();
+
+	// Cached paths are served right away and do not count against the budget.
+	uint32_t consumed = 0;
+	godot::PackedInt64Array cached_path;
+
+	for (; consumed < data.path_requests.get_pending_count(); consumed++) {
+		const GridPathRequestQueue::Request &request = data.path_requests.get_pending(consumed);
+
+		if (data.path_cache.get(request.start_cell_index, request.target_cell_index, data.movement, data.topology_version, cached_path)) {
+			_complete_path_request(request.id, cached_path);
+		} else if (data.path_requests.get_batch_size() < data.path_requests_per_frame) {
+			data.path_requests.add_to_batch(consumed);
+		} else {
+			break;
+		}
 	}
-}
 
-void InteractiveGrid3D::set_cell_visible(int p_cell_index, bool p_is_visible) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
+	data.path_requests.consume_pending(consumed);
+
+	if (!data.path_requests.start_batch(data.pathfinder, data.topology_version, _is_jump_point_search_usable())) {
 		return;
 	}
 
-	godot::Color current_cell_color = data.cells[p_cell_index]->color;
+	data.path_request_task_id = godot::WorkerThreadPool::get_singleton()->add_task(
+			callable_mp(this, &InteractiveGrid3D::_run_path_request_batch), false, "InteractiveGrid3D path requests");
 
-	if (p_is_visible) {
-		data.cells.write[p_cell_index]->flags |= CFL_VISIBLE;
-		set_cell_color(p_cell_index, current_cell_color);
-	} else if (!p_is_visible) {
-		current_cell_color.a = 0.0;
-		data.multimesh->set_instance_custom_data(p_cell_index, current_cell_color);
-		data.cells.write[p_cell_index]->flags &= ~CFL_VISIBLE;
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
 	}
 }
 
-void InteractiveGrid3D::InteractiveGrid3D::reset_cells_state() {
+godot::Dictionary InteractiveGrid3D::get_reachable_cells(int p_start_cell_index, float p_max_cost) {
+	GridTraceScope trace("get_reachable_cells");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("start", p_start_cell_index);
+	trace.add_argument("max_cost", static_cast<int64_t>(p_max_cost));
+
 	if (!(data.flags & GFL_CREATED)) {
 		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
-		return;
+		return godot::Dictionary();
 	}
 
-	for (int row = 0; row < data.rows; row++) {
-		for (int column = 0; column < data.columns; column++) {
-			const int index = row * data.columns + column;
-			clear_all_custom_cell_data(index);
-			data.cells.write[index]->flags = 0;
-			set_cell_accessible(index, true);
-		}
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_start_cell_index)) {
+		return godot::Dictionary();
 	}
 
-	data.flags &= ~GFL_CELL_UNREACHABLE_HIDDEN;
-	data.flags &= ~GFL_CELL_DISTANT_HIDDEN;
+	_sync_pathfinder();
 
-	data.hovered_cell_index = -1;
-	data.selected_cells.clear();
-}
+	if (data.reachable_cache_valid && data.reachable_start_cell_index == p_start_cell_index && data.reachable_max_cost == p_max_cost) {
+		return data.reachable_cells.duplicate();
+	}
 
-void InteractiveGrid3D::set_cell_color(int p_cell_index, const godot::Color &p_color) {
-	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
+	auto start = std::chrono::high_resolution_clock::now();
+
+	godot::LocalVector<int> sources;
+	sources.push_back(p_start_cell_index);
+
+	godot::LocalVector<int> cells;
+	godot::LocalVector<float> costs;
+	godot::LocalVector<int> parents;
+	data.pathfinder.flood(sources, p_max_cost, false, cells, costs, parents);
+
+	// Only the cells of the previous range are cleared.
+	for (const int &index : data.reachable_cell_indexes) {
+		data.reachable_parents[index] = -2;
 	}
+	data.reachable_cell_indexes.clear();
 
-	if (data.material_override.is_valid()) {
-		uint32_t cell_flags = data.cells[p_cell_index]->flags;
-		godot::Color new_cell_color{ p_color.r, p_color.g, p_color.b, static_cast<float>(cell_flags) };
-		data.cells.write[p_cell_index]->color = new_cell_color;
-		data.multimesh->set_instance_custom_data(p_cell_index, new_cell_color);
-	} else {
-		data.cells.write[p_cell_index]->color = p_color;
-		data.multimesh->set_instance_custom_data(p_cell_index, p_color);
+	godot::PackedInt32Array packed_cells;
+	godot::PackedFloat32Array packed_costs;
+	godot::PackedInt32Array packed_parents;
+	packed_cells.resize(cells.size());
+	packed_costs.resize(cells.size());
+	packed_parents.resize(cells.size());
+
+	for (uint32_t index = 0; index < cells.size(); index++) {
+		packed_cells.set(index, cells[index]);
+		packed_costs.set(index, costs[index]);
+		packed_parents.set(index, parents[index]);
+
+		data.reachable_parents[cells[index]] = parents[index];
+		data.reachable_cell_indexes.push_back(cells[index]);
 	}
-}
 
-void InteractiveGrid3D::set_obstacles_collision_masks(int p_mask) {
-	data.obstacles_collision_masks = p_mask;
-}
+	data.reachable_cells.clear();
+	data.reachable_cells["cells"] = packed_cells;
+	data.reachable_cells["costs"] = packed_costs;
+	data.reachable_cells["parents"] = packed_parents;
 
-int InteractiveGrid3D::get_obstacles_collision_masks() {
-	return data.obstacles_collision_masks;
-}
+	data.reachable_cache_valid = true;
+	data.reachable_start_cell_index = p_start_cell_index;
+	data.reachable_max_cost = p_max_cost;
 
-void InteractiveGrid3D::set_floor_collision_mask(int p_mask) {
-	data.floor_collision_mask = p_mask;
-}
+	auto end = std::chrono::high_resolution_clock::now();
 
-int InteractiveGrid3D::get_floor_collision_mask() {
-	return data.floor_collision_mask;
+	if (_debug_options.print_execution_time_enabled) {
+		std::chrono::duration<double, std::milli> duration = end - start;
+		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
+	}
+
+	return data.reachable_cells.duplicate();
 }
 
-void InteractiveGrid3D::select_cell(int p_cell_index) {
-	if (is_visible() == false) {
-		return;
-	}
+godot::PackedInt64Array InteractiveGrid3D::get_reachable_path(int p_target_cell_index) const {
+	godot::PackedInt64Array path;
 
-	if (p_cell_index == -1) {
-		return;
-	} else if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_cell_index)) {
-		return;
+	if (!data.reachable_cache_valid) {
+		return path;
 	}
 
-	bool visible = is_cell_visible(p_cell_index);
-	if (!visible) {
-		return;
+	if (p_target_cell_index < 0 || p_target_cell_index >= static_cast<int>(data.reachable_parents.size())) {
+		return path;
 	}
 
-	bool unreachable = !is_cell_reachable(p_cell_index);
-	if (unreachable) {
-		return;
+	if (data.reachable_parents[p_target_cell_index] == -2) {
+		return path; // Outside the cached range.
 	}
 
-	bool accessible = is_cell_accessible(p_cell_index);
-	if (accessible) {
-		_set_cell_selected(p_cell_index, true);
-		data.selected_cells.push_back(p_cell_index);
+	for (int index = p_target_cell_index; index != -1; index = data.reachable_parents[index]) {
+		path.push_back(index);
 	}
-}
-
-godot::Array InteractiveGrid3D::get_selected_cells() {
-	return data.selected_cells;
-}
+	path.reverse();
 
-int InteractiveGrid3D::get_latest_selected() const {
-	return data.selected_cells.back();
+	return path;
 }
 
-godot::PackedInt64Array InteractiveGrid3D::get_path(int p_start_cell_index, int p_target_cell_index) const {
-	godot::PackedInt64Array path;
+godot::Ref<GridFlowField> InteractiveGrid3D::build_flow_field(int p_target_cell_index) {
+	GridTraceScope trace("build_flow_field");
+	trace.add_argument("grid", get_instance_id());
+	trace.add_argument("target", p_target_cell_index);
 
 	if (!(data.flags & GFL_CREATED)) {
 		PrintError(__FILE__, __FUNCTION__, __LINE__, "The grid has not been created");
-		return path;
+		return godot::Ref<GridFlowField>();
+	}
+
+	if (is_cell_index_out_of_bounds(__FILE__, __FUNCTION__, __LINE__, p_target_cell_index)) {
+		return godot::Ref<GridFlowField>();
+	}
+
+	_sync_pathfinder();
+
+	for (const godot::Ref<GridFlowField> &flow_field : data.flow_fields) {
+		if (flow_field->get_target_cell() == p_target_cell_index) {
+			return flow_field;
+		}
 	}
 
 	auto start = std::chrono::high_resolution_clock::now();
 
-	path = data.astar->get_id_path(p_start_cell_index, p_target_cell_index);
+	const int grid_size = get_size();
+
+	godot::PackedFloat32Array distances;
+	godot::PackedInt32Array next_cells;
+	distances.resize(grid_size);
+	next_cells.resize(grid_size);
+	distances.fill(-1.0f);
+	next_cells.fill(-1);
+
+	if (data.pathfinder.is_walkable(p_target_cell_index)) {
+		// Reverse flood from the target: parents are the next step towards it.
+		godot::LocalVector<int> sources;
+		sources.push_back(p_target_cell_index);
+
+		godot::LocalVector<int> cells;
+		godot::LocalVector<float> costs;
+		godot::LocalVector<int> parents;
+		data.pathfinder.flood(sources, std::numeric_limits<float>::infinity(), true, cells, costs, parents);
+
+		float *distances_ptr = distances.ptrw();
+		int32_t *next_cells_ptr = next_cells.ptrw();
+		for (uint32_t index = 0; index < cells.size(); index++) {
+			distances_ptr[cells[index]] = costs[index];
+			next_cells_ptr[cells[index]] = parents[index];
+		}
+	}
+
+	godot::Ref<GridFlowField> flow_field;
+	flow_field.instantiate();
+	flow_field->setup(p_target_cell_index, distances, next_cells);
+
+	if (data.flow_fields.size() >= MAX_CACHED_FLOW_FIELDS) {
+		data.flow_fields.remove_at(0);
+	}
+	data.flow_fields.push_back(flow_field);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
@@ -1710,11 +3887,81 @@ godot::PackedInt64Array InteractiveGrid3D::get_path(int p_start_cell_index, int
 		PrintLine(__FILE__, __FUNCTION__, __LINE__, "Execution time (ms): ", duration.count());
 	}
 
-	return path;
+	return flow_field;
 }
 
 godot::Array InteractiveGrid3D::get_neighbors(int p_cell_index) const {
-	return data.cells[p_cell_index]->neighbors;
+	godot::Array neighbors;
+
+	if (p_cell_index < 0 || p_cell_index >= data.pathfinder.get_size()) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell index out of bounds.");
+		return neighbors;
+	}
+
+	int adjacent_cells[8];
+	const int adjacent_count = data.pathfinder.get_adjacent_cells(p_cell_index, adjacent_cells);
+	for (int adjacent = 0; adjacent < adjacent_count; adjacent++) {
+		neighbors.push_back(adjacent_cells[adjacent]);
+	}
+
+	return neighbors;
+}
+
+godot::Vector2i InteractiveGrid3D::offset_to_axial(const godot::Vector2i &p_offset) const {
+	return godot::Vector2i(hex_offset_to_axial_q(p_offset.x, p_offset.y), p_offset.y);
+}
+
+godot::Vector2i InteractiveGrid3D::axial_to_offset(const godot::Vector2i &p_axial) const {
+	return godot::Vector2i(hex_axial_to_offset_column(p_axial.x, p_axial.y), p_axial.y);
+}
+
+godot::Vector3i InteractiveGrid3D::axial_to_cube(const godot::Vector2i &p_axial) const {
+	return godot::Vector3i(p_axial.x, p_axial.y, -p_axial.x - p_axial.y);
+}
+
+godot::Vector2i InteractiveGrid3D::cube_to_axial(const godot::Vector3i &p_cube) const {
+	return godot::Vector2i(p_cube.x, p_cube.y);
+}
+
+godot::Vector3i InteractiveGrid3D::offset_to_cube(const godot::Vector2i &p_offset) const {
+	return axial_to_cube(offset_to_axial(p_offset));
+}
+
+godot::Vector2i InteractiveGrid3D::cube_to_offset(const godot::Vector3i &p_cube) const {
+	return axial_to_offset(cube_to_axial(p_cube));
+}
+
+godot::Vector3i InteractiveGrid3D::get_cell_cube_coordinates(int p_cell_index) const {
+	if (p_cell_index < 0 || p_cell_index >= data.rows * data.columns) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell index out of bounds: ", p_cell_index);
+		return godot::Vector3i();
+	}
+
+	return offset_to_cube(godot::Vector2i(p_cell_index % data.columns, p_cell_index / data.columns));
+}
+
+int InteractiveGrid3D::get_cell_index_from_cube_coordinates(const godot::Vector3i &p_cube) const {
+	if (p_cube.x + p_cube.y + p_cube.z != 0) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cube coordinates must sum to zero: ", p_cube);
+		return -1;
+	}
+
+	const godot::Vector2i offset = cube_to_offset(p_cube);
+	if (offset.x < 0 || offset.x >= data.columns || offset.y < 0 || offset.y >= data.rows) {
+		return -1;
+	}
+
+	return offset.y * data.columns + offset.x;
+}
+
+int InteractiveGrid3D::hex_distance(int p_cell_index_a, int p_cell_index_b) const {
+	const int cell_count = data.rows * data.columns;
+	if (p_cell_index_a < 0 || p_cell_index_a >= cell_count || p_cell_index_b < 0 || p_cell_index_b >= cell_count) {
+		PrintError(__FILE__, __FUNCTION__, __LINE__, "Cell index out of bounds.");
+		return -1;
+	}
+
+	return hex_offset_distance(p_cell_index_a % data.columns, p_cell_index_a / data.columns, p_cell_index_b % data.columns, p_cell_index_b / data.columns);
 }
 
 void InteractiveGrid3D::set_print_logs_enabled(bool p_enabled) {
@@ -1745,8 +3992,29 @@ bool InteractiveGrid3D::is_cell_index_out_of_bounds(const godot::String &p_file,
 	return is_out_of_bounds;
 }
 
-InteractiveGrid3D::InteractiveGrid3D() {}
+InteractiveGrid3D::InteractiveGrid3D() {
+	data.path_cache.set_capacity(data.path_cache_size);
+	data.chunk_streamer.set_profiler(&data.profiler);
+
+	std::lock_guard<std::mutex> lock(live_grids_mutex);
+	live_grids.push_back(this);
+}
 
 InteractiveGrid3D::~InteractiveGrid3D() {
+	if (data.path_request_task_id != -1) {
+		// The worker task still references the batch and the snapshot.
+		godot::WorkerThreadPool::get_singleton()->wait_for_task_completion(data.path_request_task_id);
+		data.path_request_task_id = -1;
+	}
+
 	_delete();
+
+	std::lock_guard<std::mutex> lock(live_grids_mutex);
+	const int64_t live_index = live_grids.find(this);
+	if (live_index != -1) {
+		live_grids.remove_at_unordered(live_index);
+	}
+	if (live_grids.is_empty()) {
+		live_grids.reset(); // Freed before the library unloads.
+	}
 }
\ No newline at end of file
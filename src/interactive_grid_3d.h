@@ -31,25 +31,51 @@
 
 #include "common.h"
 #include "custom_cell_data.h"
+#include "grid_area.h"
+#include "grid_chunk_store.h"
+#include "grid_chunk_streamer.h"
+#include "grid_cooperative_planner.h"
+#include "grid_field_of_view.h"
+#include "grid_flow_field.h"
+#include "grid_hex.h"
+#include "grid_hierarchy.h"
+#include "grid_layout.h"
+#include "grid_path_cache.h"
+#include "grid_path_request_queue.h"
+#include "grid_pathfinder.h"
+#include "grid_profiler.h"
+#include "grid_tracer.h"
 
-#include <godot_cpp/classes/a_star2d.hpp>
 #include <godot_cpp/classes/box_shape3d.hpp>
 #include <godot_cpp/classes/concave_polygon_shape3d.hpp>
 #include <godot_cpp/classes/convex_polygon_shape3d.hpp>
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/mesh_instance3d.hpp>
 #include <godot_cpp/classes/multi_mesh.hpp>
 #include <godot_cpp/classes/multi_mesh_instance3d.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/performance.hpp>
 #include <godot_cpp/classes/physics_direct_space_state3d.hpp>
 #include <godot_cpp/classes/physics_ray_query_parameters3d.hpp>
 #include <godot_cpp/classes/physics_shape_query_parameters3d.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/shader_material.hpp>
 #include <godot_cpp/classes/static_body3d.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
 #include <godot_cpp/classes/world3d.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/templates/vector.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
 
 class InteractiveGrid3D : public godot::Node3D {
 	GDCLASS(InteractiveGrid3D, Node3D);
@@ -66,6 +92,13 @@ public:
 		MOVEMENT_EIGH_DIRECTIONS
 	};
 
+	enum PathRequestStatus {
+		PATH_REQUEST_UNKNOWN,
+		PATH_REQUEST_PENDING,
+		PATH_REQUEST_RUNNING,
+		PATH_REQUEST_DONE
+	};
+
 	struct DebugOptions {
 		bool print_logs_enabled = false;
 		bool print_execution_time_enabled = false;
@@ -83,7 +116,13 @@ private:
 		uint32_t custom_collision_layer = 0;
 		godot::Color custom_color;
 		bool has_custom_color = false;
-		godot::Array neighbors;
+		godot::Vector3 floor_normal = godot::Vector3(0.0f, 1.0f, 0.0f);
+	};
+
+	enum FloorHit {
+		FLOOR_MISSED,
+		FLOOR_HIT,
+		FLOOR_HIDDEN // Hit a collider hidden in the tree.
 	};
 
 	struct Data {
@@ -93,7 +132,70 @@ private:
 
 		godot::Vector3 center_global_position = godot::Vector3(0.0f, 0.0f, 0.0f);
 
-		godot::Ref<godot::AStar2D> astar;
+		GridPathfinder pathfinder;
+		bool jump_point_search_enabled = false;
+		GridHierarchy hierarchy;
+		GridFieldOfView field_of_view;
+		GridArea area;
+		GridCooperativePlanner cooperative_planner;
+		bool hierarchical_pathfinding_enabled = false;
+		int cluster_size = 16;
+		float max_step_height = 0.0f;
+		float max_slope = 0.0f; // Degrees.
+
+		// Bumped by every accessibility, cost, movement or layout change.
+		uint32_t topology_version = 0;
+		GridPathCache path_cache;
+		int path_cache_size = 128;
+
+		// Asynchronous path requests, searched by a worker task.
+		GridPathRequestQueue path_requests;
+		int path_requests_per_frame = 16;
+		int64_t path_request_task_id = -1;
+
+		// Base movement cost multiplier of each cell, combined with the custom data costs.
+		godot::PackedFloat32Array cell_costs;
+
+		// Cached flood of the latest get_reachable_cells query. Parents are
+		// stored per cell (-2 outside the range) so paths are read back directly.
+		bool reachable_cache_valid = false;
+		int reachable_start_cell_index = -1;
+		float reachable_max_cost = 0.0f;
+		godot::Dictionary reachable_cells;
+		godot::LocalVector<int> reachable_cell_indexes;
+		godot::LocalVector<int> reachable_parents;
+
+		// Flow fields cached by target cell, oldest first.
+		godot::LocalVector<godot::Ref<GridFlowField>> flow_fields;
+
+		// Cells whose accessibility changed since the pathfinder was last updated.
+		godot::LocalVector<int> dirty_cells;
+		godot::LocalVector<uint8_t> dirty_cell_marks;
+
+		// Cells highlighted by set_highlighted_path, and the generation marks
+		// telling which of them are on the latest path.
+		godot::LocalVector<int> highlighted_path_cells;
+		godot::LocalVector<uint32_t> highlighted_path_marks;
+		uint32_t highlighted_path_generation = 0;
+
+		// Streaming: scan results cached by world chunk, so centering the grid
+		// on an area scanned before reads them back instead of querying physics.
+		// Cells are laid out on the world lattice, from the world origin.
+		bool streaming_enabled = false;
+		int chunk_size = 16;
+		int streaming_memory_budget = 64; // MiB.
+		int streaming_chunks_per_update = 4;
+		godot::String streaming_cache_path;
+		bool streaming_cache_file_failed = false;
+		godot::PackedVector3Array streaming_focus_points;
+		GridChunkStreamer chunk_streamer;
+		// World cell of the top-left cell of the grid.
+		int streamed_column = 0;
+		int streamed_row = 0;
+
+		// Timed from const queries as well, such as the hover lookup.
+		mutable GridProfiler profiler;
+		godot::PackedStringArray profile_monitor_ids;
 
 		Layout layout_index = LAYOUT_SQUARE;
 		Movement movement = MOVEMENT_FOUR_DIRECTIONS;
@@ -111,7 +213,8 @@ private:
 
 		godot::Array custom_cell_data;
 
-		godot::Array selected_cells;
+		// Selected cell indexes in selection order, membership is CFL_SELECTED.
+		godot::PackedInt32Array selected_cells;
 		int hovered_cell_index = -1;
 
 		godot::Color accessible_color{ godot::Color(0.5, 0.65, 1.0, 1) }; // BLUE
@@ -130,6 +233,13 @@ private:
 	static constexpr int GFL_CELL_UNREACHABLE_HIDDEN = 1 << 2;
 	static constexpr int GFL_CELL_DISTANT_HIDDEN = 1 << 3;
 	static constexpr int GFL_HOVER_ENABLED = 1 << 4;
+	static constexpr int GFL_PATHFINDER_DIRTY = 1 << 5;
+
+	static constexpr int MAX_CACHED_FLOW_FIELDS = 8;
+	// Chunk records keep custom cell data matches as a 32 bit mask.
+	static constexpr int MAX_STREAMED_CUSTOM_CELL_DATA = 32;
+	static constexpr int MAX_STREAMED_PATH_CELLS = 1 << 22;
+	static constexpr float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
 
 	static constexpr int CFL_ACCESSIBLE = 1 << 0;
 	static constexpr int CFL_REACHABLE = 1 << 1;
@@ -138,26 +248,77 @@ private:
 	static constexpr int CFL_SELECTED = 1 << 4;
 	static constexpr int CFL_PATH = 1 << 5;
 	static constexpr int CFL_VISIBLE = 1 << 6;
+	static constexpr int CFL_OPAQUE = 1 << 7;
 
 	void _create();
 	void _delete();
 
 	void _init_multi_mesh();
-	void _init_astar();
+	void _init_pathfinder();
 
 	void _align_cells_with_floor();
 	void _scan_environnement_obstacles();
 	void _scan_environnement_custom_data();
 
+	FloorHit _intersect_floor(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Vector3 &p_global_position, godot::Vector3 &r_position, godot::Vector3 &r_normal) const;
+	bool _intersects_obstacle(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Transform3D &p_global_xform) const;
+	void _intersect_custom_cell_data(godot::PhysicsDirectSpaceState3D *p_space_state, const godot::Vector3 &p_global_position, godot::LocalVector<int> &r_matches) const;
+	static godot::Basis _get_floor_basis(const godot::Vector3 &p_floor_normal);
+	void _set_cell_floor(int p_cell_index, const godot::Vector3 &p_global_position, const godot::Vector3 &p_floor_normal);
+	void _apply_custom_cell_data(int p_cell_index, const godot::LocalVector<int> &p_matches);
+	static uint32_t _pack_custom_cell_data(const godot::LocalVector<int> &p_matches);
+	static void _unpack_custom_cell_data(uint32_t p_custom_cell_data, godot::LocalVector<int> &r_matches);
+	uint32_t _get_custom_flags(uint32_t p_custom_cell_data) const;
+	void _check_streamed_custom_cell_data_count() const;
+	void _get_custom_flags_cost(uint32_t p_custom_flags, float &r_multiplier, float &r_edge_cost) const;
+
+	uint64_t _get_streaming_signature() const;
+	void _configure_chunk_store();
+	godot::Vector3 _snap_to_world_cells(const godot::Vector3 &p_center_position, int &r_column, int &r_row) const;
+	void _scan_chunk(godot::PhysicsDirectSpaceState3D *p_space_state, int p_chunk_x, int p_chunk_z, float p_reference_height, GridChunkCell *r_cells);
+	const GridChunkCell *_acquire_chunk(int p_chunk_x, int p_chunk_z, float p_reference_height);
+	void _apply_streamed_cells();
+
 	void _layout(godot::Vector3 p_center_position);
 	void _layout_cells_as_square_grid(godot::Vector3 p_center_position);
 	void _layout_cells_as_hexagonal_grid(godot::Vector3 p_center_position);
 
-	void _configure_astar();
-	void _configure_astar_4_dir();
-	void _configure_astar_6_dir();
-	void _configure_astar_8_dir();
-	void _breadth_first_search(int p_start_cell_index);
+	void _breadth_first_search(const godot::LocalVector<int> &p_start_cell_indexes);
+	void _mark_pathfinding_cell_dirty(int p_cell_index);
+	void _invalidate_search_caches();
+
+	static godot::PackedInt32Array _to_packed_cells(const godot::LocalVector<int> &p_cells);
+
+	void _select_cell(int p_cell_index);
+
+	enum ProfileMonitor {
+		PROFILE_MONITOR_LAST_USEC,
+		PROFILE_MONITOR_CALLS,
+		PROFILE_MONITOR_MAX
+	};
+
+	enum MemorySubsystem {
+		MEMORY_CELLS,
+		MEMORY_PATHFINDING,
+		MEMORY_RENDER,
+		MEMORY_CACHES,
+		MEMORY_MAX
+	};
+
+	void _get_memory_usage(uint64_t r_bytes[MEMORY_MAX]) const;
+
+	void _register_profile_monitors();
+	void _unregister_profile_monitors();
+	double _get_profile_monitor(int p_phase, int p_field);
+	void _apply_terrain_limits(GridPathfinder &r_pathfinder) const;
+	void _sync_pathfinder();
+	void _update_pathfinding_graph();
+	bool _is_jump_point_search_usable() const;
+	bool _is_hierarchical_pathfinding_usable(int p_start_cell_index) const;
+	void _update_cell_cost(int p_cell_index);
+	void _process_path_requests();
+	void _run_path_request_batch();
+	void _complete_path_request(int p_request_id, const godot::PackedInt64Array &p_path);
 
 	void _apply_material(const godot::Ref<godot::Material> &p_material);
 
@@ -165,12 +326,19 @@ private:
 	void _set_cell_hovered(int p_cell_index, bool p_is_hovered);
 	void _set_cell_selected(int p_cell_index, bool p_is_selected);
 	void _set_cell_on_path(int p_cell_index, bool p_is_on_path);
+	void _restore_cell_color(int p_cell_index);
+
+	float _get_cell_surface_height(int p_cell_index, float p_x, float p_z) const;
+	int _get_closest_hexagonal_cell(float p_x, float p_z) const;
+	int _pick_cell_from_ray(const godot::Vector3 &p_origin, const godot::Vector3 &p_direction, int &r_visited_cells) const;
 
 protected:
 	static void _bind_methods();
 
 public:
 	virtual void _ready() override;
+	virtual void _enter_tree() override;
+	virtual void _exit_tree() override;
 	virtual void _physics_process(double p_delta) override;
 
 	void set_rows(int p_rows);
@@ -202,6 +370,48 @@ public:
 	void set_movement(Movement p_movement);
 	Movement get_movement() const;
 
+	void set_jump_point_search_enabled(bool p_enabled);
+	bool is_jump_point_search_enabled() const;
+
+	void set_hierarchical_pathfinding_enabled(bool p_enabled);
+	bool is_hierarchical_pathfinding_enabled() const;
+
+	void set_cluster_size(int p_cluster_size);
+	int get_cluster_size() const;
+
+	void set_max_step_height(float p_max_step_height);
+	float get_max_step_height() const;
+
+	void set_max_slope(float p_max_slope);
+	float get_max_slope() const;
+
+	void set_path_cache_size(int p_path_cache_size);
+	int get_path_cache_size() const;
+
+	void set_path_requests_per_frame(int p_path_requests_per_frame);
+	int get_path_requests_per_frame() const;
+
+	void set_streaming_enabled(bool p_enabled);
+	bool is_streaming_enabled() const;
+
+	void set_chunk_size(int p_chunk_size);
+	int get_chunk_size() const;
+
+	void set_streaming_radius(int p_radius);
+	int get_streaming_radius() const;
+
+	void set_streaming_memory_budget(int p_megabytes);
+	int get_streaming_memory_budget() const;
+
+	void set_streaming_chunks_per_update(int p_chunks);
+	int get_streaming_chunks_per_update() const;
+
+	void set_streaming_cache_path(const godot::String &p_path);
+	godot::String get_streaming_cache_path() const;
+
+	void set_streaming_focus_points(const godot::PackedVector3Array &p_points);
+	godot::PackedVector3Array get_streaming_focus_points() const;
+
 	void set_accessible_color(const godot::Color &p_color);
 	godot::Color get_accessible_color() const;
 
@@ -234,9 +444,11 @@ public:
 
 	void highlight_on_hover(godot::Vector3 p_global_position);
 	void highlight_path(const godot::PackedInt64Array &p_path);
+	void set_highlighted_path(const godot::PackedInt64Array &p_path);
 
 	godot::Vector3 get_cell_global_position(int p_cell_index) const;
 	int get_cell_index_from_global_position(godot::Vector3 p_global_position) const;
+	int pick_cell_from_ray(const godot::Vector3 &p_origin, const godot::Vector3 &p_direction) const;
 	godot::Vector3 get_center_global_position() const;
 	godot::Transform3D get_cell_transform(int p_cell_index) const;
 	godot::Transform3D get_cell_global_transform(int p_cell_index) const;
@@ -245,6 +457,13 @@ public:
 	void update_custom_data();
 
 	void compute_unreachable_cells(int p_start_cell_index);
+	void compute_unreachable_cells_from(const godot::PackedInt32Array &p_start_cell_indexes);
+	godot::PackedInt32Array compute_fov(int p_origin_cell_index, int p_radius);
+
+	godot::PackedInt32Array get_cells_in_radius(int p_origin_cell_index, int p_radius);
+	godot::PackedInt32Array get_cells_in_ring(int p_origin_cell_index, int p_radius);
+	godot::PackedInt32Array get_cells_on_line(int p_from_cell_index, int p_to_cell_index);
+	godot::PackedInt32Array get_cells_in_cone(int p_origin_cell_index, const godot::Vector2 &p_direction, float p_angle, int p_radius);
 
 	void hide_distant_cells(int p_start_cell_index, float p_distance);
 	void set_hover_enabled(bool p_enabled);
@@ -260,11 +479,19 @@ public:
 	bool is_cell_selected(int p_cell_index) const;
 	bool is_cell_on_path(int p_cell_index) const;
 	bool is_cell_visible(int p_cell_index) const;
+	bool is_cell_opaque(int p_cell_index) const;
 
 	void set_cell_accessible(int p_cell_index, const bool p_is_accessible);
+	void set_cell_opaque(int p_cell_index, bool p_is_opaque);
 	void set_cell_reachable(int p_cell_index, bool p_is_unreachable);
 	void set_cell_visible(int p_cell_index, const bool p_is_visible);
 
+	void set_cell_costs(const godot::PackedFloat32Array &p_costs);
+	godot::PackedFloat32Array get_cell_costs() const;
+	void set_cell_cost(int p_cell_index, float p_cost);
+	float get_cell_cost(int p_cell_index) const;
+	void reset_cell_costs();
+
 	void reset_cells_state();
 
 	void set_cell_color(int cell_index, const godot::Color &p_color);
@@ -276,11 +503,58 @@ public:
 	int get_floor_collision_mask();
 
 	void select_cell(int p_cell_index);
+	void select_cells(const godot::PackedInt32Array &p_cell_indexes);
+	void select_rect(int p_from_cell_index, int p_to_cell_index);
+	void select_polygon(const godot::PackedVector2Array &p_polygon);
 	godot::Array get_selected_cells();
+	godot::PackedInt32Array get_selected_cell_indexes() const;
 	int get_latest_selected() const;
-	godot::PackedInt64Array get_path(int p_start_cell_index, int p_target_cell_index) const;
+	godot::PackedInt64Array get_path(int p_start_cell_index, int p_target_cell_index);
+	godot::PackedVector3Array get_world_path(int p_start_cell_index, int p_target_cell_index, bool p_smooth = false);
+	godot::Dictionary get_paths(int p_start_cell_index, const godot::PackedInt32Array &p_target_cell_indexes);
+	godot::Dictionary get_cooperative_paths(const godot::PackedInt32Array &p_start_cell_indexes, const godot::PackedInt32Array &p_target_cell_indexes, int p_max_time_steps = 0);
+	int get_topology_version() const;
+	godot::Dictionary get_path_cache_stats() const;
+	void clear_path_cache();
+
+	godot::Dictionary get_profile_stats() const;
+	void reset_profile_stats();
+
+	godot::Dictionary get_memory_usage() const;
+
+	int update_streaming();
+	godot::Dictionary get_streamed_cell(const godot::Vector3 &p_global_position);
+	godot::PackedVector3Array get_streamed_path(const godot::Vector3 &p_from, const godot::Vector3 &p_to);
+	godot::Dictionary get_streaming_stats() const;
+	void clear_streaming_cache();
+
+	// Chrome trace_event export of the operations of every grid, see GridTracer.
+	static void start_trace(int p_capacity);
+	static void stop_trace();
+	static void clear_trace();
+	static bool is_trace_enabled();
+	static godot::String get_trace_json();
+	static bool save_trace(const godot::String &p_path);
+
+	int request_path(int p_start_cell_index, int p_target_cell_index);
+	PathRequestStatus get_path_request_status(int p_request_id) const;
+	godot::PackedInt64Array get_requested_path(int p_request_id);
+	void cancel_path_request(int p_request_id);
+	godot::Dictionary get_reachable_cells(int p_start_cell_index, float p_max_cost);
+	godot::PackedInt64Array get_reachable_path(int p_target_cell_index) const;
+	godot::Ref<GridFlowField> build_flow_field(int p_target_cell_index);
 	godot::Array get_neighbors(int p_cell_index) const;
 
+	godot::Vector2i offset_to_axial(const godot::Vector2i &p_offset) const;
+	godot::Vector2i axial_to_offset(const godot::Vector2i &p_axial) const;
+	godot::Vector3i axial_to_cube(const godot::Vector2i &p_axial) const;
+	godot::Vector2i cube_to_axial(const godot::Vector3i &p_cube) const;
+	godot::Vector3i offset_to_cube(const godot::Vector2i &p_offset) const;
+	godot::Vector2i cube_to_offset(const godot::Vector3i &p_cube) const;
+	godot::Vector3i get_cell_cube_coordinates(int p_cell_index) const;
+	int get_cell_index_from_cube_coordinates(const godot::Vector3i &p_cube) const;
+	int hex_distance(int p_cell_index_a, int p_cell_index_b) const;
+
 	void set_print_logs_enabled(bool p_enabled);
 	bool is_print_logs_enabled() const;
 
@@ -294,4 +568,5 @@ public:
 };
 
 VARIANT_ENUM_CAST(InteractiveGrid3D::Layout);
-VARIANT_ENUM_CAST(InteractiveGrid3D::Movement);
\ No newline at end of file
+VARIANT_ENUM_CAST(InteractiveGrid3D::Movement);
+VARIANT_ENUM_CAST(InteractiveGrid3D::PathRequestStatus);
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <godot_cpp/godot.hpp>
 
 #include "custom_cell_data.h"
+#include "grid_flow_field.h"
 #include "interactive_grid_3d.h"
 
 using namespace godot;
@@ -16,6 +17,7 @@ void initialize_gdextension_types(ModuleInitializationLevel p_level) {
 	}
 	GDREGISTER_CLASS(InteractiveGrid3D);
 	GDREGISTER_CLASS(CustomCellData);
+	GDREGISTER_CLASS(GridFlowField);
 }
 
 void uninitialize_gdextension_types(ModuleInitializationLevel p_level) {
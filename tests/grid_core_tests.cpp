@@ -0,0 +1,543 @@
+/**************************************************************************/
+/*  grid_core_tests.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                     INTERACTIVE GRID GDExtension                       */
+/*         https://github.com/antoinecharruel/interactive_grid            */
+/**************************************************************************/
+/* Copyright (c) 2025 Antoine Charruel.                                   */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+// Native checks of the grid core, built without Godot
+// (cmake -DGRID_CORE_ONLY=ON) and run through ctest. Each check runs on
+// seeded random grids and reports the first mismatches it finds.
+//
+// Usage: grid_core_tests [--seed=1]
+
+#include "grid_area.h"
+#include "grid_cooperative_planner.h"
+#include "grid_field_of_view.h"
+#include "grid_hierarchy.h"
+#include "grid_pathfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(m_condition, ...)                                                    \
+	do {                                                                           \
+		if (!(m_condition)) {                                                      \
+			failures++;                                                            \
+			std::fprintf(stderr, "%s:%d: %s: ", __FILE__, __LINE__, #m_condition); \
+			std::fprintf(stderr, __VA_ARGS__);                                     \
+			std::fprintf(stderr, "\n");                                            \
+		}                                                                          \
+	} while (0)
+
+// Cost of p_path under the pathfinder costs, or -1 if it leaves the walkable
+// cells or takes a step that is not a neighbor.
+float path_cost(const GridPathfinder &p_pathfinder, const GridVector<int> &p_path) {
+	float cost = 0.0f;
+	int neighbors[8];
+
+	for (uint32_t index = 1; index < p_path.size(); index++) {
+		const int from = p_path[index - 1];
+		const int to = p_path[index];
+		if (!p_pathfinder.is_walkable(to)) {
+			return -1.0f;
+		}
+
+		const int count = p_pathfinder.get_neighbors(from, neighbors);
+		bool adjacent = false;
+		for (int n = 0; n < count; n++) {
+			adjacent = adjacent || neighbors[n] == to;
+		}
+		if (!adjacent) {
+			return -1.0f;
+		}
+
+		cost += p_pathfinder.get_step_cost(from, to);
+	}
+
+	return cost;
+}
+
+void randomize_walkable(GridPathfinder &r_pathfinder, std::mt19937 &r_random, float p_density) {
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	for (int index = 0; index < r_pathfinder.get_size(); index++) {
+		r_pathfinder.set_walkable(index, unit(r_random) >= p_density);
+	}
+}
+
+// JPS+ keeps its jump distances up to date through incremental
+// set_walkable calls and must find paths as short as plain A*.
+void test_jps_matches_astar_after_edits(unsigned int p_seed) {
+	const GridPathfinder::Movement movements[] = { GridPathfinder::MOVEMENT_FOUR_DIRECTIONS, GridPathfinder::MOVEMENT_EIGH_DIRECTIONS };
+
+	for (const GridPathfinder::Movement movement : movements) {
+		std::mt19937 random(p_seed);
+		GridPathfinder pathfinder;
+		pathfinder.resize(40, 32);
+		pathfinder.set_movement(movement);
+		randomize_walkable(pathfinder, random, 0.25f);
+		pathfinder.update_cost_bounds();
+		pathfinder.update_jump_distances();
+
+		std::uniform_int_distribution<int> cell(0, pathfinder.get_size() - 1);
+		GridVector<int> astar_path;
+		GridVector<int> jps_path;
+
+		for (int round = 0; round < 40; round++) {
+			// A few toggles per round, so only some lines go stale.
+			for (int edit = 0; edit < 6; edit++) {
+				const int index = cell(random);
+				pathfinder.set_walkable(index, !pathfinder.is_walkable(index));
+			}
+
+			for (int query = 0; query < 20; query++) {
+				const int from = cell(random);
+				const int to = cell(random);
+				if (!pathfinder.is_walkable(from)) {
+					continue;
+				}
+
+				const bool astar_found = pathfinder.find_path(from, to, astar_path);
+				const bool jps_found = pathfinder.find_path_jps(from, to, jps_path);
+				CHECK(astar_found == jps_found, "movement %d, %d -> %d", movement, from, to);
+				if (!astar_found || !jps_found) {
+					continue;
+				}
+
+				const float astar_cost = path_cost(pathfinder, astar_path);
+				const float jps_cost = path_cost(pathfinder, jps_path);
+				CHECK(jps_cost >= 0.0f, "movement %d, %d -> %d: invalid JPS path", movement, from, to);
+				CHECK(std::fabs(astar_cost - jps_cost) < 1e-3f, "movement %d, %d -> %d: A* %f, JPS %f", movement, from, to, astar_cost, jps_cost);
+			}
+		}
+	}
+}
+
+// HPA* paths must be walkable, connected, and exist whenever A* finds one.
+void test_hierarchy_paths_are_valid(unsigned int p_seed) {
+	const GridPathfinder::Movement movements[] = { GridPathfinder::MOVEMENT_FOUR_DIRECTIONS, GridPathfinder::MOVEMENT_SIX_DIRECTIONS,
+		GridPathfinder::MOVEMENT_EIGH_DIRECTIONS };
+
+	for (const GridPathfinder::Movement movement : movements) {
+		std::mt19937 random(p_seed);
+		GridPathfinder pathfinder;
+		pathfinder.resize(45, 37);
+		pathfinder.set_movement(movement);
+		randomize_walkable(pathfinder, random, 0.2f);
+		pathfinder.update_cost_bounds();
+
+		GridHierarchy hierarchy;
+		hierarchy.setup(&pathfinder, 8);
+		hierarchy.update();
+
+		std::uniform_int_distribution<int> cell(0, pathfinder.get_size() - 1);
+		GridVector<int> astar_path;
+		GridVector<int> hpa_path;
+
+		for (int round = 0; round < 10; round++) {
+			for (int edit = 0; edit < 6; edit++) {
+				const int index = cell(random);
+				pathfinder.set_walkable(index, !pathfinder.is_walkable(index));
+				hierarchy.mark_cell_dirty(index);
+			}
+			hierarchy.update();
+
+			for (int query = 0; query < 30; query++) {
+				const int from = cell(random);
+				const int to = cell(random);
+				if (!pathfinder.is_walkable(from)) {
+					continue;
+				}
+
+				const bool astar_found = pathfinder.find_path(from, to, astar_path);
+				const bool hpa_found = hierarchy.find_path(from, to, hpa_path);
+				CHECK(astar_found == hpa_found, "movement %d, %d -> %d", movement, from, to);
+				if (!hpa_found) {
+					continue;
+				}
+
+				CHECK(!hpa_path.is_empty() && hpa_path[0] == from && hpa_path[hpa_path.size() - 1] == to, "movement %d, %d -> %d: wrong ends", movement, from, to);
+				CHECK(path_cost(pathfinder, hpa_path) >= 0.0f, "movement %d, %d -> %d: invalid HPA* path", movement, from, to);
+			}
+		}
+	}
+}
+
+// Cell of an agent at p_time: planned agents rest on their target once
+// their path ends, unplanned ones stay on their start.
+int agent_cell(const GridVector<int> &p_paths, const GridVector<int> &p_offsets, int p_start, int p_agent, int p_time) {
+	const int begin = p_offsets[p_agent];
+	const int end = p_offsets[p_agent + 1];
+	if (begin == end) {
+		return p_start;
+	}
+	return p_paths[begin + std::min(p_time, end - begin - 1)];
+}
+
+// The breadth-first search reaches exactly the cells a Dijkstra flood
+// settles, from several sources and on grids of any obstacle density.
+void test_breadth_first_search_matches_flood(unsigned int p_seed) {
+	const GridPathfinder::Movement movements[] = { GridPathfinder::MOVEMENT_FOUR_DIRECTIONS, GridPathfinder::MOVEMENT_SIX_DIRECTIONS,
+		GridPathfinder::MOVEMENT_EIGH_DIRECTIONS };
+	const float densities[] = { 0.0f, 0.3f, 0.45f, 0.6f };
+
+	std::mt19937 random(p_seed);
+	std::uniform_int_distribution<int> side(1, 33);
+
+	GridVector<int> cells;
+	GridVector<float> costs;
+	GridVector<int> parents;
+
+	for (const GridPathfinder::Movement movement : movements) {
+		for (const float density : densities) {
+			for (int round = 0; round < 20; round++) {
+				GridPathfinder pathfinder;
+				pathfinder.resize(side(random), side(random));
+				pathfinder.set_movement(movement);
+				randomize_walkable(pathfinder, random, density);
+				pathfinder.update_cost_bounds();
+
+				std::uniform_int_distribution<int> cell(0, pathfinder.get_size() - 1);
+				GridVector<int> sources;
+				for (int source = 0; source < 3; source++) {
+					const int index = cell(random);
+					if (pathfinder.is_walkable(index)) {
+						sources.push_back(index);
+					}
+				}
+
+				pathfinder.breadth_first_search(sources);
+				pathfinder.flood(sources, std::numeric_limits<float>::infinity(), false, cells, costs, parents);
+
+				std::vector<bool> flooded(pathfinder.get_size(), false);
+				for (const int &index : cells) {
+					flooded[index] = true;
+				}
+				for (int index = 0; index < pathfinder.get_size(); index++) {
+					CHECK(pathfinder.is_reached(index) == flooded[index], "movement %d, %dx%d: cell %d", movement,
+							pathfinder.get_columns(), pathfinder.get_rows(), index);
+				}
+			}
+		}
+	}
+}
+
+// Hexagonal lines are gap-free, also along the jagged edges of odd-r grids
+// where the usual tie-break rounds off the grid (23x19: 91 -> 45, 91 -> 275).
+void test_hexagonal_lines_are_contiguous() {
+	const int sizes[][2] = { { 23, 19 }, { 8, 7 }, { 9, 6 } };
+
+	GridVector<int> cells;
+	for (const auto &size : sizes) {
+		GridArea area;
+		area.resize(size[0], size[1]);
+		area.set_hexagonal(true);
+
+		const int cell_count = size[0] * size[1];
+		for (int from = 0; from < cell_count; from++) {
+			for (int to = 0; to < cell_count; to++) {
+				area.cells_on_line(from, to, cells);
+
+				const int distance = area.distance(from, to);
+				CHECK(static_cast<int>(cells.size()) == distance + 1, "%dx%d, %d -> %d: %d cells for a distance of %d",
+						size[0], size[1], from, to, static_cast<int>(cells.size()), distance);
+				for (uint32_t index = 1; index < cells.size(); index++) {
+					CHECK(area.distance(cells[index - 1], cells[index]) == 1, "%dx%d, %d -> %d: gap after cell %d",
+							size[0], size[1], from, to, cells[index - 1]);
+				}
+			}
+		}
+	}
+}
+
+// Cooperative paths never share a cell or swap two cells, including with
+// agents that got no path and stay on their start.
+void test_cooperative_paths_are_conflict_free(unsigned int p_seed) {
+	std::mt19937 random(p_seed);
+	std::uniform_int_distribution<int> side(3, 7);
+	std::uniform_int_distribution<int> agents(2, 7);
+	std::uniform_int_distribution<int> movement(0, 2);
+
+	GridCooperativePlanner planner;
+	GridVector<int> paths;
+	GridVector<int> offsets;
+
+	for (int round = 0; round < 2000; round++) {
+		GridPathfinder pathfinder;
+		pathfinder.resize(side(random), side(random));
+		pathfinder.set_movement(static_cast<GridPathfinder::Movement>(movement(random)));
+		randomize_walkable(pathfinder, random, 0.2f);
+		pathfinder.update_cost_bounds();
+
+		std::vector<int> open_cells;
+		for (int index = 0; index < pathfinder.get_size(); index++) {
+			if (pathfinder.is_walkable(index)) {
+				open_cells.push_back(index);
+			}
+		}
+
+		const int agent_count = std::min<int>(agents(random), open_cells.size() / 2);
+		if (agent_count < 2) {
+			continue;
+		}
+
+		// Distinct starts and distinct targets.
+		std::shuffle(open_cells.begin(), open_cells.end(), random);
+		GridVector<int> starts;
+		for (int agent = 0; agent < agent_count; agent++) {
+			starts.push_back(open_cells[agent]);
+		}
+		std::shuffle(open_cells.begin(), open_cells.end(), random);
+		GridVector<int> targets;
+		for (int agent = 0; agent < agent_count; agent++) {
+			targets.push_back(open_cells[agent]);
+		}
+
+		const int max_time = pathfinder.get_size() * 2;
+		planner.plan(&pathfinder, starts, targets, max_time, paths, offsets);
+
+		for (int time = 0; time <= max_time + 1; time++) {
+			for (int a = 0; a < agent_count; a++) {
+				for (int b = a + 1; b < agent_count; b++) {
+					const int cell_a = agent_cell(paths, offsets, starts[a], a, time);
+					const int cell_b = agent_cell(paths, offsets, starts[b], b, time);
+					CHECK(cell_a != cell_b, "round %d, agents %d and %d share cell %d at time %d", round, a, b, cell_a, time);
+
+					if (time > 0) {
+						const bool swap = cell_a != cell_b && cell_a == agent_cell(paths, offsets, starts[b], b, time - 1) &&
+								cell_b == agent_cell(paths, offsets, starts[a], a, time - 1);
+						CHECK(!swap, "round %d, agents %d and %d swap cells at time %d", round, a, b, time);
+					}
+				}
+			}
+		}
+	}
+}
+
+// A straight line that only crosses walkable cells is also a line of sight,
+// both ways, on sparse grids where obstacles are opaque. The converse does
+// not hold: light grazes past corners a walk cannot cut. On open grids the
+// field of view covers the whole radius, which is symmetric.
+void test_field_of_view_matches_line_of_sight(unsigned int p_seed) {
+	const float densities[] = { 0.0f, 0.05f, 0.15f };
+	const int columns = 21;
+	const int rows = 17;
+	const int radius = 7;
+	const int size = columns * rows;
+
+	GridVector<int> cells;
+
+	for (int hexagonal = 0; hexagonal < 2; hexagonal++) {
+		for (const float density : densities) {
+			std::mt19937 random(p_seed);
+			GridPathfinder pathfinder;
+			pathfinder.resize(columns, rows);
+			pathfinder.set_movement(hexagonal ? GridPathfinder::MOVEMENT_SIX_DIRECTIONS : GridPathfinder::MOVEMENT_EIGH_DIRECTIONS);
+			randomize_walkable(pathfinder, random, density);
+
+			GridFieldOfView field_of_view;
+			field_of_view.resize(columns, rows);
+			field_of_view.set_hexagonal(hexagonal);
+
+			GridArea area;
+			area.resize(columns, rows);
+			area.set_hexagonal(hexagonal);
+
+			for (int index = 0; index < size; index++) {
+				field_of_view.set_opaque(index, !pathfinder.is_walkable(index));
+			}
+
+			std::vector<bool> visible(size * size, false);
+			for (int from = 0; from < size; from++) {
+				field_of_view.compute(from, radius, cells);
+				for (const int &index : cells) {
+					visible[from * size + index] = true;
+				}
+			}
+
+			for (int from = 0; from < size; from++) {
+				for (int to = 0; to < size; to++) {
+					const int dx = to % columns - from % columns;
+					const int dy = to / columns - from / columns;
+					const bool in_range = hexagonal ? area.distance(from, to) <= radius : dx * dx + dy * dy <= radius * radius;
+					if (!in_range || !pathfinder.is_walkable(from) || !pathfinder.is_walkable(to)) {
+						continue;
+					}
+
+					const bool seen = visible[from * size + to];
+					if (density == 0.0f) {
+						CHECK(seen, "hexagonal %d: %d -> %d out of sight on an open grid", hexagonal, from, to);
+						CHECK(seen == visible[to * size + from], "hexagonal %d: %d -> %d not symmetric", hexagonal, from, to);
+					}
+					if (pathfinder.is_line_walkable(from, to)) {
+						CHECK(seen, "hexagonal %d, density %.2f: %d -> %d walkable but out of sight", hexagonal, density, from, to);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Rings and cones stay inside the radius, and the rings up to a radius
+// cover it exactly, on both layouts and with or without diagonal steps.
+void test_area_shapes_are_inside_radius(unsigned int p_seed) {
+	std::mt19937 random(p_seed);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> aperture(0.1f, 3.1f);
+
+	GridVector<int> radius_cells;
+	GridVector<int> ring_cells;
+	GridVector<int> cone_cells;
+
+	for (int hexagonal = 0; hexagonal < 2; hexagonal++) {
+		for (int diagonal = 0; diagonal < 2; diagonal++) {
+			GridArea area;
+			area.resize(13, 11);
+			area.set_hexagonal(hexagonal);
+			area.set_diagonal(diagonal);
+
+			for (int origin = 0; origin < 13 * 11; origin++) {
+				for (int radius = 0; radius <= 9; radius++) {
+					area.cells_in_radius(origin, radius, radius_cells);
+					std::vector<bool> in_radius(13 * 11, false);
+					for (const int &index : radius_cells) {
+						in_radius[index] = true;
+					}
+
+					int ring_cell_count = 0;
+					for (int ring = 0; ring <= radius; ring++) {
+						area.cells_in_ring(origin, ring, ring_cells);
+						ring_cell_count += ring_cells.size();
+						for (const int &index : ring_cells) {
+							CHECK(in_radius[index], "hexagonal %d, diagonal %d: ring %d of %d leaves the radius at %d", hexagonal, diagonal, ring, origin, index);
+							CHECK(area.distance(origin, index) == ring, "hexagonal %d, diagonal %d: cell %d is not on ring %d of %d", hexagonal, diagonal, index, ring, origin);
+						}
+					}
+					CHECK(ring_cell_count == static_cast<int>(radius_cells.size()), "hexagonal %d, diagonal %d: rings of %d up to %d cover %d of %d cells",
+							hexagonal, diagonal, origin, radius, ring_cell_count, static_cast<int>(radius_cells.size()));
+
+					area.cells_in_cone(origin, direction(random), direction(random), aperture(random), radius, cone_cells);
+					for (const int &index : cone_cells) {
+						CHECK(in_radius[index] && index != origin, "hexagonal %d, diagonal %d: cone of %d, radius %d, holds %d", hexagonal, diagonal, origin, radius, index);
+					}
+				}
+			}
+		}
+	}
+}
+
+// A reverse flood is a flow field: following the parents from any cell
+// strictly lowers the cost to the sources, by the cost of the step taken.
+void test_reverse_flood_parents_lower_cost(unsigned int p_seed) {
+	const GridPathfinder::Movement movements[] = { GridPathfinder::MOVEMENT_FOUR_DIRECTIONS, GridPathfinder::MOVEMENT_SIX_DIRECTIONS,
+		GridPathfinder::MOVEMENT_EIGH_DIRECTIONS };
+
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	GridVector<int> cells;
+	GridVector<float> costs;
+	GridVector<int> parents;
+
+	for (const GridPathfinder::Movement movement : movements) {
+		std::mt19937 random(p_seed);
+		GridPathfinder pathfinder;
+		pathfinder.resize(30, 25);
+		pathfinder.set_movement(movement);
+		randomize_walkable(pathfinder, random, 0.25f);
+		for (int index = 0; index < pathfinder.get_size(); index++) {
+			pathfinder.set_cell_cost(index, 0.5f + 3.0f * unit(random), unit(random) < 0.2f ? unit(random) : 0.0f);
+		}
+		pathfinder.update_cost_bounds();
+
+		std::uniform_int_distribution<int> cell(0, pathfinder.get_size() - 1);
+
+		for (int round = 0; round < 10; round++) {
+			GridVector<int> sources;
+			sources.push_back(cell(random));
+			sources.push_back(cell(random));
+
+			pathfinder.flood(sources, std::numeric_limits<float>::infinity(), true, cells, costs, parents);
+
+			std::vector<float> cell_costs(pathfinder.get_size(), -1.0f);
+			for (uint32_t index = 0; index < cells.size(); index++) {
+				cell_costs[cells[index]] = costs[index];
+			}
+
+			for (uint32_t index = 0; index < cells.size(); index++) {
+				const int parent = parents[index];
+				if (parent == -1) {
+					CHECK(costs[index] == 0.0f, "movement %d: cell %d has no next step", movement, cells[index]);
+					continue;
+				}
+
+				CHECK(cell_costs[parent] >= 0.0f && cell_costs[parent] < costs[index], "movement %d: %d -> %d does not lower the cost (%f -> %f)",
+						movement, cells[index], parent, costs[index], cell_costs[parent]);
+				CHECK(std::fabs(cell_costs[parent] + pathfinder.get_step_cost(cells[index], parent) - costs[index]) < 1e-3f,
+						"movement %d: %d -> %d does not match the step cost", movement, cells[index], parent);
+			}
+		}
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	unsigned int seed = 1;
+	for (int i = 1; i < argc; i++) {
+		if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+			seed = static_cast<unsigned int>(std::strtoul(argv[i] + 7, nullptr, 10));
+		} else {
+			std::fprintf(stderr, "Usage: %s [--seed=1]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	test_jps_matches_astar_after_edits(seed);
+	test_hierarchy_paths_are_valid(seed);
+	test_breadth_first_search_matches_flood(seed);
+	test_hexagonal_lines_are_contiguous();
+	test_cooperative_paths_are_conflict_free(seed);
+	test_field_of_view_matches_line_of_sight(seed);
+	test_area_shapes_are_inside_radius(seed);
+	test_reverse_flood_parents_lower_cost(seed);
+
+	if (failures > 0) {
+		std::fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+
+	std::printf("All grid core checks passed\n");
+	return 0;
+}